@@ -5,6 +5,24 @@ _ :: intrinsics;
 
 INITIAL_MAP_CAP :: 16;
 
+/*
+	`Raw_Map.hashes` is an open addressed table of slots, its length is always a power of two.
+	A slot is either `MAP_SLOT_EMPTY` or the index of its entry in `Raw_Map.entries`, with the top
+	bits of the entry's hash (its tag) stored above the index. Comparing the tags skips nearly every
+	mismatching slot without touching the entries.
+
+	The slots are probed linearly a group at a time, starting from the group the hash falls within.
+	A whole group is compared at once, which the backend can vectorize.
+	Deletion shifts the following slots back, so a probe can always stop at the first empty slot.
+*/
+MAP_SLOT_EMPTY      :: -1;
+MAP_GROUP_SIZE      :: 8;
+MAP_SLOT_INDEX_BITS :: 32 when size_of(int) == 8 else 31;
+MAP_SLOT_INDEX_MASK :: 1<<MAP_SLOT_INDEX_BITS - 1;
+MAP_SLOT_TAG_BITS   :: 8*size_of(int) - 1 - MAP_SLOT_INDEX_BITS;
+
+#assert(MAP_GROUP_SIZE <= INITIAL_MAP_CAP);
+
 // Temporary data structure for comparing hashes and keys
 Map_Hash :: struct {
 	hash:    uintptr,
@@ -27,20 +45,27 @@ __get_map_hash_from_entry :: proc "contextless" (h: Map_Header, entry: ^Map_Entr
 
 
 Map_Find_Result :: struct {
-	hash_index:  int,
-	entry_prev:  int,
+	hash_index:  int, // the slot of the entry, or the empty slot at which an entry for the hash would be inserted
 	entry_index: int,
 }
 
 Map_Entry_Header :: struct {
 	hash: uintptr,
-	next: int,
+	next: int, // NOTE: Unused since the map is open addressed, kept as the layout of the entries is relied upon
 /*
 	key:   Key_Value,
 	value: Value_Type,
 */
 }
 
+// How the keys are compared once their hashes match, the compiler picks this for each key type
+// so that the common keys are compared inline rather than with an indirect call to `Map_Header.equal`
+Map_Key_Compare :: enum uintptr {
+	Proc   = 0, // call `equal`
+	Bytes  = 1, // the keys are equal when their bytes are equal
+	String = 2, // the keys are strings
+}
+
 Map_Header :: struct {
 	m:             ^Raw_Map,
 	equal:         Equal_Proc,
@@ -53,6 +78,8 @@ Map_Header :: struct {
 
 	value_offset:  uintptr,
 	value_size:    int,
+
+	key_compare:   Map_Key_Compare,
 }
 
 INITIAL_HASH_SEED :: 0xcbf29ce484222325;
@@ -182,66 +209,70 @@ __slice_resize :: proc(array_: ^$T/[]$E, new_count: int, allocator: Allocator, l
 	return true;
 }
 
-__dynamic_map_reserve :: proc(using header: Map_Header, cap: int, loc := #caller_location) {
-	__dynamic_array_reserve(&m.entries, entry_size, entry_align, cap, loc);
+__dynamic_map_slot_make :: #force_inline proc "contextless" (entry_index: int, hash: uintptr) -> int {
+	return entry_index | __dynamic_map_slot_tag(hash);
+}
 
-	old_len := len(m.hashes);
-	__slice_resize(&m.hashes, cap, m.entries.allocator, loc);
-	for i in old_len..<len(m.hashes) {
-		m.hashes[i] = -1;
+__dynamic_map_slot_tag :: #force_inline proc "contextless" (hash: uintptr) -> int {
+	when MAP_SLOT_TAG_BITS > 0 {
+		return int(u64(hash) >> (8*size_of(uintptr) - MAP_SLOT_TAG_BITS)) << MAP_SLOT_INDEX_BITS;
+	} else {
+		return 0;
 	}
+}
 
+// The start of the group in which the probe for the hash begins
+__dynamic_map_slot_home :: #force_inline proc "contextless" (hash: uintptr, mask: int) -> int {
+	return int(hash) & mask &~ (MAP_GROUP_SIZE-1);
 }
-__dynamic_map_rehash :: proc(using header: Map_Header, new_count: int, loc := #caller_location) #no_bounds_check {
-	new_header: Map_Header = header;
-	nm := Raw_Map{};
-	nm.entries.allocator = m.entries.allocator;
-	nm.hashes = m.hashes;
-	new_header.m = &nm;
-
-	c := context;
-	if m.entries.allocator.procedure != nil {
-		c.allocator = m.entries.allocator;
+
+// The number of slots needed for `cap` entries without the map being full
+__dynamic_map_slot_count :: proc "contextless" (cap: int) -> int {
+	n := INITIAL_MAP_CAP;
+	for 3*n <= 4*cap {
+		n <<= 1;
 	}
-	context = c;
+	return n;
+}
 
-	new_count := new_count;
-	new_count = max(new_count, 2*m.entries.len);
+__dynamic_map_reserve :: proc(using header: Map_Header, cap: int, loc := #caller_location) {
+	__dynamic_array_reserve(&m.entries, entry_size, entry_align, cap, loc);
 
-	__dynamic_array_reserve(&nm.entries, entry_size, entry_align, m.entries.len, loc);
-	__slice_resize(&nm.hashes, new_count, m.entries.allocator, loc);
-	for i in 0 ..< new_count {
-		nm.hashes[i] = -1;
+	if slot_count := __dynamic_map_slot_count(cap); slot_count > len(m.hashes) {
+		__dynamic_map_rehash(header, slot_count, loc);
 	}
+}
 
-	for i in 0 ..< m.entries.len {
-		if len(nm.hashes) == 0 {
-			__dynamic_map_grow(new_header, loc);
+// NOTE: Only the slots are rebuilt, the entries stay where they are
+__dynamic_map_rehash :: proc(using header: Map_Header, new_count: int, loc := #caller_location) #no_bounds_check {
+	slot_count := max(new_count, __dynamic_map_slot_count(m.entries.len));
+	if n := INITIAL_MAP_CAP; n < slot_count {
+		for n < slot_count {
+			n <<= 1;
 		}
+		slot_count = n;
+	}
 
-		entry_header := __dynamic_map_get_entry(header, i);
-		entry_hash := __get_map_hash_from_entry(header, entry_header);
-
-		fr := __dynamic_map_find(new_header, entry_hash);
-		j := __dynamic_map_add_entry(new_header, entry_hash, loc);
-		if fr.entry_prev < 0 {
-			nm.hashes[fr.hash_index] = j;
-		} else {
-			e := __dynamic_map_get_entry(new_header, fr.entry_prev);
-			e.next = j;
-		}
+	if m.entries.allocator.procedure == nil {
+		m.entries.allocator = context.allocator;
+	}
+	if !__slice_resize(&m.hashes, slot_count, m.entries.allocator, loc) {
+		return;
+	}
 
-		e := __dynamic_map_get_entry(new_header, j);
-		__dynamic_map_copy_entry(header, e, entry_header);
-		e.next = fr.entry_index;
+	for _, i in m.hashes {
+		m.hashes[i] = MAP_SLOT_EMPTY;
+	}
 
-		if __dynamic_map_full(new_header) {
-			__dynamic_map_grow(new_header, loc);
+	mask := len(m.hashes)-1;
+	for i in 0..<m.entries.len {
+		entry := __dynamic_map_get_entry(header, i);
+		pos := __dynamic_map_slot_home(entry.hash, mask);
+		for m.hashes[pos] != MAP_SLOT_EMPTY {
+			pos = (pos+1) & mask;
 		}
+		m.hashes[pos] = __dynamic_map_slot_make(i, entry.hash);
 	}
-
-	free(m.entries.data, m.entries.allocator, loc);
-	header.m^ = nm;
 }
 
 __dynamic_map_get :: proc(h: Map_Header, hash: Map_Hash) -> rawptr {
@@ -259,7 +290,6 @@ __dynamic_map_set :: proc(h: Map_Header, hash: Map_Hash, value: rawptr, loc := #
 
 	if len(h.m.hashes) == 0 {
 		__dynamic_map_reserve(h, INITIAL_MAP_CAP, loc);
-		__dynamic_map_grow(h, loc);
 	}
 
 	fr := __dynamic_map_find(h, hash);
@@ -267,12 +297,7 @@ __dynamic_map_set :: proc(h: Map_Header, hash: Map_Hash, value: rawptr, loc := #
 		index = fr.entry_index;
 	} else {
 		index = __dynamic_map_add_entry(h, hash, loc);
-		if fr.entry_prev >= 0 {
-			entry := __dynamic_map_get_entry(h, fr.entry_prev);
-			entry.next = index;
-		} else {
-			h.m.hashes[fr.hash_index] = index;
-		}
+		h.m.hashes[fr.hash_index] = __dynamic_map_slot_make(index, hash.hash);
 	}
 
 	e := __dynamic_map_get_entry(h, index);
@@ -291,39 +316,88 @@ __dynamic_map_set :: proc(h: Map_Header, hash: Map_Hash, value: rawptr, loc := #
 
 
 __dynamic_map_grow :: proc(using h: Map_Header, loc := #caller_location) {
-	// TODO(bill): Determine an efficient growing rate
-	new_count := max(4*m.entries.cap + 7, INITIAL_MAP_CAP);
-	__dynamic_map_rehash(h, new_count, loc);
+	__dynamic_map_rehash(h, 2*len(m.hashes), loc);
 }
 
 __dynamic_map_full :: #force_inline proc "contextless" (using h: Map_Header) -> bool {
-	return int(0.75 * f64(len(m.hashes))) <= m.entries.cap;
+	return 4*m.entries.len >= 3*len(m.hashes);
 }
 
 
-__dynamic_map_hash_equal :: proc "contextless" (h: Map_Header, a, b: Map_Hash) -> bool {
-	if a.hash == b.hash {
+__dynamic_map_hash_equal :: #force_inline proc "contextless" (h: Map_Header, a, b: Map_Hash) -> bool {
+	if a.hash != b.hash {
+		return false;
+	}
+	switch h.key_compare {
+	case .Proc:
 		return h.equal(a.key_ptr, b.key_ptr);
+	case .Bytes:
+		switch h.key_size {
+		case 1: return (^u8)(a.key_ptr)^  == (^u8)(b.key_ptr)^;
+		case 2: return (^u16)(a.key_ptr)^ == (^u16)(b.key_ptr)^;
+		case 4: return (^u32)(a.key_ptr)^ == (^u32)(b.key_ptr)^;
+		case 8: return (^u64)(a.key_ptr)^ == (^u64)(b.key_ptr)^;
+		}
+		return memory_equal(a.key_ptr, b.key_ptr, h.key_size);
+	case .String:
+		return (^string)(a.key_ptr)^ == (^string)(b.key_ptr)^;
 	}
 	return false;
 }
 
 __dynamic_map_find :: proc(using h: Map_Header, hash: Map_Hash) -> Map_Find_Result #no_bounds_check {
-	fr := Map_Find_Result{-1, -1, -1};
-	if n := uintptr(len(m.hashes)); n > 0 {
-		fr.hash_index = int(hash.hash % n);
-		fr.entry_index = m.hashes[fr.hash_index];
-		for fr.entry_index >= 0 {
-			entry := __dynamic_map_get_entry(h, fr.entry_index);
-			entry_hash := __get_map_hash_from_entry(h, entry);
-			if __dynamic_map_hash_equal(h, entry_hash, hash) {
+	fr := Map_Find_Result{-1, -1};
+	n := len(m.hashes);
+	if n == 0 {
+		return fr;
+	}
+
+	mask := n-1;
+	tag := __dynamic_map_slot_tag(hash.hash);
+	pos := __dynamic_map_slot_home(hash.hash, mask);
+	for {
+		group := ([^]int)(&m.hashes[pos]);
+
+		matches, empties: u32;
+		#unroll for i in 0..<MAP_GROUP_SIZE {
+			slot := group[i];
+			matches |= u32(slot &~ MAP_SLOT_INDEX_MASK == tag) << u32(i);
+			empties |= u32(slot == MAP_SLOT_EMPTY)             << u32(i);
+		}
+		if empties != 0 {
+			// Only the slots before the first empty one are within the probe
+			matches &= (empties & -empties) - 1;
+		}
+
+		for matches != 0 {
+			i := int(intrinsics.count_trailing_zeros(matches));
+			matches &= matches-1;
+
+			entry_index := group[i] & MAP_SLOT_INDEX_MASK;
+			entry := __dynamic_map_get_entry(h, entry_index);
+			if __dynamic_map_hash_equal(h, __get_map_hash_from_entry(h, entry), hash) {
+				fr.hash_index = pos+i;
+				fr.entry_index = entry_index;
 				return fr;
 			}
-			fr.entry_prev = fr.entry_index;
-			fr.entry_index = entry.next;
 		}
+
+		if empties != 0 {
+			fr.hash_index = pos+int(intrinsics.count_trailing_zeros(empties));
+			return fr;
+		}
+		pos = (pos+MAP_GROUP_SIZE) & mask;
+	}
+}
+
+// The slot which refers to the entry at `entry_index`
+__dynamic_map_find_slot :: proc "contextless" (using h: Map_Header, entry_hash: uintptr, entry_index: int) -> int #no_bounds_check {
+	mask := len(m.hashes)-1;
+	pos := __dynamic_map_slot_home(entry_hash, mask);
+	for m.hashes[pos] & MAP_SLOT_INDEX_MASK != entry_index {
+		pos = (pos+1) & mask;
 	}
-	return fr;
+	return pos;
 }
 
 __dynamic_map_add_entry :: proc(using h: Map_Header, hash: Map_Hash, loc := #caller_location) -> int {
@@ -355,28 +429,31 @@ __dynamic_map_copy_entry :: proc "contextless" (h: Map_Header, new, old: ^Map_En
 }
 
 __dynamic_map_erase :: proc(using h: Map_Header, fr: Map_Find_Result) #no_bounds_check {
-	if fr.entry_prev < 0 {
-		m.hashes[fr.hash_index] = __dynamic_map_get_entry(h, fr.entry_index).next;
-	} else {
-		prev := __dynamic_map_get_entry(h, fr.entry_prev);
-		curr := __dynamic_map_get_entry(h, fr.entry_index);
-		prev.next = curr.next;
+	mask := len(m.hashes)-1;
+
+	// NOTE: Shift back each following slot which may fill the hole, a slot may move back
+	// if the hole lies within its probe, i.e. between its home and itself
+	hole := fr.hash_index;
+	for pos := (hole+1) & mask; m.hashes[pos] != MAP_SLOT_EMPTY; pos = (pos+1) & mask {
+		slot := m.hashes[pos];
+		entry := __dynamic_map_get_entry(h, slot & MAP_SLOT_INDEX_MASK);
+		home := __dynamic_map_slot_home(entry.hash, mask);
+		if (pos-home) & mask >= (pos-hole) & mask {
+			m.hashes[hole] = slot;
+			hole = pos;
+		}
 	}
-	if fr.entry_index == m.entries.len-1 {
-		// NOTE(bill): No need to do anything else, just pop
-	} else {
+	m.hashes[hole] = MAP_SLOT_EMPTY;
+
+	last_index := m.entries.len-1;
+	if fr.entry_index != last_index {
+		// NOTE: Keep the entries contiguous by moving the last entry into the erased one
 		old := __dynamic_map_get_entry(h, fr.entry_index);
-		end := __dynamic_map_get_entry(h, m.entries.len-1);
+		end := __dynamic_map_get_entry(h, last_index);
 		__dynamic_map_copy_entry(h, old, end);
 
-		old_hash := __get_map_hash_from_entry(h, old);
-
-		if last := __dynamic_map_find(h, old_hash); last.entry_prev >= 0 {
-			last_entry := __dynamic_map_get_entry(h, last.entry_prev);
-			last_entry.next = fr.entry_index;
-		} else {
-			m.hashes[last.hash_index] = fr.entry_index;
-		}
+		slot_index := __dynamic_map_find_slot(h, old.hash, last_index);
+		m.hashes[slot_index] = __dynamic_map_slot_make(fr.entry_index, old.hash);
 	}
 
 	m.entries.len -= 1;
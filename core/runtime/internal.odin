@@ -180,6 +180,26 @@ mem_resize :: #force_inline proc(ptr: rawptr, old_size, new_size: int, alignment
 memory_equal :: proc "contextless" (a, b: rawptr, n: int) -> bool {
 	return memory_compare(a, b, n) == 0;
 }
+// NOTE: Used by the backend for word aligned records too large to compare inline;
+// n must be a multiple of size_of(uintptr) and neither pointer may be nil
+memory_equal_words :: proc "contextless" (a, b: rawptr, n: int) -> bool #no_bounds_check {
+	x := uintptr(a);
+	y := uintptr(b);
+	end := x + uintptr(n);
+	for /**/; x < end; x, y = x+2*size_of(uintptr), y+2*size_of(uintptr) {
+		if end - x < 2*size_of(uintptr) {
+			return (^uintptr)(x)^ == (^uintptr)(y)^;
+		}
+		va0 := (^uintptr)(x)^;
+		vb0 := (^uintptr)(y)^;
+		va1 := (^uintptr)(x + size_of(uintptr))^;
+		vb1 := (^uintptr)(y + size_of(uintptr))^;
+		if (va0 ~ vb0) | (va1 ~ vb1) != 0 {
+			return false;
+		}
+	}
+	return true;
+}
 memory_compare :: proc "contextless" (a, b: rawptr, n: int) -> int #no_bounds_check {
 	switch {
 	case a == b:   return 0;
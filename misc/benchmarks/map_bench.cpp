@@ -0,0 +1,186 @@
+// Micro-benchmark of Map, PtrSet and StringMap (src/map.cpp, src/ptr_set.cpp, src/string_map.cpp)
+// against the chained tables which they replaced (map_bench_baseline.cpp), in the same binary.
+//
+// The synthetic cases use keys shaped like the compiler's:
+//   - PtrSet:    many small sets of nearby pointers, like the dependency sets of each DeclInfo
+//   - Map:       200k pointer keys allocated back to back, like lbModule::values
+//   - StringMap: identifier lookups, like scope lookups, most of which find an entry
+//   - multi_map: many values per key, like the generated procedure indices, iterated newest first
+//
+// Given a trace, every table operation of a real run is replayed as well. To dump one, build the
+// compiler with MAP_TRACE and run it with ODIN_MAP_TRACE set:
+//     make release CC="clang -DMAP_TRACE=1"
+//     ODIN_MAP_TRACE=map.trace ./odin check examples/demo -thread-count:1
+//
+// Build and run from the root of the repository:
+//     g++ -std=c++14 -O2 misc/benchmarks/map_bench.cpp -pthread -o map_bench
+//     ./map_bench [runs] [trace]
+
+#include "../../src/common.cpp"
+
+#define BENCH_POINTER_COUNT (200*1000)
+#define BENCH_SET_COUNT     (20*1000)
+#define BENCH_IDENT_COUNT   (50*1000)
+#define BENCH_LOOKUP_COUNT  (2*1000*1000)
+
+struct BenchNode {
+	u8 data[48]; // NOTE: Roughly the size of the smaller Ast nodes and Entities
+};
+
+struct BenchTraceOp {
+	u8            table_kind; // MapTraceTable
+	u8            op;         // MapTraceOp
+	u32           table;      // Index of the table among those of its kind
+	u64           key;
+	StringHashKey string_key;
+};
+
+struct BenchTrace {
+	gbFileContents      contents; // NOTE: The text of the string keys points into this
+	Array<BenchTraceOp> ops;
+	isize               table_counts[3];
+};
+
+gb_global BenchNode *bench_nodes;
+gb_global Array<String> bench_idents;
+gb_global BenchTrace bench_trace;
+
+u64 bench_rand(u64 *state) {
+	*state = *state*6364136223846793005ull + 1442695040888963407ull;
+	return *state >> 33;
+}
+
+#include "map_bench_cases.cpp"
+
+#include "map_bench_baseline.cpp"
+namespace baseline {
+#include "map_bench_cases.cpp"
+}
+
+// NOTE: A table is known by its address until it is destroyed. Tables seen without a MapTraceOp_Init
+// (zero initialised, or set up before the trace was opened) get one with the default capacity, as
+// the baseline PtrSet cannot start out empty.
+bool bench_trace_load(BenchTrace *t, char const *path) {
+	t->contents = gb_file_read_contents(heap_allocator(), false, path);
+	if (t->contents.data == nullptr) {
+		gb_printf_err("could not read the trace '%s'\n", path);
+		return false;
+	}
+	array_init(&t->ops, heap_allocator());
+
+	Map<isize> live[3] = {};
+	for (isize i = 0; i < gb_count_of(live); i++) {
+		map_init(&live[i], heap_allocator());
+	}
+
+	u8 *data = cast(u8 *)t->contents.data;
+	isize offset = 0;
+	while (offset + gb_size_of(MapTraceRecord) <= t->contents.size) {
+		MapTraceRecord r = {};
+		gb_memmove(&r, data + offset, gb_size_of(r));
+		offset += gb_size_of(r);
+		String str = make_string(data + offset, r.string_len);
+		offset += r.string_len;
+		GB_ASSERT(r.table_kind < gb_count_of(live));
+
+		BenchTraceOp op = {};
+		op.table_kind = r.table_kind;
+		op.op         = r.op;
+		op.key        = r.key;
+		op.string_key.hash   = r.key;
+		op.string_key.string = str;
+
+		HashKey table_key = hash_integer(r.table);
+		isize *found = map_get(&live[r.table_kind], table_key);
+		if (found == nullptr || r.op == MapTraceOp_Init) {
+			isize index = t->table_counts[r.table_kind]++;
+			map_set(&live[r.table_kind], table_key, index);
+			if (r.op != MapTraceOp_Init) {
+				BenchTraceOp init = {};
+				init.table_kind = r.table_kind;
+				init.op         = MapTraceOp_Init;
+				init.table      = cast(u32)index;
+				init.key        = 16;
+				array_add(&t->ops, init);
+			}
+			op.table = cast(u32)index;
+		} else {
+			op.table = cast(u32)*found;
+		}
+		if (r.op == MapTraceOp_Destroy) {
+			map_remove(&live[r.table_kind], table_key);
+		}
+		array_add(&t->ops, op);
+	}
+
+	for (isize i = 0; i < gb_count_of(live); i++) {
+		map_destroy(&live[i]);
+	}
+	return true;
+}
+
+typedef u64 BenchProc(void);
+
+u64 bench_report(char const *name, BenchProc *proc, isize runs) {
+	f64 best = 0;
+	u64 result = 0;
+	for (isize run = 0; run < runs; run++) {
+		f64 start = gb_time_now();
+		result = proc();
+		f64 elapsed = gb_time_now() - start;
+		if (run == 0 || elapsed < best) {
+			best = elapsed;
+		}
+	}
+	isize name_len = gb_strlen(name);
+	gb_printf("%s%.*s - %8.3f ms (%llu)\n",
+	          name, cast(int)gb_max(20 - name_len, 0), "                    ",
+	          1000.0*best, cast(unsigned long long)result);
+	return result;
+}
+
+void bench_compare(char const *name, BenchProc *baseline_proc, BenchProc *proc, isize runs) {
+	char baseline_name[64] = {};
+	gb_snprintf(baseline_name, gb_size_of(baseline_name), "%s (baseline)", name);
+	u64 baseline_result = bench_report(baseline_name, baseline_proc, runs);
+	u64 result          = bench_report(name,          proc,          runs);
+	GB_ASSERT_MSG(baseline_result == result, "%s: the baseline and the current tables disagree", name);
+}
+
+int main(int argc, char **argv) {
+	isize runs = argc > 1 ? cast(isize)atoi(argv[1]) : 5;
+	char const *trace_path = argc > 2 ? argv[2] : nullptr;
+
+	bench_nodes = gb_alloc_array(heap_allocator(), BenchNode, BENCH_POINTER_COUNT);
+	array_init(&bench_idents, heap_allocator(), 0, BENCH_IDENT_COUNT);
+	char const *prefixes[] = {"", "lb_", "check_", "type_", "is_type_", "map_", "string_", "ast_"};
+	char const *words[] = {"value", "proc", "entity", "decl", "scope", "expr", "stmt", "info", "array", "ptr"};
+	for (isize i = 0; i < BENCH_IDENT_COUNT; i++) {
+		char buf[64] = {};
+		isize len = gb_snprintf(buf, gb_size_of(buf), "%s%s_%s%td",
+		                        prefixes[i % gb_count_of(prefixes)],
+		                        words[(i/8) % gb_count_of(words)],
+		                        words[(i/80) % gb_count_of(words)],
+		                        i/800);
+		array_add(&bench_idents, copy_string(heap_allocator(), make_string(cast(u8 *)buf, len-1)));
+	}
+
+	gb_printf("best of %td runs\n", runs);
+	bench_compare("PtrSet",    baseline::bench_ptr_set,    bench_ptr_set,    runs);
+	bench_compare("Map",       baseline::bench_map,        bench_map,        runs);
+	bench_compare("StringMap", baseline::bench_string_map, bench_string_map, runs);
+	bench_compare("multi_map", baseline::bench_multi_map,  bench_multi_map,  runs);
+
+	if (trace_path != nullptr) {
+		if (!bench_trace_load(&bench_trace, trace_path)) {
+			return 1;
+		}
+		gb_printf("trace: %td operations on %td Maps, %td PtrSets and %td StringMaps\n",
+		          bench_trace.ops.count,
+		          bench_trace.table_counts[MapTraceTable_Map],
+		          bench_trace.table_counts[MapTraceTable_PtrSet],
+		          bench_trace.table_counts[MapTraceTable_StringMap]);
+		bench_compare("trace", baseline::bench_trace_replay, bench_trace_replay, runs);
+	}
+	return 0;
+}
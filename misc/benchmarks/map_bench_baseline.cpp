@@ -0,0 +1,794 @@
+// The chained Map, PtrSet and StringMap which the open addressed tables replaced, kept as the
+// baseline of map_bench.cpp. The code is the same as src/map.cpp, src/ptr_set.cpp and
+// src/string_map.cpp before the change, minus HashKey, StringHashKey and their helpers, which
+// did not change and are shared with the current tables.
+//
+// NOTE: The original erase procedures moved the last entry into the hole without popping it. The
+// stale copy stayed in `entries` and could later be linked back in, so a replayed trace found
+// keys which had been removed. Each now has the missing array_pop, so that both sets of tables
+// give the same results. This only makes the baseline faster.
+namespace baseline {
+
+struct MapFindResult {
+	isize hash_index;
+	isize entry_prev;
+	isize entry_index;
+};
+
+template <typename T>
+struct MapEntry {
+	HashKey  key;
+	isize    next;
+	T        value;
+};
+
+template <typename T>
+struct Map {
+	Slice<isize>        hashes;
+	Array<MapEntry<T> > entries;
+};
+
+
+template <typename T> void map_init             (Map<T> *h, gbAllocator a, isize capacity = 16);
+template <typename T> void map_destroy          (Map<T> *h);
+template <typename T> T *  map_get              (Map<T> *h, HashKey const &key);
+template <typename T> T &  map_must_get         (Map<T> *h, HashKey const &key);
+template <typename T> void map_set              (Map<T> *h, HashKey const &key, T const &value);
+template <typename T> void map_remove           (Map<T> *h, HashKey const &key);
+template <typename T> void map_clear            (Map<T> *h);
+template <typename T> void map_grow             (Map<T> *h);
+template <typename T> void map_rehash           (Map<T> *h, isize new_count);
+
+#if MAP_ENABLE_MULTI_MAP
+// Mutlivalued map procedure
+template <typename T> MapEntry<T> * multi_map_find_first(Map<T> *h, HashKey const &key);
+template <typename T> MapEntry<T> * multi_map_find_next (Map<T> *h, MapEntry<T> *e);
+
+template <typename T> isize multi_map_count     (Map<T> *h, HashKey const &key);
+template <typename T> void  multi_map_get_all   (Map<T> *h, HashKey const &key, T *items);
+template <typename T> void  multi_map_insert    (Map<T> *h, HashKey const &key, T const &value);
+template <typename T> void  multi_map_remove    (Map<T> *h, HashKey const &key, MapEntry<T> *e);
+template <typename T> void  multi_map_remove_all(Map<T> *h, HashKey const &key);
+#endif
+
+template <typename T>
+gb_inline void map_init(Map<T> *h, gbAllocator a, isize capacity) {
+	capacity = next_pow2_isize(capacity);
+	slice_init(&h->hashes,  a, capacity);
+	array_init(&h->entries, a, 0, capacity);
+	for (isize i = 0; i < capacity; i++) {
+		h->hashes.data[i] = -1;
+	}
+}
+
+template <typename T>
+gb_inline void map_destroy(Map<T> *h) {
+	slice_free(&h->hashes, h->entries.allocator);
+	array_free(&h->entries);
+}
+
+template <typename T>
+gb_internal isize map__add_entry(Map<T> *h, HashKey const &key) {
+	MapEntry<T> e = {};
+	e.key = key;
+	e.next = -1;
+	array_add(&h->entries, e);
+	return h->entries.count-1;
+}
+
+template <typename T>
+gb_internal MapFindResult map__find(Map<T> *h, HashKey const &key) {
+	MapFindResult fr = {-1, -1, -1};
+	if (h->hashes.count > 0) {
+		fr.hash_index = key.key & (h->hashes.count-1);
+		fr.entry_index = h->hashes.data[fr.hash_index];
+		while (fr.entry_index >= 0) {
+			if (hash_key_equal(h->entries.data[fr.entry_index].key, key)) {
+				return fr;
+			}
+			fr.entry_prev = fr.entry_index;
+			fr.entry_index = h->entries.data[fr.entry_index].next;
+		}
+	}
+	return fr;
+}
+
+template <typename T>
+gb_internal MapFindResult map__find_from_entry(Map<T> *h, MapEntry<T> *e) {
+	MapFindResult fr = {-1, -1, -1};
+	if (h->hashes.count > 0) {
+		fr.hash_index  = e->key.key & (h->hashes.count-1);
+		fr.entry_index = h->hashes.data[fr.hash_index];
+		while (fr.entry_index >= 0) {
+			if (&h->entries.data[fr.entry_index] == e) {
+				return fr;
+			}
+			fr.entry_prev = fr.entry_index;
+			fr.entry_index = h->entries.data[fr.entry_index].next;
+		}
+	}
+	return fr;
+}
+
+template <typename T>
+gb_internal b32 map__full(Map<T> *h) {
+	return 0.75f * h->hashes.count <= h->entries.count;
+}
+
+template <typename T>
+gb_inline void map_grow(Map<T> *h) {
+	isize new_count = gb_max(h->hashes.count<<1, 16);
+	map_rehash(h, new_count);
+}
+
+template <typename T>
+void map_rehash(Map<T> *h, isize new_count) {
+	isize i, j;
+	Map<T> nh = {};
+	new_count = next_pow2_isize(new_count);
+	nh.hashes = h->hashes;
+	nh.entries.allocator = h->entries.allocator;
+	slice_resize(&nh.hashes, h->entries.allocator, new_count);
+	for (i = 0; i < new_count; i++) {
+		nh.hashes.data[i] = -1;
+	}
+	array_reserve(&nh.entries, ARRAY_GROW_FORMULA(h->entries.count));
+	for (i = 0; i < h->entries.count; i++) {
+		MapEntry<T> *e = &h->entries.data[i];
+		MapFindResult fr;
+		if (nh.hashes.count == 0) {
+			map_grow(&nh);
+		}
+		fr = map__find(&nh, e->key);
+		j = map__add_entry(&nh, e->key);
+		if (fr.entry_prev < 0) {
+			nh.hashes.data[fr.hash_index] = j;
+		} else {
+			nh.entries.data[fr.entry_prev].next = j;
+		}
+		nh.entries.data[j].next = fr.entry_index;
+		nh.entries.data[j].value = e->value;
+		if (map__full(&nh)) {
+			map_grow(&nh);
+		}
+	}
+	array_free(&h->entries);
+	*h = nh;
+}
+
+template <typename T>
+T *map_get(Map<T> *h, HashKey const &key) {
+	isize index = map__find(h, key).entry_index;
+	if (index >= 0) {
+		return &h->entries.data[index].value;
+	}
+	return nullptr;
+}
+
+template <typename T>
+T &map_must_get(Map<T> *h, HashKey const &key) {
+	isize index = map__find(h, key).entry_index;
+	GB_ASSERT(index >= 0);
+	return h->entries.data[index].value;
+}
+
+template <typename T>
+void map_set(Map<T> *h, HashKey const &key, T const &value) {
+	isize index;
+	MapFindResult fr;
+	if (h->hashes.count == 0) {
+		map_grow(h);
+	}
+	fr = map__find(h, key);
+	if (fr.entry_index >= 0) {
+		index = fr.entry_index;
+	} else {
+		index = map__add_entry(h, key);
+		if (fr.entry_prev >= 0) {
+			h->entries.data[fr.entry_prev].next = index;
+		} else {
+			h->hashes.data[fr.hash_index] = index;
+		}
+	}
+	h->entries.data[index].value = value;
+
+	if (map__full(h)) {
+		map_grow(h);
+	}
+}
+
+
+template <typename T>
+void map__erase(Map<T> *h, MapFindResult const &fr) {
+	MapFindResult last;
+	if (fr.entry_prev < 0) {
+		h->hashes.data[fr.hash_index] = h->entries.data[fr.entry_index].next;
+	} else {
+		h->entries.data[fr.entry_prev].next = h->entries.data[fr.entry_index].next;
+	}
+	if (fr.entry_index == h->entries.count-1) {
+		array_pop(&h->entries);
+		return;
+	}
+	h->entries.data[fr.entry_index] = h->entries.data[h->entries.count-1];
+	array_pop(&h->entries); // NOTE: Missing from the original, see the top of the file
+	last = map__find(h, h->entries.data[fr.entry_index].key);
+	if (last.entry_prev >= 0) {
+		h->entries.data[last.entry_prev].next = fr.entry_index;
+	} else {
+		h->hashes.data[last.hash_index] = fr.entry_index;
+	}
+}
+
+template <typename T>
+void map_remove(Map<T> *h, HashKey const &key) {
+	MapFindResult fr = map__find(h, key);
+	if (fr.entry_index >= 0) {
+		map__erase(h, fr);
+	}
+}
+
+template <typename T>
+gb_inline void map_clear(Map<T> *h) {
+	array_clear(&h->entries);
+	for (isize i = 0; i < h->hashes.count; i++) {
+		h->hashes.data[i] = -1;
+	}
+}
+
+
+#if MAP_ENABLE_MULTI_MAP
+template <typename T>
+MapEntry<T> *multi_map_find_first(Map<T> *h, HashKey const &key) {
+	isize i = map__find(h, key).entry_index;
+	if (i < 0) {
+		return nullptr;
+	}
+	return &h->entries.data[i];
+}
+
+template <typename T>
+MapEntry<T> *multi_map_find_next(Map<T> *h, MapEntry<T> *e) {
+	isize i = e->next;
+	while (i >= 0) {
+		if (hash_key_equal(h->entries.data[i].key, e->key)) {
+			return &h->entries.data[i];
+		}
+		i = h->entries.data[i].next;
+	}
+	return nullptr;
+}
+
+template <typename T>
+isize multi_map_count(Map<T> *h, HashKey const &key) {
+	isize count = 0;
+	MapEntry<T> *e = multi_map_find_first(h, key);
+	while (e != nullptr) {
+		count++;
+		e = multi_map_find_next(h, e);
+	}
+	return count;
+}
+
+template <typename T>
+void multi_map_get_all(Map<T> *h, HashKey const &key, T *items) {
+	isize i = 0;
+	MapEntry<T> *e = multi_map_find_first(h, key);
+	while (e != nullptr) {
+		items[i++] = e->value;
+		e = multi_map_find_next(h, e);
+	}
+}
+
+template <typename T>
+void multi_map_insert(Map<T> *h, HashKey const &key, T const &value) {
+	MapFindResult fr;
+	isize i;
+	if (h->hashes.count == 0) {
+		map_grow(h);
+	}
+	// Make
+	fr = map__find(h, key);
+	i = map__add_entry(h, key);
+	if (fr.entry_prev < 0) {
+		h->hashes.data[fr.hash_index] = i;
+	} else {
+		h->entries.data[fr.entry_prev].next = i;
+	}
+	h->entries.data[i].next = fr.entry_index;
+	h->entries.data[i].value = value;
+	// Grow if needed
+	if (map__full(h)) {
+		map_grow(h);
+	}
+}
+
+template <typename T>
+void multi_map_remove(Map<T> *h, HashKey const &key, MapEntry<T> *e) {
+	MapFindResult fr = map__find_from_entry(h, e);
+	if (fr.entry_index >= 0) {
+		map__erase(h, fr);
+	}
+}
+
+template <typename T>
+void multi_map_remove_all(Map<T> *h, HashKey const &key) {
+	while (map_get(h, key) != nullptr) {
+		map_remove(h, key);
+	}
+}
+#endif
+
+
+typedef u32 PtrSetIndex;
+
+struct PtrSetFindResult {
+	PtrSetIndex hash_index;
+	PtrSetIndex entry_prev;
+	PtrSetIndex entry_index;
+};
+
+enum : PtrSetIndex { PTR_SET_SENTINEL = ~(PtrSetIndex)0 };
+
+
+template <typename T>
+struct PtrSetEntry {
+	T           ptr;
+	PtrSetIndex next;
+};
+
+template <typename T>
+struct PtrSet {
+	Array<PtrSetIndex>    hashes;
+	Array<PtrSetEntry<T>> entries;
+};
+
+template <typename T> void ptr_set_init   (PtrSet<T> *s, gbAllocator a, isize capacity = 16);
+template <typename T> void ptr_set_destroy(PtrSet<T> *s);
+template <typename T> T    ptr_set_add    (PtrSet<T> *s, T ptr);
+template <typename T> bool ptr_set_update (PtrSet<T> *s, T ptr); // returns true if it previously existsed
+template <typename T> bool ptr_set_exists (PtrSet<T> *s, T ptr);
+template <typename T> void ptr_set_remove (PtrSet<T> *s, T ptr);
+template <typename T> void ptr_set_clear  (PtrSet<T> *s);
+template <typename T> void ptr_set_grow   (PtrSet<T> *s);
+template <typename T> void ptr_set_rehash (PtrSet<T> *s, isize new_count);
+
+
+template <typename T>
+void ptr_set_init(PtrSet<T> *s, gbAllocator a, isize capacity) {
+	capacity = next_pow2_isize(gb_max(16, capacity));
+
+	array_init(&s->hashes,  a, capacity);
+	array_init(&s->entries, a, 0, capacity);
+	for (isize i = 0; i < capacity; i++) {
+		s->hashes.data[i] = PTR_SET_SENTINEL;
+	}
+}
+
+template <typename T>
+void ptr_set_destroy(PtrSet<T> *s) {
+	array_free(&s->hashes);
+	array_free(&s->entries);
+}
+
+template <typename T>
+gb_internal PtrSetIndex ptr_set__add_entry(PtrSet<T> *s, T ptr) {
+	PtrSetEntry<T> e = {};
+	e.ptr = ptr;
+	e.next = PTR_SET_SENTINEL;
+	array_add(&s->entries, e);
+	return cast(PtrSetIndex)(s->entries.count-1);
+}
+
+
+template <typename T>
+gb_internal PtrSetFindResult ptr_set__find(PtrSet<T> *s, T ptr) {
+	PtrSetFindResult fr = {PTR_SET_SENTINEL, PTR_SET_SENTINEL, PTR_SET_SENTINEL};
+	if (s->hashes.count != 0) {
+		u64 hash = 0xcbf29ce484222325ull ^ cast(u64)cast(uintptr)ptr;
+		u64 n = cast(u64)s->hashes.count;
+		fr.hash_index = cast(PtrSetIndex)(hash & (n-1));
+		fr.entry_index = s->hashes.data[fr.hash_index];
+		while (fr.entry_index != PTR_SET_SENTINEL) {
+			if (s->entries.data[fr.entry_index].ptr == ptr) {
+				return fr;
+			}
+			fr.entry_prev = fr.entry_index;
+			fr.entry_index = s->entries.data[fr.entry_index].next;
+		}
+	}
+	return fr;
+}
+
+template <typename T>
+gb_internal bool ptr_set__full(PtrSet<T> *s) {
+	return 0.75f * s->hashes.count <= s->entries.count;
+}
+
+template <typename T>
+gb_inline void ptr_set_grow(PtrSet<T> *s) {
+	isize new_count = s->hashes.count*2;
+	ptr_set_rehash(s, new_count);
+}
+
+template <typename T>
+void ptr_set_rehash(PtrSet<T> *s, isize new_count) {
+	isize i, j;
+	PtrSet<T> ns = {};
+	ptr_set_init(&ns, s->hashes.allocator);
+	array_resize(&ns.hashes, new_count);
+	array_reserve(&ns.entries, s->entries.count);
+	for (i = 0; i < new_count; i++) {
+		ns.hashes.data[i] = PTR_SET_SENTINEL;
+	}
+	for (i = 0; i < s->entries.count; i++) {
+		PtrSetEntry<T> *e = &s->entries.data[i];
+		PtrSetFindResult fr;
+		if (ns.hashes.count == 0) {
+			ptr_set_grow(&ns);
+		}
+		fr = ptr_set__find(&ns, e->ptr);
+		j = ptr_set__add_entry(&ns, e->ptr);
+		if (fr.entry_prev == PTR_SET_SENTINEL) {
+			ns.hashes.data[fr.hash_index] = cast(PtrSetIndex)j;
+		} else {
+			ns.entries.data[fr.entry_prev].next = cast(PtrSetIndex)j;
+		}
+		ns.entries.data[j].next = fr.entry_index;
+		if (ptr_set__full(&ns)) {
+			ptr_set_grow(&ns);
+		}
+	}
+	ptr_set_destroy(s);
+	*s = ns;
+}
+
+template <typename T>
+gb_inline bool ptr_set_exists(PtrSet<T> *s, T ptr) {
+	isize index = ptr_set__find(s, ptr).entry_index;
+	return index != PTR_SET_SENTINEL;
+}
+
+// Returns true if it already exists
+template <typename T>
+T ptr_set_add(PtrSet<T> *s, T ptr) {
+	PtrSetIndex index;
+	PtrSetFindResult fr;
+	if (s->hashes.count == 0) {
+		ptr_set_grow(s);
+	}
+	fr = ptr_set__find(s, ptr);
+	if (fr.entry_index == PTR_SET_SENTINEL) {
+		index = ptr_set__add_entry(s, ptr);
+		if (fr.entry_prev != PTR_SET_SENTINEL) {
+			s->entries.data[fr.entry_prev].next = index;
+		} else {
+			s->hashes.data[fr.hash_index] = index;
+		}
+	}
+	if (ptr_set__full(s)) {
+		ptr_set_grow(s);
+	}
+	return ptr;
+}
+
+template <typename T>
+bool ptr_set_update(PtrSet<T> *s, T ptr) { // returns true if it previously existsed
+	bool exists = false;
+	PtrSetIndex index;
+	PtrSetFindResult fr;
+	if (s->hashes.count == 0) {
+		ptr_set_grow(s);
+	}
+	fr = ptr_set__find(s, ptr);
+	if (fr.entry_index != PTR_SET_SENTINEL) {
+		exists = true;
+	} else {
+		index = ptr_set__add_entry(s, ptr);
+		if (fr.entry_prev != PTR_SET_SENTINEL) {
+			s->entries.data[fr.entry_prev].next = index;
+		} else {
+			s->hashes.data[fr.hash_index] = index;
+		}
+	}
+	if (ptr_set__full(s)) {
+		ptr_set_grow(s);
+	}
+	return exists;
+}
+
+
+
+template <typename T>
+void ptr_set__erase(PtrSet<T> *s, PtrSetFindResult fr) {
+	PtrSetFindResult last;
+	if (fr.entry_prev == PTR_SET_SENTINEL) {
+		s->hashes.data[fr.hash_index] = s->entries.data[fr.entry_index].next;
+	} else {
+		s->entries.data[fr.entry_prev].next = s->entries.data[fr.entry_index].next;
+	}
+	if (cast(isize)fr.entry_index == s->entries.count-1) {
+		array_pop(&s->entries);
+		return;
+	}
+	s->entries.data[fr.entry_index] = s->entries.data[s->entries.count-1];
+	array_pop(&s->entries); // NOTE: Missing from the original, see the top of the file
+	last = ptr_set__find(s, s->entries.data[fr.entry_index].ptr);
+	if (last.entry_prev != PTR_SET_SENTINEL) {
+		s->entries.data[last.entry_prev].next = fr.entry_index;
+	} else {
+		s->hashes.data[last.hash_index] = fr.entry_index;
+	}
+}
+
+template <typename T>
+void ptr_set_remove(PtrSet<T> *s, T ptr) {
+	PtrSetFindResult fr = ptr_set__find(s, ptr);
+	if (fr.entry_index != PTR_SET_SENTINEL) {
+		ptr_set__erase(s, fr);
+	}
+}
+
+template <typename T>
+gb_inline void ptr_set_clear(PtrSet<T> *s) {
+	array_clear(&s->hashes);
+	array_clear(&s->entries);
+}
+
+
+struct StringMapFindResult {
+	isize hash_index;
+	isize entry_prev;
+	isize entry_index;
+};
+
+template <typename T>
+struct StringMapEntry {
+	StringHashKey key;
+	isize         next;
+	T             value;
+};
+
+template <typename T>
+struct StringMap {
+	Slice<isize>              hashes;
+	Array<StringMapEntry<T> > entries;
+};
+
+
+template <typename T> void string_map_init             (StringMap<T> *h, gbAllocator a, isize capacity = 16);
+template <typename T> void string_map_destroy          (StringMap<T> *h);
+
+template <typename T> T *  string_map_get              (StringMap<T> *h, char const *key);
+template <typename T> T *  string_map_get              (StringMap<T> *h, String const &key);
+template <typename T> T *  string_map_get              (StringMap<T> *h, StringHashKey const &key);
+
+template <typename T> T &  string_map_must_get         (StringMap<T> *h, char const *key);
+template <typename T> T &  string_map_must_get         (StringMap<T> *h, String const &key);
+template <typename T> T &  string_map_must_get         (StringMap<T> *h, StringHashKey const &key);
+
+template <typename T> void string_map_set              (StringMap<T> *h, StringHashKey const &key, T const &value);
+template <typename T> void string_map_set              (StringMap<T> *h, String const &key, T const &value);
+template <typename T> void string_map_set              (StringMap<T> *h, char const *key,   T const &value);
+
+template <typename T> void string_map_remove           (StringMap<T> *h, StringHashKey const &key);
+template <typename T> void string_map_clear            (StringMap<T> *h);
+template <typename T> void string_map_grow             (StringMap<T> *h);
+template <typename T> void string_map_rehash           (StringMap<T> *h, isize new_count);
+
+template <typename T>
+gb_inline void string_map_init(StringMap<T> *h, gbAllocator a, isize capacity) {
+	capacity = next_pow2_isize(capacity);
+	slice_init(&h->hashes,  a, capacity);
+	array_init(&h->entries, a, 0, capacity);
+	for (isize i = 0; i < capacity; i++) {
+		h->hashes.data[i] = -1;
+	}
+}
+
+template <typename T>
+gb_inline void string_map_destroy(StringMap<T> *h) {
+	slice_free(&h->hashes, h->entries.allocator);
+	array_free(&h->entries);
+}
+
+template <typename T>
+gb_internal isize string_map__add_entry(StringMap<T> *h, StringHashKey const &key) {
+	StringMapEntry<T> e = {};
+	e.key = key;
+	e.next = -1;
+	array_add(&h->entries, e);
+	return h->entries.count-1;
+}
+
+template <typename T>
+gb_internal StringMapFindResult string_map__find(StringMap<T> *h, StringHashKey const &key) {
+	StringMapFindResult fr = {-1, -1, -1};
+	if (h->hashes.count != 0) {
+		fr.hash_index = key.hash & (h->hashes.count-1);
+		fr.entry_index = h->hashes.data[fr.hash_index];
+		while (fr.entry_index >= 0) {
+			if (string_hash_key_equal(h->entries.data[fr.entry_index].key, key)) {
+				return fr;
+			}
+			fr.entry_prev = fr.entry_index;
+			fr.entry_index = h->entries.data[fr.entry_index].next;
+		}
+	}
+	return fr;
+}
+
+template <typename T>
+gb_internal StringMapFindResult string_map__find_from_entry(StringMap<T> *h, StringMapEntry<T> *e) {
+	StringMapFindResult fr = {-1, -1, -1};
+	if (h->hashes.count != 0) {
+		fr.hash_index  = e->key.hash & (h->hashes.count-1);
+		fr.entry_index = h->hashes.data[fr.hash_index];
+		while (fr.entry_index >= 0) {
+			if (&h->entries.data[fr.entry_index] == e) {
+				return fr;
+			}
+			fr.entry_prev = fr.entry_index;
+			fr.entry_index = h->entries.data[fr.entry_index].next;
+		}
+	}
+	return fr;
+}
+
+template <typename T>
+gb_internal b32 string_map__full(StringMap<T> *h) {
+	return 0.75f * h->hashes.count <= h->entries.count;
+}
+
+template <typename T>
+gb_inline void string_map_grow(StringMap<T> *h) {
+	isize new_count = gb_max(h->hashes.count<<1, 16);
+	string_map_rehash(h, new_count);
+}
+
+template <typename T>
+void string_map_rehash(StringMap<T> *h, isize new_count) {
+	isize i, j;
+	StringMap<T> nh = {};
+	new_count = next_pow2_isize(new_count);
+	nh.hashes = h->hashes;
+	nh.entries.allocator = h->entries.allocator;
+	slice_resize(&nh.hashes, h->entries.allocator, new_count);
+	for (i = 0; i < new_count; i++) {
+		nh.hashes.data[i] = -1;
+	}
+	array_reserve(&nh.entries, ARRAY_GROW_FORMULA(h->entries.count));
+	for (i = 0; i < h->entries.count; i++) {
+		StringMapEntry<T> *e = &h->entries.data[i];
+		StringMapFindResult fr;
+		if (nh.hashes.count == 0) {
+			string_map_grow(&nh);
+		}
+		fr = string_map__find(&nh, e->key);
+		j = string_map__add_entry(&nh, e->key);
+		if (fr.entry_prev < 0) {
+			nh.hashes.data[fr.hash_index] = j;
+		} else {
+			nh.entries.data[fr.entry_prev].next = j;
+		}
+		nh.entries.data[j].next = fr.entry_index;
+		nh.entries.data[j].value = e->value;
+		if (string_map__full(&nh)) {
+			string_map_grow(&nh);
+		}
+	}
+	array_free(&h->entries);
+	*h = nh;
+}
+
+template <typename T>
+T *string_map_get(StringMap<T> *h, StringHashKey const &key) {
+	isize index = string_map__find(h, key).entry_index;
+	if (index >= 0) {
+		return &h->entries.data[index].value;
+	}
+	return nullptr;
+}
+
+template <typename T>
+gb_inline T *string_map_get(StringMap<T> *h, String const &key) {
+	return string_map_get(h, string_hash_string(key));
+}
+
+template <typename T>
+gb_inline T *string_map_get(StringMap<T> *h, char const *key) {
+	return string_map_get(h, string_hash_string(make_string_c(key)));
+}
+
+template <typename T>
+T &string_map_must_get(StringMap<T> *h, StringHashKey const &key) {
+	isize index = string_map__find(h, key).entry_index;
+	GB_ASSERT(index >= 0);
+	return h->entries.data[index].value;
+}
+
+template <typename T>
+gb_inline T &string_map_must_get(StringMap<T> *h, String const &key) {
+	return string_map_must_get(h, string_hash_string(key));
+}
+
+template <typename T>
+gb_inline T &string_map_must_get(StringMap<T> *h, char const *key) {
+	return string_map_must_get(h, string_hash_string(make_string_c(key)));
+}
+
+template <typename T>
+void string_map_set(StringMap<T> *h, StringHashKey const &key, T const &value) {
+	isize index;
+	StringMapFindResult fr;
+	if (h->hashes.count == 0) {
+		string_map_grow(h);
+	}
+	fr = string_map__find(h, key);
+	if (fr.entry_index >= 0) {
+		index = fr.entry_index;
+	} else {
+		index = string_map__add_entry(h, key);
+		if (fr.entry_prev >= 0) {
+			h->entries.data[fr.entry_prev].next = index;
+		} else {
+			h->hashes.data[fr.hash_index] = index;
+		}
+	}
+	h->entries.data[index].value = value;
+
+	if (string_map__full(h)) {
+		string_map_grow(h);
+	}
+}
+
+template <typename T>
+gb_inline void string_map_set(StringMap<T> *h, String const &key, T const &value) {
+	string_map_set(h, string_hash_string(key), value);
+}
+
+template <typename T>
+gb_inline void string_map_set(StringMap<T> *h, char const *key, T const &value) {
+	string_map_set(h, string_hash_string(make_string_c(key)), value);
+}
+
+
+template <typename T>
+void string_map__erase(StringMap<T> *h, StringMapFindResult const &fr) {
+	StringMapFindResult last;
+	if (fr.entry_prev < 0) {
+		h->hashes.data[fr.hash_index] = h->entries.data[fr.entry_index].next;
+	} else {
+		h->entries.data[fr.entry_prev].next = h->entries.data[fr.entry_index].next;
+	}
+	if (fr.entry_index == h->entries.count-1) {
+		array_pop(&h->entries);
+		return;
+	}
+	h->entries.data[fr.entry_index] = h->entries.data[h->entries.count-1];
+	array_pop(&h->entries); // NOTE: Missing from the original, see the top of the file
+	last = string_map__find(h, h->entries.data[fr.entry_index].key);
+	if (last.entry_prev >= 0) {
+		h->entries.data[last.entry_prev].next = fr.entry_index;
+	} else {
+		h->hashes.data[last.hash_index] = fr.entry_index;
+	}
+}
+
+template <typename T>
+void string_map_remove(StringMap<T> *h, StringHashKey const &key) {
+	StringMapFindResult fr = string_map__find(h, key);
+	if (fr.entry_index >= 0) {
+		string_map__erase(h, fr);
+	}
+}
+
+template <typename T>
+gb_inline void string_map_clear(StringMap<T> *h) {
+	array_clear(&h->entries);
+	for (isize i = 0; i < h->hashes.count; i++) {
+		h->hashes.data[i] = -1;
+	}
+}
+
+} // namespace baseline
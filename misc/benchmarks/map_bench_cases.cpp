@@ -0,0 +1,158 @@
+// The cases of map_bench.cpp. This file is included twice, once for the current tables and once
+// inside `namespace baseline`, so the same code runs against both.
+
+u64 bench_ptr_set(void) {
+	u64 found = 0;
+	u64 rng = 1;
+	for (isize i = 0; i < BENCH_SET_COUNT; i++) {
+		PtrSet<BenchNode *> set = {};
+		ptr_set_init(&set, heap_allocator(), 0);
+		isize count = 1 + cast(isize)(bench_rand(&rng) % 32);
+		isize base = cast(isize)(bench_rand(&rng) % (BENCH_POINTER_COUNT-256));
+		for (isize j = 0; j < count; j++) {
+			ptr_set_add(&set, &bench_nodes[base + cast(isize)(bench_rand(&rng) % 256)]);
+		}
+		for (isize j = 0; j < 64; j++) {
+			found += ptr_set_exists(&set, &bench_nodes[base + j*4]);
+		}
+		ptr_set_destroy(&set);
+	}
+	return found;
+}
+
+u64 bench_map(void) {
+	Map<isize> map = {};
+	map_init(&map, heap_allocator());
+	defer (map_destroy(&map));
+
+	for (isize i = 0; i < BENCH_POINTER_COUNT; i++) {
+		map_set(&map, hash_pointer(&bench_nodes[i]), i);
+	}
+	u64 found = 0;
+	for (isize round = 0; round < 5; round++) {
+		for (isize i = 0; i < BENCH_POINTER_COUNT; i++) {
+			isize *value = map_get(&map, hash_pointer(&bench_nodes[i]));
+			found += value != nullptr && *value == i;
+		}
+	}
+	return found;
+}
+
+u64 bench_string_map(void) {
+	StringMap<isize> map = {};
+	string_map_init(&map, heap_allocator());
+	defer (string_map_destroy(&map));
+
+	for_array(i, bench_idents) {
+		string_map_set(&map, bench_idents[i], i);
+	}
+	u64 found = 0;
+	u64 rng = 2;
+	for (isize i = 0; i < BENCH_LOOKUP_COUNT; i++) {
+		// NOTE: About one lookup in eight misses, as when a name is looked up in an inner scope first
+		isize index = cast(isize)(bench_rand(&rng) % (bench_idents.count + bench_idents.count/8));
+		String key = index < bench_idents.count ? bench_idents[index] : str_lit("not_declared_anywhere");
+		found += string_map_get(&map, key) != nullptr;
+	}
+	return found;
+}
+
+u64 bench_multi_map(void) {
+	Map<isize> map = {};
+	map_init(&map, heap_allocator());
+	defer (map_destroy(&map));
+
+	isize const key_count = BENCH_POINTER_COUNT/16;
+	for (isize i = 0; i < BENCH_POINTER_COUNT; i++) {
+		multi_map_insert(&map, hash_pointer(&bench_nodes[i % key_count]), i);
+	}
+	u64 found = 0;
+	for (isize k = 0; k < key_count; k++) {
+		isize prev = ISIZE_MAX;
+		HashKey key = hash_pointer(&bench_nodes[k]);
+		for (auto *e = multi_map_find_first(&map, key); e != nullptr; e = multi_map_find_next(&map, e)) {
+			GB_ASSERT_MSG(e->value < prev, "multi_map values of a key are not newest first");
+			prev = e->value;
+			found += 1;
+		}
+	}
+	return found;
+}
+
+// NOTE: Replays every operation of the trace in order. The values are the keys themselves, and a
+// `multi_map_find_first` walks every entry of its key, as multi_map_count and multi_map_get_all do
+u64 bench_trace_replay(void) {
+	BenchTrace *t = &bench_trace;
+	Map<u64>       *maps        = gb_alloc_array(heap_allocator(), Map<u64>,       t->table_counts[MapTraceTable_Map]);
+	PtrSet<void *> *ptr_sets    = gb_alloc_array(heap_allocator(), PtrSet<void *>, t->table_counts[MapTraceTable_PtrSet]);
+	StringMap<u64> *string_maps = gb_alloc_array(heap_allocator(), StringMap<u64>, t->table_counts[MapTraceTable_StringMap]);
+	gb_zero_size(maps,        gb_size_of(*maps)       *t->table_counts[MapTraceTable_Map]);
+	gb_zero_size(ptr_sets,    gb_size_of(*ptr_sets)   *t->table_counts[MapTraceTable_PtrSet]);
+	gb_zero_size(string_maps, gb_size_of(*string_maps)*t->table_counts[MapTraceTable_StringMap]);
+
+	u64 found = 0;
+	for_array(i, t->ops) {
+		BenchTraceOp const &op = t->ops[i];
+		switch (op.table_kind) {
+		case MapTraceTable_Map: {
+			Map<u64> *m = &maps[op.table];
+			HashKey key = hash_integer(op.key);
+			switch (op.op) {
+			case MapTraceOp_Init:        map_init(m, heap_allocator(), cast(isize)op.key); break;
+			case MapTraceOp_Destroy:     map_destroy(m); *m = {};                          break;
+			case MapTraceOp_Get:         found += map_get(m, key) != nullptr;              break;
+			case MapTraceOp_Set:         map_set(m, key, op.key);                          break;
+			case MapTraceOp_Remove:      map_remove(m, key);                               break;
+			case MapTraceOp_Clear:       map_clear(m);                                     break;
+			case MapTraceOp_MultiInsert: multi_map_insert(m, key, op.key);                 break;
+			case MapTraceOp_MultiFind:
+				for (auto *e = multi_map_find_first(m, key); e != nullptr; e = multi_map_find_next(m, e)) {
+					found += 1;
+				}
+				break;
+			}
+			break;
+		}
+		case MapTraceTable_PtrSet: {
+			PtrSet<void *> *s = &ptr_sets[op.table];
+			void *ptr = cast(void *)cast(uintptr)op.key;
+			switch (op.op) {
+			case MapTraceOp_Init:    ptr_set_init(s, heap_allocator(), cast(isize)op.key); break;
+			case MapTraceOp_Destroy: ptr_set_destroy(s); *s = {};                          break;
+			case MapTraceOp_Get:     found += ptr_set_exists(s, ptr);                      break;
+			case MapTraceOp_Set:     found += ptr_set_update(s, ptr);                      break;
+			case MapTraceOp_Remove:  ptr_set_remove(s, ptr);                               break;
+			case MapTraceOp_Clear:   ptr_set_clear(s);                                     break;
+			}
+			break;
+		}
+		case MapTraceTable_StringMap: {
+			StringMap<u64> *m = &string_maps[op.table];
+			switch (op.op) {
+			case MapTraceOp_Init:    string_map_init(m, heap_allocator(), cast(isize)op.key); break;
+			case MapTraceOp_Destroy: string_map_destroy(m); *m = {};                          break;
+			case MapTraceOp_Get:     found += string_map_get(m, op.string_key) != nullptr;    break;
+			case MapTraceOp_Set:     string_map_set(m, op.string_key, op.key);                break;
+			case MapTraceOp_Remove:  string_map_remove(m, op.string_key);                     break;
+			case MapTraceOp_Clear:   string_map_clear(m);                                     break;
+			}
+			break;
+		}
+		}
+	}
+
+	// NOTE: Most tables of a run are never destroyed, as they live in the permanent arena
+	for (isize i = 0; i < t->table_counts[MapTraceTable_Map]; i++) {
+		if (maps[i].entries.allocator.proc != nullptr) map_destroy(&maps[i]);
+	}
+	for (isize i = 0; i < t->table_counts[MapTraceTable_PtrSet]; i++) {
+		if (ptr_sets[i].entries.allocator.proc != nullptr) ptr_set_destroy(&ptr_sets[i]);
+	}
+	for (isize i = 0; i < t->table_counts[MapTraceTable_StringMap]; i++) {
+		if (string_maps[i].entries.allocator.proc != nullptr) string_map_destroy(&string_maps[i]);
+	}
+	gb_free(heap_allocator(), maps);
+	gb_free(heap_allocator(), ptr_sets);
+	gb_free(heap_allocator(), string_maps);
+	return found;
+}
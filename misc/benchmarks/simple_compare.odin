@@ -0,0 +1,78 @@
+// Benchmark of `==` on simple-compare records of different sizes
+//
+// 4096 keys are scanned 2000 times for the one equal to the last key. 16 and 32 byte records are
+// compared inline, 128 byte records with runtime.memory_equal_words, and 100 byte records (not a
+// multiple of the word size) with runtime.memory_equal. Each size is also scanned with an explicit
+// call to runtime.memory_equal, which is what `==` compiled to for every size before
+//
+//     odin run misc/benchmarks/simple_compare.odin
+package simple_compare_benchmark;
+
+import "core:fmt";
+import "core:mem";
+import "core:runtime";
+import "core:time";
+
+KEY_COUNT :: 4096;
+ROUNDS    :: 2000;
+
+Key16  :: struct { a, b: u64 };
+Key32  :: struct { a, b, c, d: u64 };
+Key100 :: struct { data: [100]u8 };
+Key128 :: struct { data: [16]u64 };
+
+scan_equal :: proc(keys: []$T, needle: T) -> (found: int) #no_bounds_check {
+	for _ in 0..<ROUNDS {
+		for _, i in keys {
+			if keys[i] == needle {
+				found += 1;
+			}
+		}
+	}
+	return;
+}
+
+// NOTE: The baseline, the call `==` compiled to for every size of simple-compare record
+scan_memory_equal :: proc(keys: []$T, needle: T) -> (found: int) #no_bounds_check {
+	n := needle;
+	for _ in 0..<ROUNDS {
+		for _, i in keys {
+			if runtime.memory_equal(&keys[i], &n, size_of(T)) {
+				found += 1;
+			}
+		}
+	}
+	return;
+}
+
+bench :: proc($T: typeid, name: string) {
+	keys := make([]T, KEY_COUNT);
+	defer delete(keys);
+
+	for key, i in &keys {
+		bytes := mem.ptr_to_bytes(&key);
+		for b, j in &bytes {
+			b = u8(i*31 + j*7);
+		}
+	}
+	needle := keys[KEY_COUNT-1];
+
+	start := time.tick_now();
+	found := scan_equal(keys, needle);
+	elapsed := time.tick_since(start);
+
+	start = time.tick_now();
+	baseline_found := scan_memory_equal(keys, needle);
+	baseline_elapsed := time.tick_since(start);
+
+	assert(found >= ROUNDS && found == baseline_found);
+	fmt.printf("%-6s %d bytes - == %.3f ms, runtime.memory_equal %.3f ms\n", name, size_of(T),
+	           time.duration_milliseconds(elapsed), time.duration_milliseconds(baseline_elapsed));
+}
+
+main :: proc() {
+	bench(Key16,  "Key16");
+	bench(Key32,  "Key32");
+	bench(Key100, "Key100");
+	bench(Key128, "Key128");
+}
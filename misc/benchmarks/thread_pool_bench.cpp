@@ -0,0 +1,73 @@
+// Micro-benchmark of ThreadPool (src/thread_pool.cpp) with tasks that add more tasks from inside the pool,
+// as the backend and checker do when they fan work out per module or per procedure
+//
+// Each of the 64 root tasks adds two children until the given depth is reached, so a depth of 12 runs
+// 64*(2^13 - 1) = 524224 tasks. Every task also does 200 iterations of dummy work.
+//
+// Build and run from the root of the repository:
+//     g++ -std=c++14 -O2 misc/benchmarks/thread_pool_bench.cpp -pthread -o thread_pool_bench
+//     ./thread_pool_bench [depth] [runs]
+
+#include "../../src/common.cpp"
+
+#define BENCH_ROOT_COUNT     64
+#define BENCH_WORK_PER_TASK 200
+
+gb_global ThreadPool         bench_pool;
+gb_global std::atomic<u64>   bench_sink;
+gb_global std::atomic<isize> bench_tasks_run;
+
+WORKER_TASK_PROC(bench_task) {
+	isize depth = cast(isize)cast(uintptr)data;
+
+	u64 x = cast(u64)depth;
+	for (isize i = 0; i < BENCH_WORK_PER_TASK; i++) {
+		x = x*6364136223846793005ull + 1442695040888963407ull;
+	}
+	bench_sink.fetch_add(x, std::memory_order_relaxed);
+	bench_tasks_run.fetch_add(1, std::memory_order_relaxed);
+
+	if (depth > 0) {
+		thread_pool_add_task(&bench_pool, bench_task, cast(void *)cast(uintptr)(depth-1));
+		thread_pool_add_task(&bench_pool, bench_task, cast(void *)cast(uintptr)(depth-1));
+	}
+	return 0;
+}
+
+f64 bench_run(isize thread_count, isize depth) {
+	thread_pool_init(&bench_pool, heap_allocator(), thread_count, "bench");
+	defer (thread_pool_destroy(&bench_pool));
+
+	bench_tasks_run = 0;
+	f64 start = gb_time_now();
+	for (isize i = 0; i < BENCH_ROOT_COUNT; i++) {
+		thread_pool_add_task(&bench_pool, bench_task, cast(void *)cast(uintptr)depth);
+	}
+	thread_pool_start(&bench_pool);
+	thread_pool_wait_to_process(&bench_pool);
+	f64 elapsed = gb_time_now() - start;
+
+	isize expected = BENCH_ROOT_COUNT * ((cast(isize)2 << depth) - 1);
+	GB_ASSERT_MSG(bench_tasks_run.load() == expected, "%td tasks run, expected %td", bench_tasks_run.load(), expected);
+	return elapsed;
+}
+
+int main(int argc, char **argv) {
+	isize depth = argc > 1 ? cast(isize)atoi(argv[1]) : 12;
+	isize runs  = argc > 2 ? cast(isize)atoi(argv[2]) : 5;
+	isize task_count = BENCH_ROOT_COUNT * ((cast(isize)2 << depth) - 1);
+
+	gb_printf("depth %td, %td tasks, best of %td runs\n", depth, task_count, runs);
+	isize thread_counts[] = {1, 4, 16, 64};
+	for (isize i = 0; i < gb_count_of(thread_counts); i++) {
+		f64 best = 0;
+		for (isize run = 0; run < runs; run++) {
+			f64 elapsed = bench_run(thread_counts[i], depth);
+			if (run == 0 || elapsed < best) {
+				best = elapsed;
+			}
+		}
+		gb_printf("%3td threads - %8.3f ms - %6.2fM tasks/s\n", thread_counts[i], 1000.0*best, cast(f64)task_count/best/1e6);
+	}
+	return 0;
+}
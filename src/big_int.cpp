@@ -35,7 +35,15 @@ void MP_FREE(void *mem, size_t size) {
 #define MAX_BIG_INT_SHIFT 1024
 #endif
 
-typedef mp_int BigInt;
+// NOTE: Almost every constant fits in 64 bits, so a BigInt keeps its value inline in `small` and
+// only falls back to a libtommath mp_int once a result no longer fits. The representation is
+// canonical: `big` is only set for values outside of [-(2^63-1), 2^63-1], which keeps I64_MIN out
+// of `small` so that negating a small value cannot overflow.
+// An mp_int is never modified once it has been assigned to a BigInt, so copies may share it.
+struct BigInt {
+	i64     small;
+	mp_int *big; // nullptr when the value is small
+};
 
 void big_int_from_u64(BigInt *dst, u64 x);
 void big_int_from_i64(BigInt *dst, i64 x);
@@ -43,7 +51,8 @@ void big_int_init    (BigInt *dst, BigInt const *src);
 void big_int_from_string(BigInt *dst, String const &s);
 
 void big_int_dealloc(BigInt *dst) {
-	mp_clear(dst);
+	dst->small = 0;
+	dst->big = nullptr;
 }
 
 BigInt big_int_make(BigInt const *b, bool abs=false);
@@ -123,33 +132,139 @@ void big_int_rem_eq(BigInt *dst, BigInt const *x) {
 }
 
 
+gb_inline bool big_int_fits_i64(BigInt const *x) {
+	return x->big == nullptr;
+}
+
+// NOTE: The digits come from the permanent arena, so these can only fail when out of memory
+void big_int_mp_init(mp_int *a) {
+	mp_err err = mp_init(a);
+	GB_ASSERT(err == MP_OKAY);
+}
+void big_int_mp_init_size(mp_int *a, int size) {
+	mp_err err = mp_init_size(a, size);
+	GB_ASSERT(err == MP_OKAY);
+}
+void big_int_mp_init_i64(mp_int *a, i64 x) {
+	mp_err err = mp_init_i64(a, x);
+	GB_ASSERT(err == MP_OKAY);
+}
+void big_int_mp_init_u64(mp_int *a, u64 x) {
+	mp_err err = mp_init_u64(a, x);
+	GB_ASSERT(err == MP_OKAY);
+}
+
+// Returns the mp_int form of `x`, building it in `tmp` if `x` is small
+mp_int const *big_int_to_mp(BigInt const *x, mp_int *tmp) {
+	if (x->big != nullptr) {
+		return x->big;
+	}
+	big_int_mp_init_size(tmp, 2);
+	mp_set_i64(tmp, x->small);
+	return tmp;
+}
+
+// Takes ownership of the digits of `src`
+void big_int_from_mp(BigInt *dst, mp_int *src) {
+	if (mp_count_bits(src) < 64) {
+		dst->small = mp_get_i64(src);
+		dst->big = nullptr;
+		mp_clear(src);
+		return;
+	}
+	mp_int *big = gb_alloc_item(permanent_allocator(), mp_int);
+	*big = *src;
+	dst->small = 0;
+	dst->big = big;
+}
+
+void big_int_set_small(BigInt *dst, i64 x) {
+	if (x == I64_MIN) {
+		mp_int r = {};
+		big_int_mp_init_i64(&r, x);
+		big_int_from_mp(dst, &r);
+		return;
+	}
+	dst->small = x;
+	dst->big = nullptr;
+}
+
+void big_int_mp_binary(BigInt *dst, BigInt const *x, BigInt const *y, mp_err (*op)(mp_int const *a, mp_int const *b, mp_int *c)) {
+	mp_int xt = {};
+	mp_int yt = {};
+	mp_int r = {};
+	big_int_mp_init(&r);
+	op(big_int_to_mp(x, &xt), big_int_to_mp(y, &yt), &r);
+	big_int_from_mp(dst, &r);
+}
+
+
+// NOTE: Both operands are small, so neither is I64_MIN
+bool big_int_add_overflow_i64(i64 x, i64 y, i64 *res) {
+	if ((y > 0 && x > I64_MAX - y) || (y < 0 && x < I64_MIN - y)) {
+		return true;
+	}
+	*res = x + y;
+	return false;
+}
+
+bool big_int_mul_overflow_i64(i64 x, i64 y, i64 *res) {
+#if defined(GB_COMPILER_MSVC)
+	if (gb_abs(x) > I32_MAX || gb_abs(y) > I32_MAX) {
+		return true;
+	}
+	*res = x * y;
+	return false;
+#else
+	return __builtin_mul_overflow(x, y, res);
+#endif
+}
+
 
 i64 big_int_sign(BigInt const *x) {
-	if (mp_iszero(x)) {
-		return 0;
+	if (x->big != nullptr) {
+		return x->big->sign == MP_ZPOS ? +1 : -1;
 	}
-	return x->sign == MP_ZPOS ? +1 : -1;
+	return x->small > 0 ? +1 : x->small < 0 ? -1 : 0;
 }
 
 
 void big_int_from_u64(BigInt *dst, u64 x) {
-	mp_init_u64(dst, x);
+	if (x <= cast(u64)I64_MAX) {
+		dst->small = cast(i64)x;
+		dst->big = nullptr;
+		return;
+	}
+	mp_int r = {};
+	big_int_mp_init_u64(&r, x);
+	big_int_from_mp(dst, &r);
 }
 void big_int_from_i64(BigInt *dst, i64 x) {
-	mp_init_i64(dst, x);
-
+	big_int_set_small(dst, x);
 }
 void big_int_init(BigInt *dst, BigInt const *src) {
 	if (dst == src) {
 		return;
 	}
-	mp_init_copy(dst, src);
+	*dst = *src;
+}
+
+void big_int_abs(BigInt *dst, BigInt const *x) {
+	if (x->big == nullptr) {
+		dst->small = gb_abs(x->small);
+		dst->big = nullptr;
+		return;
+	}
+	mp_int r = {};
+	big_int_mp_init(&r);
+	mp_abs(x->big, &r);
+	big_int_from_mp(dst, &r);
 }
 
 BigInt big_int_make(BigInt const *b, bool abs) {
 	BigInt i = {};
 	big_int_init(&i, b);
-	if (abs) mp_abs(&i, &i);
+	if (abs) big_int_abs(&i, &i);
 	return i;
 }
 BigInt big_int_make_abs(BigInt const *b) {
@@ -192,7 +307,7 @@ void big_int_from_string(BigInt *dst, String const &s) {
 
 	BigInt b = {};
 	big_int_from_u64(&b, base);
-	mp_zero(dst);
+	big_int_from_u64(dst, 0);
 
 	isize i = 0;
 	for (; i < len; i++) {
@@ -239,74 +354,160 @@ void big_int_from_string(BigInt *dst, String const &s) {
 
 
 u64 big_int_to_u64(BigInt const *x) {
-	GB_ASSERT(x->sign == 0);
-	return mp_get_u64(x);
+	GB_ASSERT(!big_int_is_neg(x));
+	if (x->big == nullptr) {
+		return cast(u64)x->small;
+	}
+	return mp_get_u64(x->big);
 }
 
 i64 big_int_to_i64(BigInt const *x) {
-	return mp_get_i64(x);
+	if (x->big == nullptr) {
+		return x->small;
+	}
+	return mp_get_i64(x->big);
 }
 
 f64 big_int_to_f64(BigInt const *x) {
-	return mp_get_double(x);
+	if (x->big == nullptr) {
+		return cast(f64)x->small;
+	}
+	return mp_get_double(x->big);
+}
+
+// Writes the magnitude of `x` to `rop` as little endian bytes and returns the number of bytes it needs
+size_t big_int_pack_magnitude(BigInt const *x, u8 *rop, size_t rop_size) {
+	if (x->big == nullptr) {
+		u64 v = cast(u64)gb_abs(x->small);
+		size_t count = 0;
+		for (size_t i = 0; v != 0; i++) {
+			if (i < rop_size) {
+				rop[i] = cast(u8)v;
+			}
+			v >>= 8;
+			count = i+1;
+		}
+		return count;
+	}
+	size_t max_count = mp_pack_count(x->big, 0, 1);
+	if (max_count <= rop_size) {
+		size_t written = 0;
+		mp_err err = mp_pack(rop, rop_size, &written, MP_LSB_FIRST, 1, MP_LITTLE_ENDIAN, 0, x->big);
+		GB_ASSERT(err == MP_OKAY);
+	}
+	return max_count;
 }
 
 
 void big_int_neg(BigInt *dst, BigInt const *x) {
-	mp_neg(x, dst);
+	if (x->big == nullptr) {
+		dst->small = -x->small;
+		dst->big = nullptr;
+		return;
+	}
+	mp_int r = {};
+	big_int_mp_init(&r);
+	mp_neg(x->big, &r);
+	big_int_from_mp(dst, &r);
 }
 
 
 int big_int_cmp(BigInt const *x, BigInt const *y) {
-	return mp_cmp(x, y);
+	if (x->big == nullptr && y->big == nullptr) {
+		return x->small < y->small ? -1 : x->small > y->small ? +1 : 0;
+	}
+	mp_int xt = {};
+	mp_int yt = {};
+	return mp_cmp(big_int_to_mp(x, &xt), big_int_to_mp(y, &yt));
 }
 
 int big_int_cmp_zero(BigInt const *x) {
-	if (mp_iszero(x)) {
-		return 0;
-	}
-	return x->sign ? -1 : +1;
+	return cast(int)big_int_sign(x);
 }
 
 bool big_int_is_zero(BigInt const *x) {
-	return mp_iszero(x);
+	return x->big == nullptr && x->small == 0;
 }
 
 
 
 
 void big_int_add(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_add(x, y, dst);
+	i64 res = 0;
+	if (x->big == nullptr && y->big == nullptr && !big_int_add_overflow_i64(x->small, y->small, &res)) {
+		big_int_set_small(dst, res);
+		return;
+	}
+	big_int_mp_binary(dst, x, y, mp_add);
 }
 
 
 void big_int_sub(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_sub(x, y, dst);
+	i64 res = 0;
+	if (x->big == nullptr && y->big == nullptr && !big_int_add_overflow_i64(x->small, -y->small, &res)) {
+		big_int_set_small(dst, res);
+		return;
+	}
+	big_int_mp_binary(dst, x, y, mp_sub);
 }
 
 
+u32 big_int_shift_amount(BigInt const *y) {
+	if (y->big == nullptr) {
+		return cast(u32)y->small;
+	}
+	return mp_get_u32(y->big);
+}
+
 void big_int_shl(BigInt *dst, BigInt const *x, BigInt const *y) {
-	u32 yy = mp_get_u32(y);
-	mp_mul_2d(x, yy, dst);
+	u32 yy = big_int_shift_amount(y);
+	if (x->big == nullptr && yy < 63) {
+		i64 limit = I64_MAX >> yy;
+		if (-limit <= x->small && x->small <= limit) {
+			big_int_set_small(dst, x->small * (cast(i64)1 << yy));
+			return;
+		}
+	}
+	mp_int xt = {};
+	mp_int r = {};
+	big_int_mp_init(&r);
+	mp_mul_2d(big_int_to_mp(x, &xt), yy, &r);
+	big_int_from_mp(dst, &r);
 }
 
 void big_int_shr(BigInt *dst, BigInt const *x, BigInt const *y) {
-	u32 yy = mp_get_u32(y);
-	BigInt d = {};
-	mp_div_2d(x, yy, dst, &d);
-	big_int_dealloc(&d);
+	u32 yy = big_int_shift_amount(y);
+	if (x->big == nullptr) {
+		// NOTE: Rounds towards zero to match mp_div_2d
+		i64 v = 0;
+		if (yy < 63) {
+			v = x->small >= 0 ? (x->small >> yy) : -((-x->small) >> yy);
+		}
+		dst->small = v;
+		dst->big = nullptr;
+		return;
+	}
+	mp_int r = {};
+	mp_int d = {};
+	big_int_mp_init(&r);
+	big_int_mp_init(&d);
+	mp_div_2d(x->big, yy, &r, &d);
+	big_int_from_mp(dst, &r);
 }
 
 void big_int_mul_u64(BigInt *dst, BigInt const *x, u64 y) {
-	BigInt d = {};
-	big_int_from_u64(&d, y);
-	mp_mul(x, &d, dst);
-	big_int_dealloc(&d);
+	BigInt d = big_int_make_u64(y);
+	big_int_mul(dst, x, &d);
 }
 
 
 void big_int_mul(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_mul(x, y, dst);
+	i64 res = 0;
+	if (x->big == nullptr && y->big == nullptr && !big_int_mul_overflow_i64(x->small, y->small, &res)) {
+		big_int_set_small(dst, res);
+		return;
+	}
+	big_int_mp_binary(dst, x, y, mp_mul);
 }
 
 
@@ -336,7 +537,6 @@ u64 leading_zeros_u64(u64 x) {
 #endif
 }
 
-
 // `big_int_quo_rem` sets z to the quotient x/y and r to the remainder x%y
 // and returns the pair (z, r) for y != 0.
 // if y == 0, a division-by-zero run-time panic occurs.
@@ -344,112 +544,95 @@ u64 leading_zeros_u64(u64 x) {
 // q = x/y with the result truncated to zero
 // r = x - y*q
 void big_int_quo_rem(BigInt const *x, BigInt const *y, BigInt *q_, BigInt *r_) {
-	mp_div(x, y, q_, r_);
+	if (x->big == nullptr && y->big == nullptr) {
+		i64 q = 0;
+		i64 r = 0;
+		if (y->small != 0) {
+			q = x->small / y->small;
+			r = x->small % y->small;
+		}
+		if (q_) big_int_set_small(q_, q);
+		if (r_) big_int_set_small(r_, r);
+		return;
+	}
+
+	mp_int xt = {};
+	mp_int yt = {};
+	mp_int q = {};
+	mp_int r = {};
+	big_int_mp_init(&q);
+	big_int_mp_init(&r);
+	mp_div(big_int_to_mp(x, &xt), big_int_to_mp(y, &yt), &q, &r);
+	if (q_) big_int_from_mp(q_, &q);
+	if (r_) big_int_from_mp(r_, &r);
 }
 
 void big_int_quo(BigInt *z, BigInt const *x, BigInt const *y) {
-	BigInt r = {};
-	big_int_quo_rem(x, y, z, &r);
-	big_int_dealloc(&r);
+	big_int_quo_rem(x, y, z, nullptr);
 }
 
 void big_int_rem(BigInt *z, BigInt const *x, BigInt const *y) {
-	BigInt q = {};
-	big_int_quo_rem(x, y, &q, z);
-	big_int_dealloc(&q);
+	big_int_quo_rem(x, y, nullptr, z);
 }
 
 void big_int_euclidean_mod(BigInt *z, BigInt const *x, BigInt const *y) {
-	BigInt y0 = {};
-	big_int_init(&y0, y);
-
-	BigInt q = {};
-	big_int_quo_rem(x, y, &q, z);
-	if (z->sign) {
-		if (y0.sign) {
-			big_int_sub(z, z, &y0);
-		} else {
-			big_int_add(z, z, &y0);
-		}
-	}
-}
+	BigInt y0 = big_int_make_abs(y);
 
-
-
-void big_int_and(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_and(x, y, dst);
-}
-
-void big_int_and_not(BigInt *dst, BigInt const *x, BigInt const *y) {
-	if (mp_iszero(x)) {
-		big_int_init(dst, y);
-		return;
-	}
-	if (mp_iszero(y)) {
-		big_int_init(dst, x);
-		return;
+	big_int_rem(z, x, y);
+	if (big_int_is_neg(z)) {
+		big_int_add(z, z, &y0);
 	}
+}
 
-	if (x->sign == y->sign) {
-		if (x->sign) {
-			// (-x) &~ (-y) == ~(x-1) &~ ~(y-1) == ~(x-1) & (y-1) == (y-1) &~ (x-1)
-			BigInt x1 = big_int_make_abs(x);
-			BigInt y1 = big_int_make_abs(y);
-			mp_decr(&x1);
-			mp_decr(&y1);
 
-			BigInt ny1 = {};
-			mp_complement(&y1, &ny1);
-			mp_and(&x1, &ny1, dst);
 
-			big_int_dealloc(&x1);
-			big_int_dealloc(&y1);
-			big_int_dealloc(&ny1);
-			return;
-		}
-
-		BigInt ny = {};
-		mp_complement(y, &ny);
-		mp_and(x, &ny, dst);
+mp_err big_int_mp_and(mp_int const *a, mp_int const *b, mp_int *c) { return mp_and(a, b, c); }
+mp_err big_int_mp_or (mp_int const *a, mp_int const *b, mp_int *c) { return mp_or(a, b, c);  }
+mp_err big_int_mp_xor(mp_int const *a, mp_int const *b, mp_int *c) { return mp_xor(a, b, c); }
 
-		big_int_dealloc(&ny);
+// NOTE: libtommath treats negative operands as two's complement for the bitwise operations,
+// which is the same as doing it directly on an i64
+void big_int_and(BigInt *dst, BigInt const *x, BigInt const *y) {
+	if (x->big == nullptr && y->big == nullptr) {
+		big_int_set_small(dst, x->small & y->small);
 		return;
 	}
+	big_int_mp_binary(dst, x, y, big_int_mp_and);
+}
 
-	if (x->sign) {
-		// (-x) &~ y == ~(x-1) &~ y == ~(x-1) & ~y == ~((x-1) | y) == -(((x-1) | y) + 1)
-		BigInt x1 = big_int_make_abs(x);
-		BigInt y1 = big_int_make_abs(y);
-		mp_decr(&x1);
-
-		BigInt z1 = {};
-		big_int_or(&z1, &x1, &y1);
-		mp_add_d(&z1, 1, dst);
-
-		big_int_dealloc(&x1);
-		big_int_dealloc(&y1);
-		big_int_dealloc(&z1);
+void big_int_and_not(BigInt *dst, BigInt const *x, BigInt const *y) {
+	if (x->big == nullptr && y->big == nullptr) {
+		big_int_set_small(dst, x->small & ~y->small);
 		return;
 	}
 
-	// x &~ (-y) == x &~ ~(y-1) == x & (y-1)
-	BigInt x1 = big_int_make_abs(x);
-	BigInt y1 = big_int_make_abs(y);
-	mp_decr(&y1);
-	big_int_and(dst, &x1, &y1);
-
-	big_int_dealloc(&x1);
-	big_int_dealloc(&y1);
-	return;
+	// x &~ y == x & (-y - 1)
+	mp_int xt = {};
+	mp_int yt = {};
+	mp_int ny = {};
+	mp_int r = {};
+	big_int_mp_init(&ny);
+	big_int_mp_init(&r);
+	mp_complement(big_int_to_mp(y, &yt), &ny);
+	mp_and(big_int_to_mp(x, &xt), &ny, &r);
+	big_int_from_mp(dst, &r);
 }
 
 void big_int_xor(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_xor(x, y, dst);
+	if (x->big == nullptr && y->big == nullptr) {
+		big_int_set_small(dst, x->small ^ y->small);
+		return;
+	}
+	big_int_mp_binary(dst, x, y, big_int_mp_xor);
 }
 
 
 void big_int_or(BigInt *dst, BigInt const *x, BigInt const *y) {
-	mp_or(x, y, dst);
+	if (x->big == nullptr && y->big == nullptr) {
+		big_int_set_small(dst, x->small | y->small);
+		return;
+	}
+	big_int_mp_binary(dst, x, y, big_int_mp_or);
 }
 
 void debug_print_big_int(BigInt const *x) {
@@ -464,53 +647,70 @@ void big_int_not(BigInt *dst, BigInt const *x, i32 bit_count, bool is_signed) {
 		big_int_from_u64(dst, 0);
 		return;
 	}
-	if (big_int_is_neg(x)) {
-		// ~x == -x - 1
-		big_int_neg(dst, x);
-		mp_decr(dst);
-		mp_mod_2d(dst, bit_count, dst);
+	if (x->big == nullptr && bit_count < 63) {
+		i64 mask = (cast(i64)1 << bit_count) - 1;
+		i64 v = ~x->small & mask;
+		if (is_signed && x->small >= 0) {
+			i64 pmask = cast(i64)1 << (bit_count-1);
+			v = (v & (pmask-1)) - (v & pmask);
+		}
+		big_int_set_small(dst, v);
 		return;
 	}
 
+	mp_int xt = {};
+	mp_int const *xm = big_int_to_mp(x, &xt);
+	mp_int r = {};
+	big_int_mp_init(&r);
 
-	BigInt pow2b = {};
-	mp_2expt(&pow2b, bit_count);
+	if (mp_isneg(xm)) {
+		// ~x == -x - 1
+		mp_neg(xm, &r);
+		mp_decr(&r);
+		mp_mod_2d(&r, bit_count, &r);
+		big_int_from_mp(dst, &r);
+		return;
+	}
 
-	BigInt mask = {};
+	mp_int mask = {};
+	big_int_mp_init(&mask);
 	mp_2expt(&mask, bit_count);
 	mp_decr(&mask);
 
-	BigInt v = {};
-	mp_init_copy(&v, x);
-	mp_mod_2d(&v, bit_count, &v);
+	mp_int v = {};
+	big_int_mp_init(&v);
+	mp_mod_2d(xm, bit_count, &v);
 
-	mp_xor(&v, &mask, dst);
+	mp_xor(&v, &mask, &r);
 
 	if (is_signed) {
-		BigInt pmask = {};
-		BigInt pmask_minus_one = {};
+		mp_int pmask = {};
+		mp_int pmask_minus_one = {};
+		big_int_mp_init(&pmask);
+		big_int_mp_init(&pmask_minus_one);
 		mp_2expt(&pmask, bit_count-1);
 		mp_sub_d(&pmask, 1, &pmask_minus_one);
 
-		BigInt a = {};
-		BigInt b = {};
-		big_int_and(&a, dst, &pmask_minus_one);
-		big_int_and(&b, dst, &pmask);
-		big_int_sub(dst, &a, &b);
-		big_int_dealloc(&a);
-		big_int_dealloc(&b);
+		mp_int a = {};
+		mp_int b = {};
+		big_int_mp_init(&a);
+		big_int_mp_init(&b);
+		mp_and(&r, &pmask_minus_one, &a);
+		mp_and(&r, &pmask, &b);
+		mp_sub(&a, &b, &r);
 	}
 
-	big_int_dealloc(&pow2b);
-	big_int_dealloc(&mask);
-	big_int_dealloc(&v);
+	big_int_from_mp(dst, &r);
 }
 
 bool big_int_is_neg(BigInt const *x) {
 	if (x == nullptr) {
 		return false;
 	}
-	return x->sign != MP_ZPOS;
+	if (x->big != nullptr) {
+		return x->big->sign != MP_ZPOS;
+	}
+	return x->small < 0;
 }
 
 
@@ -527,7 +727,7 @@ char digit_to_char(u8 digit) {
 String big_int_to_string(gbAllocator allocator, BigInt const *x, u64 base) {
 	GB_ASSERT(base <= 16);
 
-	if (mp_iszero(x)) {
+	if (big_int_is_zero(x)) {
 		u8 *buf = gb_alloc_array(allocator, u8, 1);
 		buf[0] = '0';
 		return make_string(buf, 1);
@@ -536,34 +736,38 @@ String big_int_to_string(gbAllocator allocator, BigInt const *x, u64 base) {
 	Array<char> buf = {};
 	array_init(&buf, allocator, 0, 32);
 
-	BigInt v = {};
-	mp_init_copy(&v, x);
-
-	if (v.sign) {
+	if (big_int_is_neg(x)) {
 		array_add(&buf, '-');
-		mp_abs(&v, &v);
 	}
 
 	isize first_word_idx = buf.count;
 
-	BigInt r = {};
-	BigInt b = {};
-	big_int_from_u64(&b, base);
+	if (x->big == nullptr) {
+		u64 v = cast(u64)gb_abs(x->small);
+		while (v >= base) {
+			array_add(&buf, digit_to_char(cast(u8)(v % base)));
+			v /= base;
+		}
+		array_add(&buf, digit_to_char(cast(u8)v));
+	} else {
+		BigInt v = big_int_make_abs(x);
+
+		BigInt r = {};
+		BigInt b = {};
+		big_int_from_u64(&b, base);
 
-	u8 digit = 0;
-	while (big_int_cmp(&v, &b) >= 0) {
-		big_int_quo_rem(&v, &b, &v, &r);
+		u8 digit = 0;
+		while (big_int_cmp(&v, &b) >= 0) {
+			big_int_quo_rem(&v, &b, &v, &r);
+			digit = cast(u8)big_int_to_u64(&r);
+			array_add(&buf, digit_to_char(digit));
+		}
+
+		big_int_rem(&r, &v, &b);
 		digit = cast(u8)big_int_to_u64(&r);
 		array_add(&buf, digit_to_char(digit));
 	}
 
-	big_int_rem(&r, &v, &b);
-	digit = cast(u8)big_int_to_u64(&r);
-	array_add(&buf, digit_to_char(digit));
-
-	big_int_dealloc(&r);
-	big_int_dealloc(&b);
-
 	for (isize i = first_word_idx; i < buf.count/2; i++) {
 		isize j = buf.count + first_word_idx - i - 1;
 		char tmp = buf[i];
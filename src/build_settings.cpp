@@ -186,6 +186,7 @@ struct BuildContext {
 	bool   show_unused;
 	bool   show_unused_with_location;
 	bool   show_more_timings;
+	String export_timings_file;
 	bool   show_system_calls;
 	bool   keep_temp_files;
 	bool   ignore_unknown_attributes;
@@ -215,6 +216,9 @@ struct BuildContext {
 	bool   linker_map_file;
 
 	bool use_separate_modules;
+	String object_cache_dir;
+	String compile_server_socket;
+	String checked_cache_dir;
 	bool threaded_checker;
 
 	bool show_debug_messages;
@@ -1122,6 +1122,11 @@ void check_entity_decl(CheckerContext *ctx, Entity *e, DeclInfo *d, Type *named_
 	}
 	if (e->flags & EntityFlag_Lazy) {
 		mutex_lock(&ctx->info->lazy_mutex);
+		// NOTE: Another thread may have checked it whilst this one was waiting for the lock
+		if (e->state == EntityState_Resolved) {
+			mutex_unlock(&ctx->info->lazy_mutex);
+			return;
+		}
 	}
 
 	String name = e->token.string;
@@ -1323,7 +1328,7 @@ void check_proc_body(CheckerContext *ctx_, Token token, DeclInfo *decl, Type *ty
 		if (ps->flags & (ScopeFlag_File & ScopeFlag_Pkg & ScopeFlag_Global)) {
 			return;
 		} else {
-			mutex_lock(&ctx->info->deps_mutex);
+			checker_lock_stripe_pair(&ctx->info->deps_locks, decl, decl->parent);
 
 			// NOTE(bill): Add the dependencies from the procedure literal (lambda)
 			// But only at the procedure level
@@ -1336,7 +1341,7 @@ void check_proc_body(CheckerContext *ctx_, Token token, DeclInfo *decl, Type *ty
 				ptr_set_add(&decl->parent->type_info_deps, t);
 			}
 
-			mutex_unlock(&ctx->info->deps_mutex);
+			checker_unlock_stripe_pair(&ctx->info->deps_locks, decl, decl->parent);
 		}
 	}
 }
@@ -212,6 +212,30 @@ isize check_is_assignable_to_using_subtype(Type *src, Type *dst, isize level = 0
 	return 0;
 }
 
+u64 gen_proc_index_hash(Entity *base_entity, Type *proc_type) {
+	return hash_combine_u64(cast(u64)cast(uintptr)base_entity->identifier.load(), type_hash_identity(proc_type));
+}
+
+// NOTE: The stripe's mutex must be held
+Entity *find_generated_procedure_in_stripe(GenEntityIndexStripe *stripe, u64 hash, Entity *base_entity, Type *proc_type) {
+	HashKey key = hash_integer(hash);
+	for (auto *entry = multi_map_find_first(&stripe->map, key); entry != nullptr; entry = multi_map_find_next(&stripe->map, entry)) {
+		Entity *other = entry->value.entity;
+		if (entry->value.base == base_entity->identifier.load() && are_types_identical(base_type(other->type), proc_type)) {
+			return other;
+		}
+	}
+	return nullptr;
+}
+
+Entity *find_generated_procedure(CheckerInfo *info, Entity *base_entity, Type *proc_type) {
+	u64 hash = gen_proc_index_hash(base_entity, proc_type);
+	GenEntityIndexStripe *stripe = gen_entity_index_stripe(&info->gen_procs_index, hash);
+	mutex_lock(&stripe->mutex);
+	defer (mutex_unlock(&stripe->mutex));
+	return find_generated_procedure_in_stripe(stripe, hash, base_entity, proc_type);
+}
+
 bool find_or_generate_polymorphic_procedure(CheckerContext *c, Entity *base_entity, Type *type,
                                             Array<Operand> *param_operands, Ast *poly_def_node, PolyProcData *poly_proc_data) {
 	///////////////////////////////////////////////////////////////////////////////
@@ -245,9 +269,6 @@ bool find_or_generate_polymorphic_procedure(CheckerContext *c, Entity *base_enti
 		GB_ASSERT(dst == nullptr);
 	}
 
-	mutex_lock(&info->gen_procs_mutex);
-	defer (mutex_unlock(&info->gen_procs_mutex));
-
 	if (!src->Proc.is_polymorphic || src->Proc.is_poly_specialized) {
 		return false;
 	}
@@ -311,25 +332,18 @@ bool find_or_generate_polymorphic_procedure(CheckerContext *c, Entity *base_enti
 	// NOTE(bill): This is slightly memory leaking if the type already exists
 	// Maybe it's better to check with the previous types first?
 	Type *final_proc_type = alloc_type_proc(scope, nullptr, 0, nullptr, 0, false, pt->calling_convention);
-	bool success = check_procedure_type(&nctx, final_proc_type, pt->node, &operands);
+	// NOTE: Other threads may be generating from the same base at the same time, so never check its own type node
+	bool success = check_procedure_type(&nctx, final_proc_type, clone_ast(pt->node), &operands);
 
 	if (!success) {
 		return false;
 	}
 
-	auto *found_gen_procs = map_get(&info->gen_procs, hash_pointer(base_entity->identifier));
-	if (found_gen_procs) {
-		auto procs = *found_gen_procs;
-		for_array(i, procs) {
-			Entity *other = procs[i];
-			Type *pt = base_type(other->type);
-			if (are_types_identical(pt, final_proc_type)) {
-				if (poly_proc_data) {
-					poly_proc_data->gen_entity = other;
-				}
-				return true;
-			}
+	if (Entity *other = find_generated_procedure(info, base_entity, final_proc_type)) {
+		if (poly_proc_data) {
+			poly_proc_data->gen_entity = other;
 		}
+		return true;
 	}
 
 #if 0
@@ -354,18 +368,11 @@ bool find_or_generate_polymorphic_procedure(CheckerContext *c, Entity *base_enti
 			return false;
 		}
 
-		if (found_gen_procs) {
-			auto procs = *found_gen_procs;
-			for_array(i, procs) {
-				Entity *other = procs[i];
-				Type *pt = base_type(other->type);
-				if (are_types_identical(pt, final_proc_type)) {
-					if (poly_proc_data) {
-						poly_proc_data->gen_entity = other;
-					}
-					return true;
-				}
+		if (Entity *other = find_generated_procedure(info, base_entity, final_proc_type)) {
+			if (poly_proc_data) {
+				poly_proc_data->gen_entity = other;
 			}
+			return true;
 		}
 	}
 
@@ -399,11 +406,30 @@ bool find_or_generate_polymorphic_procedure(CheckerContext *c, Entity *base_enti
 	Entity *entity = alloc_entity_procedure(nullptr, token, final_proc_type, tags);
 	entity->identifier = ident;
 
-	add_entity_and_decl_info(&nctx, ident, entity, d);
-	// NOTE(bill): Set the scope afterwards as this is not real overloading
-	entity->scope = scope->parent;
-	entity->file = base_entity->file;
-	entity->pkg = base_entity->pkg;
+	{
+		// NOTE: Another thread may have generated the same procedure whilst this one was checking its type,
+		// so look again and publish under the same lock. The entity must be complete before it is visible
+		u64 hash = gen_proc_index_hash(base_entity, final_proc_type);
+		GenEntityIndexStripe *stripe = gen_entity_index_stripe(&info->gen_procs_index, hash);
+		mutex_lock(&stripe->mutex);
+		defer (mutex_unlock(&stripe->mutex));
+
+		if (Entity *other = find_generated_procedure_in_stripe(stripe, hash, base_entity, final_proc_type)) {
+			if (poly_proc_data) {
+				poly_proc_data->gen_entity = other;
+			}
+			return true;
+		}
+
+		add_entity_and_decl_info(&nctx, ident, entity, d);
+		// NOTE(bill): Set the scope afterwards as this is not real overloading
+		entity->scope = scope->parent;
+		entity->file = base_entity->file;
+		entity->pkg = base_entity->pkg;
+
+		GenEntityIndexEntry entry = {base_entity->identifier.load(), entity, nullptr};
+		multi_map_insert(&stripe->map, hash_integer(hash), entry);
+	}
 
 	AstFile *file = nullptr;
 	{
@@ -424,6 +450,8 @@ bool find_or_generate_polymorphic_procedure(CheckerContext *c, Entity *base_enti
 	proc_info->generated_from_polymorphic = true;
 	proc_info->poly_def_node = poly_def_node;
 
+	mutex_lock(&info->gen_procs_mutex);
+	auto *found_gen_procs = map_get(&info->gen_procs, hash_pointer(base_entity->identifier));
 	if (found_gen_procs) {
 		array_add(found_gen_procs, entity);
 	} else {
@@ -431,6 +459,7 @@ bool find_or_generate_polymorphic_procedure(CheckerContext *c, Entity *base_enti
 		array_add(&array, entity);
 		map_set(&info->gen_procs, hash_pointer(base_entity->identifier), array);
 	}
+	mutex_unlock(&info->gen_procs_mutex);
 
 	GB_ASSERT(entity != nullptr);
 
@@ -1564,14 +1593,16 @@ bool check_representable_as_constant(CheckerContext *c, ExactValue in_value, Typ
 			big_int_from_i64(&bi128, 128);
 			big_int_from_i64(&bi127, 127);
 
+			BigInt one = big_int_make_u64(1);
+
 			big_int_shl_eq(&umax, &bi128);
-			mp_decr(&umax);
+			big_int_sub_eq(&umax, &one);
 
 			big_int_shl_eq(&imin, &bi127);
 			big_int_neg(&imin, &imin);
 
 			big_int_shl_eq(&imax, &bi127);
-			mp_decr(&imax);
+			big_int_sub_eq(&imax, &one);
 		}
 
 		switch (type->Basic.kind) {
@@ -1617,7 +1648,7 @@ bool check_representable_as_constant(CheckerContext *c, ExactValue in_value, Typ
 			{
 				// return 0ull <= i && i <= umax;
 				int b = big_int_cmp(&i, &umax);
-				return !i.sign && (b <= 0);
+				return !big_int_is_neg(&i) && (b <= 0);
 			}
 
 		case Basic_UntypedInteger:
@@ -3411,7 +3442,7 @@ bool check_index_value(CheckerContext *c, Type *main_type, bool open_range, Ast
 	if (operand.mode == Addressing_Constant &&
 	    (c->state_flags & StateFlag_no_bounds_check) == 0) {
 		BigInt i = exact_value_to_integer(operand.value).value_integer;
-		if (i.sign && !is_type_enum(index_type) && !is_type_multi_pointer(main_type)) {
+		if (big_int_is_neg(&i) && !is_type_enum(index_type) && !is_type_multi_pointer(main_type)) {
 			gbString expr_str = expr_to_string(operand.expr);
 			error(operand.expr, "Index '%s' cannot be a negative value", expr_str);
 			gb_string_free(expr_str);
@@ -3457,7 +3488,7 @@ bool check_index_value(CheckerContext *c, Type *main_type, bool open_range, Ast
 
 			} else { // NOTE(bill): Do array bound checking
 				i64 v = -1;
-				if (i.used <= 1) {
+				if (big_int_fits_i64(&i)) {
 					v = big_int_to_i64(&i);
 				}
 				if (value) *value = v;
@@ -3837,6 +3868,10 @@ Entity *check_selector(CheckerContext *c, Operand *operand, Ast *node, Type *typ
 			}
 
 			check_entity_decl(c, entity, nullptr, nullptr);
+			if (entity->kind == Entity_Builtin && !allow_builtin) {
+				// NOTE: A lazily checked alias of a builtin procedure only becomes one once it has been checked
+				allow_builtin = entity->scope == import_scope || entity->scope != builtin_pkg->scope;
+			}
 			if (entity->kind == Entity_ProcGroup) {
 				operand->mode = Addressing_ProcGroup;
 				operand->proc_group = entity;
@@ -4211,22 +4246,20 @@ bool check_identifier_exists(Scope *s, Ast *node, bool nested = false, Scope **o
 
 isize add_dependencies_from_unpacking(CheckerContext *c, Entity **lhs, isize lhs_count, isize tuple_index, isize tuple_count) {
 	if (lhs != nullptr && c->decl != nullptr) {
-		mutex_lock(&c->info->deps_mutex);
-
 		for (isize j = 0; (tuple_index + j) < lhs_count && j < tuple_count; j++) {
 			Entity *e = lhs[tuple_index + j];
 			if (e != nullptr) {
 				DeclInfo *decl = decl_info_of_entity(e);
 				if (decl != nullptr) {
+					checker_lock_stripe_pair(&c->info->deps_locks, c->decl, decl);
 					for_array(k, decl->deps.entries) {
 						Entity *dep = decl->deps.entries[k].ptr;
 						ptr_set_add(&c->decl->deps, dep);
 					}
+					checker_unlock_stripe_pair(&c->info->deps_locks, c->decl, decl);
 				}
 			}
 		}
-
-		mutex_unlock(&c->info->deps_mutex);
 	}
 	return tuple_count;
 }
@@ -5016,6 +5049,110 @@ bool evaluate_where_clauses(CheckerContext *ctx, Ast *call_expr, Scope *scope, S
 }
 
 
+bool proc_group_cache_can_memoize(Array<Entity *> const &procs, Array<Operand> const &operands) {
+	for_array(i, procs) {
+		Type *pt = base_type(procs[i]->type);
+		if (pt == nullptr || is_type_polymorphic(pt)) {
+			return false;
+		}
+	}
+	for_array(i, operands) {
+		Operand const &o = operands[i];
+		if (o.mode == Addressing_Invalid || o.type == nullptr) {
+			return false;
+		}
+		if (o.mode == Addressing_Constant) {
+			switch (o.value.kind) {
+			case ExactValue_Invalid:
+			case ExactValue_Bool:
+			case ExactValue_String:
+			case ExactValue_Integer:
+			case ExactValue_Float:
+				break;
+			default:
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+u64 proc_group_cache_hash(Entity *proc_group, Array<Operand> const &operands, bool variadic_expand) {
+	u64 hash = hash_combine_u64(cast(u64)cast(uintptr)proc_group, cast(u64)variadic_expand);
+	for_array(i, operands) {
+		Operand const &o = operands[i];
+		hash = hash_combine_u64(hash, cast(u64)o.mode);
+		hash = hash_combine_u64(hash, type_hash_identity(o.type));
+		if (o.mode == Addressing_Constant) {
+			hash = hash_combine_u64(hash, hash_exact_value_identity(o.value));
+		}
+	}
+	return hash;
+}
+
+bool proc_group_cache_entry_matches(ProcGroupCacheEntry const &entry, Entity *proc_group, Array<Operand> const &operands, bool variadic_expand) {
+	if (entry.proc_group != proc_group || entry.variadic_expand != variadic_expand || entry.args.count != operands.count) {
+		return false;
+	}
+	for_array(i, operands) {
+		ProcGroupCacheArg const &arg = entry.args[i];
+		Operand const &o = operands[i];
+		if (arg.mode != o.mode || !are_types_identical(arg.type, o.type)) {
+			return false;
+		}
+		if (o.mode == Addressing_Constant) {
+			// NOTE: Whether an untyped constant fits a parameter depends upon its value
+			if (arg.value.kind != o.value.kind) {
+				return false;
+			}
+			if (o.value.kind != ExactValue_Invalid && !compare_exact_values(Token_CmpEq, arg.value, o.value)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// NOTE: Returns the index of the candidate which the same arguments resolved to before, or -1
+isize proc_group_cache_find(CheckerInfo *info, u64 hash, Entity *proc_group, Array<Operand> const &operands, bool variadic_expand) {
+	ProcGroupCacheStripe *stripe = proc_group_cache_stripe(&info->proc_group_cache, hash);
+	mutex_lock(&stripe->mutex);
+	defer (mutex_unlock(&stripe->mutex));
+
+	HashKey key = hash_integer(hash);
+	for (auto *entry = multi_map_find_first(&stripe->map, key); entry != nullptr; entry = multi_map_find_next(&stripe->map, entry)) {
+		if (proc_group_cache_entry_matches(entry->value, proc_group, operands, variadic_expand)) {
+			return entry->value.index;
+		}
+	}
+	return -1;
+}
+
+void proc_group_cache_add(CheckerInfo *info, u64 hash, Entity *proc_group, Array<Operand> const &operands, bool variadic_expand, isize index) {
+	ProcGroupCacheEntry entry = {};
+	entry.proc_group      = proc_group;
+	entry.args            = slice_make<ProcGroupCacheArg>(permanent_allocator(), operands.count);
+	entry.variadic_expand = variadic_expand;
+	entry.index           = index;
+	for_array(i, operands) {
+		entry.args[i].mode  = operands[i].mode;
+		entry.args[i].type  = operands[i].type;
+		entry.args[i].value = operands[i].value;
+	}
+
+	ProcGroupCacheStripe *stripe = proc_group_cache_stripe(&info->proc_group_cache, hash);
+	mutex_lock(&stripe->mutex);
+	defer (mutex_unlock(&stripe->mutex));
+
+	HashKey key = hash_integer(hash);
+	for (auto *found = multi_map_find_first(&stripe->map, key); found != nullptr; found = multi_map_find_next(&stripe->map, found)) {
+		if (proc_group_cache_entry_matches(found->value, proc_group, operands, variadic_expand)) {
+			return; // NOTE: Another thread resolved the same call first
+		}
+	}
+	multi_map_insert(&stripe->map, key, entry);
+}
+
 CallArgumentData check_call_arguments(CheckerContext *c, Operand *operand, Type *proc_type, Ast *call, Slice<Ast *> const &args) {
 	ast_node(ce, CallExpr, call);
 
@@ -5254,46 +5391,63 @@ CallArgumentData check_call_arguments(CheckerContext *c, Operand *operand, Type
 		gbString expr_name = expr_to_string(operand->expr);
 		defer (gb_string_free(expr_name));
 
-		for_array(i, procs) {
-			Entity *p = procs[i];
-			Type *pt = base_type(p->type);
-			if (pt != nullptr && is_type_proc(pt)) {
-				CallArgumentError err = CallArgumentError_None;
-				CallArgumentData data = {};
-				CheckerContext ctx = *c;
-
-				ctx.no_polymorphic_errors = true;
-				ctx.allow_polymorphic_types = is_type_polymorphic(pt);
-				ctx.hide_polymorphic_errors = true;
-
-				err = call_checker(&ctx, call, pt, p, operands, CallArgumentMode_NoErrors, &data);
-				if (err != CallArgumentError_None) {
-					continue;
-				}
-				isize index = i;
+		// NOTE: Scoring every candidate is the bulk of the work, so the winner for a given set of argument
+		// types is remembered for the calls which follow
+		bool variadic_expand = ce->ellipsis.pos.line != 0;
+		bool memoize = call_checker == check_call_arguments_internal && proc_group_cache_can_memoize(procs, operands);
+		u64 memo_hash = 0;
+		isize memo_index = -1;
+		if (memoize) {
+			memo_hash = proc_group_cache_hash(operand->proc_group, operands, variadic_expand);
+			memo_index = proc_group_cache_find(c->info, memo_hash, operand->proc_group, operands, variadic_expand);
+		}
+
+		if (memo_index >= 0) {
+			ValidIndexAndScore item = {};
+			item.index = memo_index;
+			array_add(&valids, item);
+		} else {
+			for_array(i, procs) {
+				Entity *p = procs[i];
+				Type *pt = base_type(p->type);
+				if (pt != nullptr && is_type_proc(pt)) {
+					CallArgumentError err = CallArgumentError_None;
+					CallArgumentData data = {};
+					CheckerContext ctx = *c;
 
-				if (data.gen_entity != nullptr) {
-					Entity *e = data.gen_entity;
-					DeclInfo *decl = data.gen_entity->decl_info;
-					ctx.scope = decl->scope;
-					ctx.decl = decl;
-					ctx.proc_name = e->token.string;
-					ctx.curr_proc_decl = decl;
-					ctx.curr_proc_sig  = e->type;
+					ctx.no_polymorphic_errors = true;
+					ctx.allow_polymorphic_types = is_type_polymorphic(pt);
+					ctx.hide_polymorphic_errors = true;
 
-					GB_ASSERT(decl->proc_lit->kind == Ast_ProcLit);
-					if (!evaluate_where_clauses(&ctx, call, decl->scope, &decl->proc_lit->ProcLit.where_clauses, false)) {
+					err = call_checker(&ctx, call, pt, p, operands, CallArgumentMode_NoErrors, &data);
+					if (err != CallArgumentError_None) {
 						continue;
 					}
+					isize index = i;
+
+					if (data.gen_entity != nullptr) {
+						Entity *e = data.gen_entity;
+						DeclInfo *decl = data.gen_entity->decl_info;
+						ctx.scope = decl->scope;
+						ctx.decl = decl;
+						ctx.proc_name = e->token.string;
+						ctx.curr_proc_decl = decl;
+						ctx.curr_proc_sig  = e->type;
+
+						GB_ASSERT(decl->proc_lit->kind == Ast_ProcLit);
+						if (!evaluate_where_clauses(&ctx, call, decl->scope, &decl->proc_lit->ProcLit.where_clauses, false)) {
+							continue;
+						}
+
+						array_add(&proc_entities, data.gen_entity);
+						index = proc_entities.count-1;
+					}
 
-					array_add(&proc_entities, data.gen_entity);
-					index = proc_entities.count-1;
+					ValidIndexAndScore item = {};
+					item.index = index;
+					item.score = data.score;
+					array_add(&valids, item);
 				}
-
-				ValidIndexAndScore item = {};
-				item.index = index;
-				item.score = data.score;
-				array_add(&valids, item);
 			}
 		}
 
@@ -5314,6 +5468,10 @@ CallArgumentData check_call_arguments(CheckerContext *c, Operand *operand, Type
 			}
 		}
 
+		if (memoize && memo_index < 0 && valids.count == 1) {
+			proc_group_cache_add(c->info, memo_hash, operand->proc_group, operands, variadic_expand, valids[0].index);
+		}
+
 
 		if (valids.count == 0) {
 			begin_error_block();
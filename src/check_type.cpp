@@ -207,7 +207,7 @@ bool check_custom_align(CheckerContext *ctx, Ast *node, i64 *align_) {
 	if (is_type_untyped(type) || is_type_integer(type)) {
 		if (o.value.kind == ExactValue_Integer) {
 			BigInt v = o.value.value_integer;
-			if (v.used > 1) {
+			if (!big_int_fits_i64(&v)) {
 				gbAllocator a = heap_allocator();
 				String str = big_int_to_string(a, &v);
 				error(node, "#align too large, %.*s", LIT(str));
@@ -235,7 +235,92 @@ bool check_custom_align(CheckerContext *ctx, Ast *node, i64 *align_) {
 }
 
 
+bool polymorphic_record_params_match(TypeTuple *tuple, isize param_count, Array<Operand> const &ordered_operands) {
+	GB_ASSERT(param_count == tuple->variables.count);
+
+	for (isize j = 0; j < param_count; j++) {
+		Entity *p = tuple->variables[j];
+		Operand o = {};
+		if (j < ordered_operands.count) {
+			o = ordered_operands[j];
+		}
+		if (o.expr == nullptr) {
+			continue;
+		}
+		Entity *oe = entity_of_node(o.expr);
+		if (p == oe) {
+			// NOTE(bill): This is the same type, make sure that it will be be same thing and use that
+			// Saves on a lot of checking too below
+			continue;
+		}
+
+		if (p->kind == Entity_TypeName) {
+			if (is_type_polymorphic(o.type)) {
+				// NOTE(bill): Do not add polymorphic version to the gen_types
+				return false;
+			}
+			if (!are_types_identical(o.type, p->type)) {
+				return false;
+			}
+		} else if (p->kind == Entity_Constant) {
+			if (!compare_exact_values(Token_CmpEq, o.value, p->Constant.value)) {
+				return false;
+			}
+			if (!are_types_identical(o.type, p->type)) {
+				return false;
+			}
+		} else {
+			GB_PANIC("Unknown entity kind");
+		}
+	}
+	return true;
+}
+
+u64 polymorphic_record_param_hash(u64 hash, EntityKind kind, Type *type, ExactValue const &value) {
+	hash = hash_combine_u64(hash, type_hash_identity(type));
+	if (kind == Entity_Constant) {
+		hash = hash_combine_u64(hash, hash_exact_value_identity(value));
+	}
+	return hash;
+}
+
+// NOTE: Returns false when some of the operands are missing or polymorphic, as then the index cannot be used
+bool polymorphic_record_operands_hash(Type *original_type, isize param_count, Array<Operand> const &ordered_operands, u64 *hash_) {
+	TypeTuple *original_params = get_record_polymorphic_params(original_type);
+	if (original_params == nullptr || param_count == 0 ||
+	    original_params->variables.count != param_count || ordered_operands.count < param_count) {
+		return false;
+	}
+
+	u64 hash = cast(u64)cast(uintptr)original_type;
+	for (isize j = 0; j < param_count; j++) {
+		Operand const &o = ordered_operands[j];
+		if (o.expr == nullptr || o.type == nullptr || is_type_polymorphic(o.type)) {
+			return false;
+		}
+		hash = polymorphic_record_param_hash(hash, original_params->variables[j]->kind, o.type, o.value);
+	}
+	*hash_ = hash;
+	return true;
+}
+
 Entity *find_polymorphic_record_entity(CheckerContext *ctx, Type *original_type, isize param_count, Array<Operand> const &ordered_operands, bool *failure) {
+	u64 hash = 0;
+	if (polymorphic_record_operands_hash(original_type, param_count, ordered_operands, &hash)) {
+		GenEntityIndexStripe *stripe = gen_entity_index_stripe(&ctx->info->gen_types_index, hash);
+		mutex_lock(&stripe->mutex);
+		defer (mutex_unlock(&stripe->mutex));
+
+		HashKey key = hash_integer(hash);
+		for (auto *entry = multi_map_find_first(&stripe->map, key); entry != nullptr; entry = multi_map_find_next(&stripe->map, entry)) {
+			if (entry->value.base == original_type &&
+			    polymorphic_record_params_match(&entry->value.params->Tuple, param_count, ordered_operands)) {
+				return entry->value.entity;
+			}
+		}
+		return nullptr;
+	}
+
 	mutex_lock(&ctx->info->gen_types_mutex);
 	defer (mutex_unlock(&ctx->info->gen_types_mutex));
 
@@ -247,50 +332,7 @@ Entity *find_polymorphic_record_entity(CheckerContext *ctx, Type *original_type,
 			Entity *e = (*found_gen_types)[i];
 			Type *t = base_type(e->type);
 			TypeTuple *tuple = get_record_polymorphic_params(t);
-			GB_ASSERT(param_count == tuple->variables.count);
-
-			bool skip = false;
-
-			for (isize j = 0; j < param_count; j++) {
-				Entity *p = tuple->variables[j];
-				Operand o = {};
-				if (j < ordered_operands.count) {
-					o = ordered_operands[j];
-				}
-				if (o.expr == nullptr) {
-					continue;
-				}
-				Entity *oe = entity_of_node(o.expr);
-				if (p == oe) {
-					// NOTE(bill): This is the same type, make sure that it will be be same thing and use that
-					// Saves on a lot of checking too below
-					continue;
-				}
-
-				if (p->kind == Entity_TypeName) {
-					if (is_type_polymorphic(o.type)) {
-						// NOTE(bill): Do not add polymorphic version to the gen_types
-						skip = true;
-						break;
-					}
-					if (!are_types_identical(o.type, p->type)) {
-						skip = true;
-						break;
-					}
-				} else if (p->kind == Entity_Constant) {
-					if (!compare_exact_values(Token_CmpEq, o.value, p->Constant.value)) {
-						skip = true;
-						break;
-					}
-					if (!are_types_identical(o.type, p->type)) {
-						skip = true;
-						break;
-					}
-				} else {
-					GB_PANIC("Unknown entity kind");
-				}
-			}
-			if (!skip) {
+			if (polymorphic_record_params_match(tuple, param_count, ordered_operands)) {
 				return e;
 			}
 		}
@@ -299,7 +341,7 @@ Entity *find_polymorphic_record_entity(CheckerContext *ctx, Type *original_type,
 }
 
 
-void add_polymorphic_record_entity(CheckerContext *ctx, Ast *node, Type *named_type, Type *original_type) {
+void add_polymorphic_record_entity(CheckerContext *ctx, Ast *node, Type *named_type, Type *original_type, Type *polymorphic_params) {
 	GB_ASSERT(is_type_named(named_type));
 	gbAllocator a = heap_allocator();
 	Scope *s = ctx->scope->parent;
@@ -321,6 +363,21 @@ void add_polymorphic_record_entity(CheckerContext *ctx, Ast *node, Type *named_t
 
 	named_type->Named.type_name = e;
 
+	if (polymorphic_params != nullptr) {
+		GB_ASSERT(polymorphic_params->kind == Type_Tuple);
+		u64 hash = cast(u64)cast(uintptr)original_type;
+		for_array(i, polymorphic_params->Tuple.variables) {
+			Entity *p = polymorphic_params->Tuple.variables[i];
+			hash = polymorphic_record_param_hash(hash, p->kind, p->type, p->kind == Entity_Constant ? p->Constant.value : empty_exact_value);
+		}
+
+		GenEntityIndexStripe *stripe = gen_entity_index_stripe(&ctx->info->gen_types_index, hash);
+		GenEntityIndexEntry entry = {original_type, e, polymorphic_params};
+		mutex_lock(&stripe->mutex);
+		multi_map_insert(&stripe->map, hash_integer(hash), entry);
+		mutex_unlock(&stripe->mutex);
+	}
+
 	mutex_lock(&ctx->info->gen_types_mutex);
 	auto *found_gen_types = map_get(&ctx->info->gen_types, hash_pointer(original_type));
 	if (found_gen_types) {
@@ -505,7 +562,7 @@ Type *check_record_polymorphic_params(CheckerContext *ctx, Ast *polymorphic_para
 
 	if (original_type_for_poly != nullptr) {
 		GB_ASSERT(named_type != nullptr);
-		add_polymorphic_record_entity(ctx, node, named_type, original_type_for_poly);
+		add_polymorphic_record_entity(ctx, node, named_type, original_type_for_poly, polymorphic_params_type);
 	}
 
 	if (!*is_polymorphic_) {
@@ -2040,9 +2097,8 @@ i64 check_array_count(CheckerContext *ctx, Operand *o, Ast *e) {
 				gb_free(a, str.text);
 				return 0;
 			}
-			switch (count.used) {
-			case 0: return 0;
-			case 1: return big_int_to_u64(&count);
+			if (big_int_fits_i64(&count)) {
+				return big_int_to_u64(&count);
 			}
 			gbAllocator a = heap_allocator();
 			String str = big_int_to_string(a, &count);
@@ -2097,6 +2153,10 @@ void init_map_entry_type(Type *type) {
 
 void init_map_internal_types(Type *type) {
 	GB_ASSERT(type->kind == Type_Map);
+	// NOTE: This may be lazily called from multiple backend modules at once
+	mutex_lock(&g_type_mutex);
+	defer (mutex_unlock(&g_type_mutex));
+
 	init_map_entry_type(type);
 	if (type->Map.internal_type != nullptr) return;
 	if (type->Map.generated_struct_type != nullptr) return;
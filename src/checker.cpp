@@ -227,7 +227,8 @@ Scope *create_scope(CheckerInfo *info, Scope *parent, isize init_elements_capaci
 	s->parent = parent;
 	string_map_init(&s->elements, heap_allocator(), init_elements_capacity);
 	ptr_set_init(&s->imported, heap_allocator(), 0);
-	mutex_init(&s->mutex);
+	gb_local_persist MutexStats *scope_mutex_stats = mutex_stats_get("Scope.mutex");
+	mutex_init(&s->mutex, scope_mutex_stats);
 
 	if (parent != nullptr && parent != builtin_pkg->scope) {
 		Scope *prev_head_child = parent->head_child.exchange(s, std::memory_order_acq_rel);
@@ -639,16 +640,19 @@ void check_scope_usage(Checker *c, Scope *scope) {
 
 
 void add_dependency(CheckerInfo *info, DeclInfo *d, Entity *e) {
-	mutex_lock(&info->deps_mutex);
+	checker_lock_stripe(&info->deps_locks, d);
 	ptr_set_add(&d->deps, e);
-	mutex_unlock(&info->deps_mutex);
+	checker_unlock_stripe(&info->deps_locks, d);
 }
-void add_type_info_dependency(DeclInfo *d, Type *type) {
+void add_type_info_dependency(CheckerInfo *info, DeclInfo *d, Type *type) {
 	if (d == nullptr) {
 		return;
 	}
-	// NOTE(bill): no mutex is required here because the only procedure calling it is wrapped in a mutex already
+	// NOTE: The caller holds type_info_mutex, but a nested procedure merges its type_info_deps into
+	// its parent's under the stripe lock alone
+	checker_lock_stripe(&info->deps_locks, d);
 	ptr_set_add(&d->type_info_deps, type);
+	checker_unlock_stripe(&info->deps_locks, d);
 }
 
 AstPackage *get_core_package(CheckerInfo *info, String name) {
@@ -832,6 +836,146 @@ void init_universal(void) {
 }
 
 
+void gen_entity_index_init(GenEntityIndex *index, gbAllocator a, char const *name) {
+	MutexStats *stats = mutex_stats_get(name);
+	for (isize i = 0; i < GEN_ENTITY_INDEX_STRIPE_COUNT; i++) {
+		mutex_init(&index->stripes[i].mutex, stats);
+		map_init(&index->stripes[i].map, a);
+	}
+}
+
+void gen_entity_index_destroy(GenEntityIndex *index) {
+	for (isize i = 0; i < GEN_ENTITY_INDEX_STRIPE_COUNT; i++) {
+		mutex_destroy(&index->stripes[i].mutex);
+		map_destroy(&index->stripes[i].map);
+	}
+}
+
+GB_STATIC_ASSERT(GEN_ENTITY_INDEX_STRIPE_COUNT == 1<<(64-59));
+
+GenEntityIndexStripe *gen_entity_index_stripe(GenEntityIndex *index, u64 hash) {
+	// NOTE: Use the top bits for the stripe, as the map itself indexes with the bottom bits
+	return &index->stripes[hash >> 59];
+}
+
+
+isize checker_lock_stripe_index(void const *ptr) {
+	// NOTE: Mix the address, as its low bits are mostly alignment
+	u64 x = cast(u64)cast(uintptr)ptr;
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdull;
+	x ^= x >> 33;
+	return cast(isize)(x % CHECKER_LOCK_STRIPE_COUNT);
+}
+
+void checker_lock_stripes_init(CheckerLockStripes *s, char const *name) {
+	MutexStats *stats = mutex_stats_get(name);
+	for (isize i = 0; i < CHECKER_LOCK_STRIPE_COUNT; i++) {
+		mutex_init(&s->mutexes[i], stats);
+	}
+}
+
+void checker_lock_stripes_destroy(CheckerLockStripes *s) {
+	for (isize i = 0; i < CHECKER_LOCK_STRIPE_COUNT; i++) {
+		mutex_destroy(&s->mutexes[i]);
+	}
+}
+
+void checker_lock_stripe(CheckerLockStripes *s, void const *ptr) {
+	mutex_lock(&s->mutexes[checker_lock_stripe_index(ptr)]);
+}
+
+void checker_unlock_stripe(CheckerLockStripes *s, void const *ptr) {
+	mutex_unlock(&s->mutexes[checker_lock_stripe_index(ptr)]);
+}
+
+// NOTE: Stripes are always taken in index order, so that two threads locking the same pair cannot deadlock
+void checker_lock_stripe_pair(CheckerLockStripes *s, void const *a, void const *b) {
+	isize i = checker_lock_stripe_index(a);
+	isize j = checker_lock_stripe_index(b);
+	if (i > j) {
+		gb_swap(isize, i, j);
+	}
+	mutex_lock(&s->mutexes[i]);
+	if (i != j) {
+		mutex_lock(&s->mutexes[j]);
+	}
+}
+
+void checker_unlock_stripe_pair(CheckerLockStripes *s, void const *a, void const *b) {
+	isize i = checker_lock_stripe_index(a);
+	isize j = checker_lock_stripe_index(b);
+	mutex_unlock(&s->mutexes[i]);
+	if (i != j) {
+		mutex_unlock(&s->mutexes[j]);
+	}
+}
+
+void type_info_index_cache_init(TypeInfoIndexCache *cache, gbAllocator a) {
+	MutexStats *stats = mutex_stats_get("type_info_index_cache");
+	for (isize i = 0; i < CHECKER_LOCK_STRIPE_COUNT; i++) {
+		mutex_init(&cache->stripes[i].mutex, stats);
+		map_init(&cache->stripes[i].map, a);
+	}
+}
+
+void type_info_index_cache_destroy(TypeInfoIndexCache *cache) {
+	for (isize i = 0; i < CHECKER_LOCK_STRIPE_COUNT; i++) {
+		mutex_destroy(&cache->stripes[i].mutex);
+		map_destroy(&cache->stripes[i].map);
+	}
+}
+
+void proc_group_cache_init(ProcGroupCache *cache, gbAllocator a) {
+	MutexStats *stats = mutex_stats_get("proc_group_cache");
+	for (isize i = 0; i < CHECKER_LOCK_STRIPE_COUNT; i++) {
+		mutex_init(&cache->stripes[i].mutex, stats);
+		map_init(&cache->stripes[i].map, a);
+	}
+}
+
+void proc_group_cache_destroy(ProcGroupCache *cache) {
+	for (isize i = 0; i < CHECKER_LOCK_STRIPE_COUNT; i++) {
+		mutex_destroy(&cache->stripes[i].mutex);
+		map_destroy(&cache->stripes[i].map);
+	}
+}
+
+GB_STATIC_ASSERT(CHECKER_LOCK_STRIPE_COUNT == 1<<(64-58));
+
+ProcGroupCacheStripe *proc_group_cache_stripe(ProcGroupCache *cache, u64 hash) {
+	// NOTE: Use the top bits for the stripe, as the map itself indexes with the bottom bits
+	return &cache->stripes[hash >> 58];
+}
+
+
+gb_thread_local Array<Ast *> *checker_identifier_uses_buffer = nullptr;
+
+void add_identifier_use(CheckerInfo *info, Ast *identifier) {
+	Array<Ast *> *buffer = checker_identifier_uses_buffer;
+	if (buffer == nullptr) {
+		buffer = gb_alloc_item(permanent_allocator(), Array<Ast *>);
+		array_init(buffer, heap_allocator());
+
+		mutex_lock(&info->identifier_uses_mutex);
+		array_add(&info->identifier_uses_buffers, buffer);
+		mutex_unlock(&info->identifier_uses_mutex);
+
+		checker_identifier_uses_buffer = buffer;
+	}
+	array_add(buffer, identifier);
+}
+
+void merge_identifier_uses(CheckerInfo *info) {
+	mutex_lock(&info->identifier_uses_mutex);
+	defer (mutex_unlock(&info->identifier_uses_mutex));
+
+	for_array(i, info->identifier_uses_buffers) {
+		Array<Ast *> *buffer = info->identifier_uses_buffers[i];
+		array_add_elems(&info->identifier_uses, buffer->data, buffer->count);
+		array_clear(buffer);
+	}
+}
 
 
 void init_checker_info(CheckerInfo *i) {
@@ -847,6 +991,8 @@ void init_checker_info(CheckerInfo *i) {
 	string_map_init(&i->foreigns, a);
 	map_init(&i->gen_procs,       a);
 	map_init(&i->gen_types,       a);
+	gen_entity_index_init(&i->gen_procs_index, a, "gen_procs_index");
+	gen_entity_index_init(&i->gen_types_index, a, "gen_types_index");
 	array_init(&i->type_info_types, a);
 	map_init(&i->type_info_map,   a);
 	string_map_init(&i->files,    a);
@@ -860,6 +1006,7 @@ void init_checker_info(CheckerInfo *i) {
 	i->allow_identifier_uses = build_context.query_data_set_settings.kind == QueryDataSet_GoToDefinitions;
 	if (i->allow_identifier_uses) {
 		array_init(&i->identifier_uses, a);
+		array_init(&i->identifier_uses_buffers, a);
 	}
 
 
@@ -872,18 +1019,21 @@ void init_checker_info(CheckerInfo *i) {
 
 	TIME_SECTION("checker info: mutexes");
 
-	mutex_init(&i->gen_procs_mutex);
-	mutex_init(&i->gen_types_mutex);
-	mutex_init(&i->lazy_mutex);
-	mutex_init(&i->builtin_mutex);
-	mutex_init(&i->global_untyped_mutex);
-	mutex_init(&i->type_info_mutex);
-	mutex_init(&i->deps_mutex);
-	mutex_init(&i->type_and_value_mutex);
-	mutex_init(&i->identifier_uses_mutex);
-	mutex_init(&i->foreign_mutex);
+	mutex_init(&i->gen_procs_mutex,       "gen_procs_mutex");
+	mutex_init(&i->gen_types_mutex,       "gen_types_mutex");
+	mutex_init(&i->lazy_mutex,            "lazy_mutex");
+	mutex_init(&i->builtin_mutex,         "builtin_mutex");
+	mutex_init(&i->global_untyped_mutex,  "global_untyped_mutex");
+	mutex_init(&i->type_info_mutex,       "type_info_mutex");
+	mutex_init(&i->identifier_uses_mutex, "identifier_uses_mutex");
+	mutex_init(&i->foreign_mutex,         "foreign_mutex");
 
-	semaphore_init(&i->collect_semaphore);
+	checker_lock_stripes_init(&i->deps_locks, "deps_locks");
+	checker_lock_stripes_init(&i->type_and_value_locks, "type_and_value_locks");
+	type_info_index_cache_init(&i->type_info_index_cache, a);
+	proc_group_cache_init(&i->proc_group_cache, a);
+
+	semaphore_init(&i->collect_semaphore, "collect_semaphore");
 
 
 #undef TIME_SECTION
@@ -896,12 +1046,15 @@ void destroy_checker_info(CheckerInfo *i) {
 	string_map_destroy(&i->foreigns);
 	map_destroy(&i->gen_procs);
 	map_destroy(&i->gen_types);
+	gen_entity_index_destroy(&i->gen_procs_index);
+	gen_entity_index_destroy(&i->gen_types_index);
 	array_free(&i->type_info_types);
 	map_destroy(&i->type_info_map);
 	string_map_destroy(&i->files);
 	string_map_destroy(&i->packages);
 	array_free(&i->variable_init_order);
 	array_free(&i->identifier_uses);
+	array_free(&i->identifier_uses_buffers);
 	array_free(&i->required_foreign_imports_through_force);
 
 	mpmc_destroy(&i->entity_queue);
@@ -915,10 +1068,13 @@ void destroy_checker_info(CheckerInfo *i) {
 	mutex_destroy(&i->builtin_mutex);
 	mutex_destroy(&i->global_untyped_mutex);
 	mutex_destroy(&i->type_info_mutex);
-	mutex_destroy(&i->deps_mutex);
-	mutex_destroy(&i->type_and_value_mutex);
 	mutex_destroy(&i->identifier_uses_mutex);
 	mutex_destroy(&i->foreign_mutex);
+
+	checker_lock_stripes_destroy(&i->deps_locks);
+	checker_lock_stripes_destroy(&i->type_and_value_locks);
+	type_info_index_cache_destroy(&i->type_info_index_cache);
+	proc_group_cache_destroy(&i->proc_group_cache);
 }
 
 CheckerContext make_checker_context(Checker *c) {
@@ -953,9 +1109,11 @@ void reset_checker_context(CheckerContext *ctx, AstFile *file, UntypedExprInfoMa
 	}
 	destroy_checker_context(ctx);
 	auto *queue = ctx->procs_to_check_queue;
+	auto *later = ctx->procs_to_check_later;
 	*ctx = make_checker_context(ctx->checker);
 	add_curr_ast_file(ctx, file);
 	ctx->procs_to_check_queue = queue;
+	ctx->procs_to_check_later = later;
 	ctx->untyped = untyped;
 }
 
@@ -976,7 +1134,7 @@ void init_checker(Checker *c) {
 
 	// NOTE(bill): 1 Mi elements should be enough on average
 	mpmc_init(&c->procs_to_check_queue, heap_allocator(), 1<<20);
-	semaphore_init(&c->procs_to_check_semaphore);
+	semaphore_init(&c->procs_to_check_semaphore, "procs_to_check_semaphore");
 
 	mpmc_init(&c->global_untyped_queue, a, 1<<20);
 
@@ -1114,10 +1272,21 @@ isize type_info_index(CheckerInfo *info, Type *type, bool error_on_failure) {
 		type = t_bool;
 	}
 
+	HashKey key = hash_type(type);
+
+	TypeInfoIndexCache *cache = &info->type_info_index_cache;
+	TypeInfoIndexCacheStripe *stripe = &cache->stripes[checker_lock_stripe_index(type)];
+	mutex_lock(&stripe->mutex);
+	isize *found_cached_index = map_get(&stripe->map, key);
+	isize cached_index = found_cached_index ? *found_cached_index : -1;
+	mutex_unlock(&stripe->mutex);
+	if (cached_index >= 0) {
+		return cached_index;
+	}
+
 	mutex_lock(&info->type_info_mutex);
 
 	isize entry_index = -1;
-	HashKey key = hash_type(type);
 	isize *found_entry_index = map_get(&info->type_info_map, key);
 	if (found_entry_index) {
 		entry_index = *found_entry_index;
@@ -1139,6 +1308,13 @@ isize type_info_index(CheckerInfo *info, Type *type, bool error_on_failure) {
 
 	mutex_unlock(&info->type_info_mutex);
 
+	if (entry_index >= 0) {
+		// NOTE: An index never changes once it has been assigned
+		mutex_lock(&stripe->mutex);
+		map_set(&stripe->map, key, entry_index);
+		mutex_unlock(&stripe->mutex);
+	}
+
 	if (error_on_failure && entry_index < 0) {
 		compiler_error("Type_Info for '%s' could not be found", type_to_string(type));
 	}
@@ -1174,10 +1350,10 @@ void add_type_and_value(CheckerInfo *i, Ast *expr, AddressingMode mode, Type *ty
 		return;
 	}
 
-	mutex_lock(&i->type_and_value_mutex);
 	Ast *prev_expr = nullptr;
 	while (prev_expr != expr) {
 		prev_expr = expr;
+		checker_lock_stripe(&i->type_and_value_locks, expr);
 		expr->tav.mode = mode;
 		expr->tav.type = type;
 		if (mode == Addressing_Constant || mode == Addressing_Invalid) {
@@ -1187,10 +1363,10 @@ void add_type_and_value(CheckerInfo *i, Ast *expr, AddressingMode mode, Type *ty
 		} else if (mode == Addressing_Value && is_type_proc(type)) {
 			expr->tav.value = value;
 		}
+		checker_unlock_stripe(&i->type_and_value_locks, expr);
 
 		expr = unparen_expr(expr);
 	}
-	mutex_unlock(&i->type_and_value_mutex);
 }
 
 void add_entity_definition(CheckerInfo *i, Ast *identifier, Entity *entity) {
@@ -1303,9 +1479,7 @@ void add_entity_use(CheckerContext *c, Ast *identifier, Entity *entity) {
 		identifier->Ident.entity = entity;
 
 		if (c->info->allow_identifier_uses) {
-			mutex_lock(&c->info->identifier_uses_mutex);
-			array_add(&c->info->identifier_uses, identifier);
-			mutex_unlock(&c->info->identifier_uses_mutex);
+			add_identifier_use(c->info, identifier);
 		}
 
 		String dmsg = entity->deprecated_message;
@@ -1365,6 +1539,8 @@ bool could_entity_be_lazy(Entity *e, DeclInfo *d) {
 					return false;
 				} else if (name == "export") {
 					return false;
+				} else if (name == "require") {
+					return false;
 				}
 			}
 		}
@@ -1419,7 +1595,10 @@ void add_entity_and_decl_info(CheckerContext *c, Ast *identifier, Entity *e, Dec
 	}
 
 	if (e->token.pos.file_id != 0) {
-		e->order_in_src = cast(u64)(e->token.pos.file_id)<<32 | u32(e->token.pos.offset);
+		// NOTE: Ordered by file path rather than file id, see check_set_file_path_orders
+		AstFile *file = identifier->file != nullptr ? identifier->file : get_ast_file_from_id(e->token.pos.file_id);
+		GB_ASSERT(file != nullptr);
+		e->order_in_src = cast(u64)file->path_order<<32 | u32(e->token.pos.offset);
 	} else {
 		GB_ASSERT(!is_lazy);
 		e->order_in_src = cast(u64)(1+queue_count);
@@ -1454,7 +1633,7 @@ void add_type_info_type_internal(CheckerContext *c, Type *t) {
 		return;
 	}
 
-	add_type_info_dependency(c->decl, t);
+	add_type_info_dependency(c->info, c->decl, t);
 
 	auto found = map_get(&c->info->type_info_map, hash_type(t));
 	if (found != nullptr) {
@@ -1665,6 +1844,12 @@ void check_procedure_later(CheckerContext *c, ProcInfo *info) {
 		GB_ASSERT(c->procs_to_check_queue != nullptr);
 	}
 
+	c->checker->procs_to_check_pending.fetch_add(1, std::memory_order_relaxed);
+	if (c->procs_to_check_later != nullptr) {
+		array_add(c->procs_to_check_later, info);
+		return;
+	}
+
 	auto *queue = c->procs_to_check_queue ? c->procs_to_check_queue : &c->checker->procs_to_check_queue;
 	mpmc_enqueue(queue, info);
 }
@@ -1962,6 +2147,7 @@ void generate_minimum_dependency_set(Checker *c, Entity *start) {
 
 		// Utility procedures
 		str_lit("memory_equal"),
+		str_lit("memory_equal_words"),
 		str_lit("memory_compare"),
 		str_lit("memory_compare_zero"),
 
@@ -4114,6 +4300,30 @@ GB_COMPARE_PROC(sort_file_by_name) {
 	return string_compare(x_name, y_name);
 }
 
+GB_COMPARE_PROC(sort_file_by_fullpath) {
+	AstFile const *x = *cast(AstFile const **)a;
+	AstFile const *y = *cast(AstFile const **)b;
+	return string_compare(x->fullpath, y->fullpath);
+}
+
+// NOTE: File ids depend upon the order in which the parser's threads reached the files, so entities are
+// ordered by the rank of their file's full path instead, which is the same between builds
+void check_set_file_path_orders(Checker *c) {
+	auto files = array_make<AstFile *>(heap_allocator());
+	defer (array_free(&files));
+	for_array(i, c->parser->packages) {
+		AstPackage *pkg = c->parser->packages[i];
+		for_array(j, pkg->files) {
+			array_add(&files, pkg->files[j]);
+		}
+	}
+	gb_sort_array(files.data, files.count, sort_file_by_fullpath);
+	for_array(i, files) {
+		// NOTE: Starts at 1, as 0 is left for the entities which are not in a file
+		files[i]->path_order = cast(u32)(i+1);
+	}
+}
+
 void check_create_file_scopes(Checker *c) {
 	for_array(i, c->parser->packages) {
 		AstPackage *pkg = c->parser->packages[i];
@@ -4213,6 +4423,7 @@ THREAD_PROC(thread_proc_collect_entities) {
 
 	for (isize i = offset; i < file_end; i++) {
 		AstFile *f = c->info.files.entries[i].value;
+		TRACE_SPAN(str_lit("collect entities"), f->fullpath);
 		reset_checker_context(ctx, f, &untyped);
 
 		check_collect_entities(ctx, f->decls);
@@ -4259,6 +4470,7 @@ THREAD_PROC(thread_proc_check_export_entities) {
 	isize end = gb_min(data->offset + data->count, c->info.packages.entries.count);
 	for (isize i = data->offset; i < end; i++) {
 		AstPackage *pkg = c->info.packages.entries[i].value;
+		TRACE_SPAN(str_lit("export entities"), pkg->fullpath);
 		check_export_entities_in_pkg(&ctx, pkg, &untyped);
 	}
 
@@ -4575,17 +4787,20 @@ void calculate_global_init_order(Checker *c) {
 }
 
 
-void check_proc_info(Checker *c, ProcInfo *pi, UntypedExprInfoMap *untyped, ProcBodyQueue *procs_to_check_queue) {
+// NOTE: Returns whether the body was actually checked
+bool check_proc_info(Checker *c, ProcInfo *pi, UntypedExprInfoMap *untyped, ProcBodyQueue *procs_to_check_queue) {
 	if (pi == nullptr) {
-		return;
+		return false;
 	}
 	if (pi->type == nullptr) {
-		return;
+		return false;
 	}
 	if (pi->decl->proc_checked) {
-		return;
+		return false;
 	}
 
+	TEMPORARY_ALLOCATOR_GUARD();
+
 	CheckerContext ctx = make_checker_context(c);
 	defer (destroy_checker_context(&ctx));
 	reset_checker_context(&ctx, pi->file, untyped);
@@ -4600,14 +4815,14 @@ void check_proc_info(Checker *c, ProcInfo *pi, UntypedExprInfoMap *untyped, Proc
 			token = ast_token(pi->poly_def_node);
 		}
 		error(token, "Unspecialized polymorphic procedure '%.*s'", LIT(name));
-		return;
+		return false;
 	}
 
 	if (pt->is_polymorphic && pt->is_poly_specialized) {
 		Entity *e = pi->decl->entity;
 		if ((e->flags & EntityFlag_Used) == 0) {
 			// NOTE(bill, 2019-08-31): It was never used, don't check
-			return;
+			return false;
 		}
 	}
 
@@ -4625,12 +4840,26 @@ void check_proc_info(Checker *c, ProcInfo *pi, UntypedExprInfoMap *untyped, Proc
 		GB_ASSERT((pi->decl->entity->flags & EntityFlag_ProcBodyChecked) == 0);
 	}
 
+	// NOTE: A polymorphic procedure generated by this body is only marked as used once the call
+	// which generated it has been checked, so the procedures found here are only queued once the
+	// whole body has been checked, otherwise another thread could steal one and skip it as unused
+	Array<ProcInfo *> procs_to_check_later = {};
+	procs_to_check_later.allocator = heap_allocator();
+	defer (array_free(&procs_to_check_later));
+	ctx.procs_to_check_later = &procs_to_check_later;
+
 	check_proc_body(&ctx, pi->token, pi->decl, pi->type, pi->body);
 	if (pi->body != nullptr && pi->decl->entity != nullptr) {
 		pi->decl->entity->flags |= EntityFlag_ProcBodyChecked;
 	}
 	pi->decl->proc_checked = true;
 	add_untyped_expressions(&c->info, ctx.untyped);
+
+	auto *queue = procs_to_check_queue ? procs_to_check_queue : &c->procs_to_check_queue;
+	for_array(i, procs_to_check_later) {
+		mpmc_enqueue(queue, procs_to_check_later[i]);
+	}
+	return true;
 }
 
 GB_STATIC_ASSERT(sizeof(isize) == sizeof(void *));
@@ -4686,7 +4915,7 @@ void check_test_procedures(Checker *c) {
 		if (e == nullptr) {
 			Token tok = {};
 			if (pkg->files.count != 0) {
-				tok = pkg->files[0]->tokens[0];
+				tok = pkg->files[0]->first_token;
 			}
 			error(tok, "Unable to find the test '%.*s' in 'package %.*s' ", LIT(name), LIT(pkg->name));
 		}
@@ -4707,6 +4936,7 @@ void check_test_procedures(Checker *c) {
 
 gb_global std::atomic<isize> total_bodies_checked;
 
+// NOTE: Returns whether the body was checked, rather than requeued or skipped
 bool consume_proc_info_queue(Checker *c, ProcInfo *pi, ProcBodyQueue *q, UntypedExprInfoMap *untyped) {
 	GB_ASSERT(pi->decl != nullptr);
 	if (pi->decl->parent && pi->decl->parent->entity) {
@@ -4716,15 +4946,24 @@ bool consume_proc_info_queue(Checker *c, ProcInfo *pi, ProcBodyQueue *q, Untyped
 		// NOTE(bill): In single threaded mode, this should never happen
 		if (parent->kind == Entity_Procedure && (parent->flags & EntityFlag_ProcBodyChecked) == 0) {
 			mpmc_enqueue(q, pi);
-			return true;
+			return false;
 		}
 	}
 	if (untyped) {
 		map_clear(untyped);
 	}
-	check_proc_info(c, pi, untyped, q);
-	total_bodies_checked.fetch_add(1, std::memory_order_relaxed);
-	return false;
+	bool checked = false;
+	{
+		TRACE_SPAN(str_lit("check procedure body"), pi->token.string);
+		checked = check_proc_info(c, pi, untyped, q);
+	}
+	if (checked) {
+		total_bodies_checked.fetch_add(1, std::memory_order_relaxed);
+	}
+	// NOTE: Any nested procedure has already been counted by check_procedure_later,
+	// so the pending count only reaches zero once every queue has been drained
+	c->procs_to_check_pending.fetch_sub(1, std::memory_order_release);
+	return checked;
 }
 
 struct ThreadProcBodyData {
@@ -4733,8 +4972,27 @@ struct ThreadProcBodyData {
 	u32 thread_index;
 	u32 thread_count;
 	ThreadProcBodyData *all_data;
+	ProcBodyThreadStats stats;
 };
 
+bool steal_proc_info(ThreadProcBodyData *data, ProcInfo **pi_) {
+	for (u32 i = 1; i < data->thread_count; i++) {
+		ProcBodyQueue *victim = data->all_data[(data->thread_index + i) % data->thread_count].queue;
+		if (victim->count.load(std::memory_order_relaxed) <= 0) {
+			continue;
+		}
+		// NOTE: Only the owner enqueues onto its queue, and the lock stops it growing
+		// the queue whilst it is being stolen from
+		mutex_lock(&victim->mutex);
+		bool ok = mpmc_dequeue(victim, pi_);
+		mutex_unlock(&victim->mutex);
+		if (ok) {
+			return true;
+		}
+	}
+	return false;
+}
+
 THREAD_PROC(thread_proc_body) {
 	ThreadProcBodyData *data = cast(ThreadProcBodyData *)thread->user_data;
 	Checker *c = data->checker;
@@ -4744,10 +5002,35 @@ THREAD_PROC(thread_proc_body) {
 	UntypedExprInfoMap untyped = {};
 	map_init(&untyped, heap_allocator());
 
-	for (ProcInfo *pi; mpmc_dequeue(this_queue, &pi); /**/) {
-		consume_proc_info_queue(c, pi, this_queue, &untyped);
+	TRACE_SPAN(str_lit("check procedure bodies"));
+	u64 start = time_stamp_time_now();
+
+	// NOTE: Keep going until every body has been checked, stealing from the other threads when
+	// this thread's own queue is empty, as the bodies (and their nested procedures) vary greatly in size
+	while (c->procs_to_check_pending.load(std::memory_order_acquire) != 0) {
+		ProcInfo *pi = nullptr;
+		bool stolen = false;
+		if (mpmc_dequeue(this_queue, &pi)) {
+			// Own work
+		} else if (steal_proc_info(data, &pi)) {
+			stolen = true;
+		} else {
+			yield();
+			continue;
+		}
+
+		u64 busy_start = time_stamp_time_now();
+		bool checked = consume_proc_info_queue(c, pi, this_queue, &untyped);
+		data->stats.busy_time += time_stamp_time_now() - busy_start;
+		if (checked) {
+			// NOTE: Requeued bodies and unused polymorphic procedures are not counted
+			data->stats.bodies_checked += 1;
+			data->stats.bodies_stolen  += stolen;
+		}
 	}
 
+	data->stats.idle_time = (time_stamp_time_now() - start) - data->stats.busy_time;
+
 	map_destroy(&untyped);
 
 	semaphore_release(&c->procs_to_check_semaphore);
@@ -4786,12 +5069,12 @@ void check_procedure_bodies(Checker *c) {
 		data->thread_index = i;
 		data->thread_count = thread_count;
 		data->all_data = thread_data;
-		// NOTE(bill) 2x the amount assumes on average only 1 nested procedure
-		// TODO(bill): Determine a good heuristic
+		data->stats = {};
+		// NOTE: This is only the starting capacity, the queue grows when a thread finds many nested procedures
 		mpmc_init(data->queue, heap_allocator(), next_pow2_isize(load_count*2));
 	}
 
-	// Distibute the work load into multiple queues
+	// Distibute the initial work load into multiple queues, the threads steal from each other once they run out
 	for (isize j = 0; j < load_count; j++) {
 		for (isize i = 0; i < thread_count; i++) {
 			ProcBodyQueue *queue = thread_data[i].queue;
@@ -4808,6 +5091,7 @@ void check_procedure_bodies(Checker *c) {
 		total_queued += queue->count.load();
 	}
 	GB_ASSERT(total_queued == original_queue_count);
+	GB_ASSERT(c->procs_to_check_pending.load() == original_queue_count);
 
 
 	semaphore_post(&c->procs_to_check_semaphore, cast(i32)thread_count);
@@ -4837,6 +5121,11 @@ void check_procedure_bodies(Checker *c) {
 	isize global_remaining = c->procs_to_check_queue.count.load(std::memory_order_relaxed);
 	GB_ASSERT(global_remaining == 0);
 
+	c->procs_to_check_thread_stats = slice_make<ProcBodyThreadStats>(permanent_allocator(), thread_count);
+	for (u32 i = 0; i < thread_count; i++) {
+		c->procs_to_check_thread_stats[i] = thread_data[i].stats;
+	}
+
 	debugf("Total Procedure Bodies Checked: %td\n", total_bodies_checked.load(std::memory_order_relaxed));
 
 	global_procedure_body_in_worker_queue = false;
@@ -5076,6 +5365,7 @@ void check_parsed_files(Checker *c) {
 	}
 
 	TIME_SECTION("create file scopes");
+	check_set_file_path_orders(c);
 	check_create_file_scopes(c);
 
 	TIME_SECTION("collect entities");
@@ -5176,6 +5466,10 @@ void check_parsed_files(Checker *c) {
 	TIME_SECTION("check bodies have all been checked");
 	check_unchecked_bodies(c);
 
+	if (c->info.allow_identifier_uses) {
+		merge_identifier_uses(&c->info);
+	}
+
 	TIME_SECTION("add type info for type definitions");
 	for_array(i, c->info.definitions) {
 		Entity *e = c->info.definitions[i];
@@ -5202,8 +5496,8 @@ void check_parsed_files(Checker *c) {
 			token.pos.column  = 1;
 			if (s->pkg->files.count > 0) {
 				AstFile *f = s->pkg->files[0];
-				if (f->tokens.count > 0) {
-					token = f->tokens[0];
+				if (f->token_count > 0) {
+					token = f->first_token;
 				}
 			}
 
@@ -265,6 +265,70 @@ struct UntypedExprInfo {
 typedef Map<ExprInfo *> UntypedExprInfoMap; // Key: Ast *
 typedef MPMCQueue<ProcInfo *> ProcBodyQueue;
 
+// NOTE: Polymorphic instantiations are indexed by a hash of their base and the types and constant
+// values they were specialized with. The index is split into stripes, each with its own lock,
+// so that checker threads generating from different bases rarely wait on each other
+#define GEN_ENTITY_INDEX_STRIPE_COUNT 32
+
+struct GenEntityIndexEntry {
+	void *  base;   // Ast * identifier of the base procedure, or the original record Type *
+	Entity *entity;
+	Type *  params; // Polymorphic parameters of a generated record, nullptr for procedures
+};
+
+struct GenEntityIndexStripe {
+	BlockingMutex             mutex;
+	Map<GenEntityIndexEntry>  map; // Key: hash, multiple values on collision
+};
+
+struct GenEntityIndex {
+	GenEntityIndexStripe stripes[GEN_ENTITY_INDEX_STRIPE_COUNT];
+};
+
+// NOTE: Tables written from every checker thread are guarded by a set of lock stripes rather than
+// a single lock, with the stripe chosen by the address of the entry being modified
+#define CHECKER_LOCK_STRIPE_COUNT 64
+
+struct CheckerLockStripes {
+	BlockingMutex mutexes[CHECKER_LOCK_STRIPE_COUNT];
+};
+
+struct TypeInfoIndexCacheStripe {
+	BlockingMutex mutex;
+	Map<isize>    map; // Key: Type *
+};
+
+// NOTE: Caches the results of type_info_index so that repeated lookups of the same type do not
+// all go through type_info_mutex
+struct TypeInfoIndexCache {
+	TypeInfoIndexCacheStripe stripes[CHECKER_LOCK_STRIPE_COUNT];
+};
+
+// NOTE: Remembers which candidate a call to a procedure group resolved to, keyed by a hash of the group and
+// the modes, types and constant values of the arguments. Only groups without any polymorphic candidates are
+// remembered, as the choice between those also depends upon their where clauses
+struct ProcGroupCacheArg {
+	AddressingMode mode;
+	Type *         type;
+	ExactValue     value; // Only for Addressing_Constant
+};
+
+struct ProcGroupCacheEntry {
+	Entity *                 proc_group;
+	Slice<ProcGroupCacheArg> args;
+	bool                     variadic_expand;
+	isize                    index; // Into `proc_group_entities`
+};
+
+struct ProcGroupCacheStripe {
+	BlockingMutex             mutex;
+	Map<ProcGroupCacheEntry>  map; // Key: hash, multiple values on collision
+};
+
+struct ProcGroupCache {
+	ProcGroupCacheStripe stripes[CHECKER_LOCK_STRIPE_COUNT];
+};
+
 // CheckerInfo stores all the symbol information for a type-checked program
 struct CheckerInfo {
 	Checker *checker;
@@ -301,31 +365,38 @@ struct CheckerInfo {
 	BlockingMutex global_untyped_mutex;
 	BlockingMutex builtin_mutex;
 
-	// NOT recursive & only used at the end of `check_proc_body`
-	// and in `add_dependency`.
-	// This is a possible source of contention but probably not
-	// too much of a problem in practice
-	BlockingMutex deps_mutex;
+	// Guard the `deps` and `type_info_deps` of a DeclInfo, keyed by the DeclInfo
+	CheckerLockStripes deps_locks;
 
-	BlockingMutex type_and_value_mutex;
+	// Guard the `tav` of an Ast, keyed by the Ast
+	CheckerLockStripes type_and_value_locks;
 
 	RecursiveMutex lazy_mutex; // Mutex required for lazy type checking of specific files
 
-	RecursiveMutex gen_procs_mutex;
-	RecursiveMutex gen_types_mutex;
+	// NOTE: These only guard the lists, lookups go through the indices
+	BlockingMutex gen_procs_mutex;
+	BlockingMutex gen_types_mutex;
 	Map<Array<Entity *> > gen_procs; // Key: Ast * | Identifier -> Entity
 	Map<Array<Entity *> > gen_types; // Key: Type *
+	GenEntityIndex gen_procs_index;
+	GenEntityIndex gen_types_index;
 
 	BlockingMutex type_info_mutex; // NOT recursive
 	Array<Type *> type_info_types;
 	Map<isize>    type_info_map;   // Key: Type *
+	TypeInfoIndexCache type_info_index_cache;
+
+	ProcGroupCache proc_group_cache;
 
 	BlockingMutex foreign_mutex; // NOT recursive
 	StringMap<Entity *> foreigns;
 
 	// only used by 'odin query'
+	// NOTE: Each thread appends to its own buffer, these are merged into `identifier_uses` once
+	// the procedure bodies have been checked
 	bool          allow_identifier_uses;
-	BlockingMutex identifier_uses_mutex;
+	BlockingMutex identifier_uses_mutex; // Only guards `identifier_uses_buffers`
+	Array<Array<Ast *> *> identifier_uses_buffers;
 	Array<Ast *>  identifier_uses;
 
 	// NOTE(bill): These are actually MPSC queues
@@ -378,9 +449,18 @@ struct CheckerContext {
 	Ast *assignment_lhs_hint;
 
 	ProcBodyQueue *procs_to_check_queue;
+	Array<ProcInfo *> *procs_to_check_later; // Held back until the body being checked is done, see check_proc_info
 };
 
 
+// NOTE: Per-thread statistics of check_procedure_bodies, reported with -show-more-timings
+struct ProcBodyThreadStats {
+	u64   busy_time;
+	u64   idle_time;
+	isize bodies_checked;
+	isize bodies_stolen;
+};
+
 struct Checker {
 	Parser *    parser;
 	CheckerInfo info;
@@ -391,6 +471,9 @@ struct Checker {
 
 	ProcBodyQueue procs_to_check_queue;
 	Semaphore procs_to_check_semaphore;
+	std::atomic<isize> procs_to_check_pending; // Queued (in any queue) or currently being checked
+
+	Slice<ProcBodyThreadStats> procs_to_check_thread_stats;
 
 	// TODO(bill): Technically MPSC queue
 	MPMCQueue<UntypedExprInfo> global_untyped_queue;
@@ -468,3 +551,8 @@ void init_core_context(Checker *c);
 void init_mem_allocator(Checker *c);
 
 void add_untyped_expressions(CheckerInfo *cinfo, UntypedExprInfoMap *untyped);
+
+void checker_lock_stripe  (CheckerLockStripes *s, void const *ptr);
+void checker_unlock_stripe(CheckerLockStripes *s, void const *ptr);
+void checker_lock_stripe_pair  (CheckerLockStripes *s, void const *a, void const *b);
+void checker_unlock_stripe_pair(CheckerLockStripes *s, void const *a, void const *b);
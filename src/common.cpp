@@ -227,6 +227,14 @@ u64 fnv64a(void const *data, isize len) {
 	return h;
 }
 
+// NOTE: Mixes `x` into the running hash `h`, all of the bits of the result depend on both
+gb_inline u64 hash_combine_u64(u64 h, u64 x) {
+	h ^= x + 0x9e3779b97f4a7c15ull;
+	h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+	h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+	return h ^ (h >> 31);
+}
+
 u64 u64_digit_value(Rune r) {
 	if ('0' <= r && r <= '9') {
 		return r - '0';
@@ -414,17 +422,34 @@ typedef struct Arena {
 	BlockingMutex          mutex;
 	std::atomic<isize>     block_size;
 	std::atomic<isize>     total_used;
+	std::atomic<u64>       generation; // Bumped by arena_free_all to invalidate every thread's chunk
+	bool                   use_thread_chunks;
 } Arena;
 
 #define ARENA_MIN_ALIGNMENT 16
 #define ARENA_DEFAULT_BLOCK_SIZE (8*1024*1024)
+#define ARENA_THREAD_CHUNK_SIZE (64*1024)
+
+// NOTE: For an arena shared between many threads (`use_thread_chunks`), each thread bump allocates
+// from its own chunk of the arena's current block, so the mutex is only taken when it needs a new chunk
+struct ArenaThreadChunk {
+	Arena *arena;
+	u64    generation;
+	u8 *   ptr;
+	u8 *   end;
+};
+
+#define ARENA_THREAD_CHUNK_COUNT 4
+gb_thread_local ArenaThreadChunk arena_thread_chunks[ARENA_THREAD_CHUNK_COUNT];
 
 
 gb_global Arena permanent_arena = {};
 
-void arena_init(Arena *arena, gbAllocator block_allocator, isize block_size=ARENA_DEFAULT_BLOCK_SIZE) {
-	mutex_init(&arena->mutex);
+void arena_init(Arena *arena, gbAllocator block_allocator, isize block_size=ARENA_DEFAULT_BLOCK_SIZE, bool use_thread_chunks=false) {
+	mutex_init(&arena->mutex, "Arena.mutex");
 	arena->block_size = block_size;
+	arena->generation = 1;
+	arena->use_thread_chunks = use_thread_chunks;
 	array_init(&arena->blocks, block_allocator, 0, 2);
 }
 
@@ -441,22 +466,78 @@ void arena_internal_grow(Arena *arena, isize min_size) {
 	array_add(&arena->blocks, vmem);
 }
 
-void *arena_alloc(Arena *arena, isize size, isize alignment) {
-	mutex_lock(&arena->mutex);
-
+// NOTE: Must be called with the arena's mutex held
+u8 *arena_internal_carve(Arena *arena, isize size) {
+	size = ALIGN_UP(size, ARENA_MIN_ALIGNMENT);
 	if (size > (arena->end - arena->ptr)) {
 		arena_internal_grow(arena, size);
 		GB_ASSERT(size <= (arena->end - arena->ptr));
 	}
-	arena->total_used += size;
+	u8 *ptr = arena->ptr;
+	arena->ptr += size;
+	return ptr;
+}
 
+ArenaThreadChunk *arena_thread_chunk(Arena *arena) {
+	for (isize i = 0; i < ARENA_THREAD_CHUNK_COUNT; i++) {
+		ArenaThreadChunk *chunk = &arena_thread_chunks[i];
+		if (chunk->arena == arena) {
+			return chunk;
+		}
+	}
+	for (isize i = 0; i < ARENA_THREAD_CHUNK_COUNT; i++) {
+		ArenaThreadChunk *chunk = &arena_thread_chunks[i];
+		if (chunk->arena == nullptr) {
+			chunk->arena = arena;
+			return chunk;
+		}
+	}
+	// NOTE: More arenas than slots, so just take over the first one, wasting what is left of its chunk
+	ArenaThreadChunk *chunk = &arena_thread_chunks[0];
+	*chunk = {};
+	chunk->arena = arena;
+	return chunk;
+}
+
+void *arena_alloc(Arena *arena, isize size, isize alignment) {
 	isize align = gb_max(alignment, ARENA_MIN_ALIGNMENT);
-	void *ptr = arena->ptr;
-	arena->ptr = cast(u8 *)ALIGN_UP_PTR(arena->ptr + size, align);
-	GB_ASSERT(arena->ptr <= arena->end);
+	if (!arena->use_thread_chunks) {
+		mutex_lock(&arena->mutex);
+		u8 *ptr = arena_internal_carve(arena, size+align-ARENA_MIN_ALIGNMENT);
+		mutex_unlock(&arena->mutex);
+
+		arena->total_used.fetch_add(size, std::memory_order_relaxed);
+		return ALIGN_UP_PTR(ptr, align);
+	}
+
+	ArenaThreadChunk *chunk = arena_thread_chunk(arena);
+
+	u8 *ptr = cast(u8 *)ALIGN_UP_PTR(chunk->ptr, align);
+	if (chunk->generation != arena->generation.load(std::memory_order_relaxed) ||
+	    chunk->ptr == nullptr || size > (chunk->end - ptr)) {
+		mutex_lock(&arena->mutex);
+		if (size+align > ARENA_THREAD_CHUNK_SIZE/4) {
+			// NOTE: Large allocations get their own space rather than throwing away the current chunk
+			ptr = arena_internal_carve(arena, size+align);
+			mutex_unlock(&arena->mutex);
+
+			ptr = cast(u8 *)ALIGN_UP_PTR(ptr, align);
+			arena->total_used.fetch_add(size, std::memory_order_relaxed);
+			return ptr;
+		}
+
+		chunk->generation = arena->generation.load(std::memory_order_relaxed);
+		chunk->ptr = arena_internal_carve(arena, ARENA_THREAD_CHUNK_SIZE);
+		chunk->end = chunk->ptr + ARENA_THREAD_CHUNK_SIZE;
+		mutex_unlock(&arena->mutex);
+
+		ptr = cast(u8 *)ALIGN_UP_PTR(chunk->ptr, align);
+	}
+	GB_ASSERT(ptr + size <= chunk->end);
 	GB_ASSERT(ptr == ALIGN_DOWN_PTR(ptr, align));
+	chunk->ptr = ptr + size;
 
-	mutex_unlock(&arena->mutex);
+	arena->total_used.fetch_add(size, std::memory_order_relaxed);
 	return ptr;
 }
 
@@ -469,6 +550,8 @@ void arena_free_all(Arena *arena) {
 	array_clear(&arena->blocks);
 	arena->ptr = nullptr;
 	arena->end = nullptr;
+	arena->total_used = 0;
+	arena->generation.fetch_add(1);
 
 	mutex_unlock(&arena->mutex);
 }
@@ -523,86 +606,159 @@ gbAllocator permanent_allocator() {
 
 
 
-struct Temp_Allocator {
-	u8 *data;
-	isize len;
-	isize curr_offset;
-	gbAllocator backup_allocator;
-	Array<void *> leaked_allocations;
-	BlockingMutex mutex;
+// NOTE: Each thread has its own temporary arena, so no locking is needed. Memory is handed back
+// by rewinding to a mark, see TEMPORARY_ALLOCATOR_GUARD, or with temp_arena_free_all
+struct TempArenaBlock {
+	TempArenaBlock *prev;
+	isize           size;
+	isize           used;
+	isize           last_offset; // Offset of the most recent allocation, so that it can be resized in place
 };
 
-gb_global Temp_Allocator temporary_allocator_data = {};
-
-void temp_allocator_init(Temp_Allocator *s, isize size) {
-	s->backup_allocator = heap_allocator();
-	s->data = cast(u8 *)gb_alloc_align(s->backup_allocator, size, 16);
-	s->len = size;
-	s->curr_offset = 0;
-	s->leaked_allocations.allocator = s->backup_allocator;
-	mutex_init(&s->mutex);
-}
-
-void *temp_allocator_alloc(Temp_Allocator *s, isize size, isize alignment) {
-	size = align_formula_isize(size, alignment);
-	if (s->curr_offset+size <= s->len) {
-		u8 *start = s->data;
-		u8 *ptr = start + s->curr_offset;
-		ptr = cast(u8 *)align_formula_ptr(ptr, alignment);
-		// assume memory is zero
-
-		isize offset = ptr - start;
-		s->curr_offset = offset + size;
-		return ptr;
-	} else if (size <= s->len) {
-		u8 *start = s->data;
-		u8 *ptr = cast(u8 *)align_formula_ptr(start, alignment);
-		// assume memory is zero
-
-		isize offset = ptr - start;
-		s->curr_offset = offset + size;
-		return ptr;
+struct TempArena {
+	TempArenaBlock *curr;
+	gbAllocator     backing;
+};
+
+struct TempArenaMark {
+	TempArena *     arena;
+	TempArenaBlock *block;
+	isize           used;
+};
+
+#define TEMP_ARENA_BLOCK_SIZE (1024*1024)
+
+gb_thread_local TempArena temporary_arena = {};
+
+gb_inline u8 *temp_arena_block_data(TempArenaBlock *block) {
+	return cast(u8 *)(block+1);
+}
+
+void temp_arena_free_block(TempArena *arena, TempArenaBlock *block) {
+	gb_free(arena->backing, block);
+}
+
+void *temp_arena_alloc(TempArena *arena, isize size, isize alignment) {
+	if (arena->backing.proc == nullptr) {
+		arena->backing = heap_allocator();
+	}
+	isize align = gb_max(alignment, 1);
+
+	TempArenaBlock *block = arena->curr;
+	if (block != nullptr) {
+		u8 *data = temp_arena_block_data(block);
+		u8 *ptr = cast(u8 *)align_formula_ptr(data + block->used, align);
+		if (ptr + size <= data + block->size) {
+			block->last_offset = ptr - data;
+			block->used = block->last_offset + size;
+			// NOTE: Callers assume the memory is zeroed, as it was when this was the permanent arena
+			gb_zero_size(ptr, size);
+			return ptr;
+		}
 	}
 
-	void *ptr = gb_alloc_align(s->backup_allocator, size, alignment);
-	array_add(&s->leaked_allocations, ptr);
+	isize block_size = gb_max(TEMP_ARENA_BLOCK_SIZE, size + align);
+	TempArenaBlock *new_block = cast(TempArenaBlock *)gb_alloc_align(arena->backing, gb_size_of(TempArenaBlock) + block_size, 16);
+	GB_ASSERT(new_block != nullptr);
+	new_block->prev = block;
+	new_block->size = block_size;
+	new_block->used = 0;
+	new_block->last_offset = 0;
+	arena->curr = new_block;
+
+	u8 *data = temp_arena_block_data(new_block);
+	u8 *ptr = cast(u8 *)align_formula_ptr(data, align);
+	new_block->last_offset = ptr - data;
+	new_block->used = new_block->last_offset + size;
+	gb_zero_size(ptr, size);
 	return ptr;
 }
 
-void temp_allocator_free_all(Temp_Allocator *s) {
-	s->curr_offset = 0;
-	for_array(i, s->leaked_allocations) {
-		gb_free(s->backup_allocator, s->leaked_allocations[i]);
+void *temp_arena_resize(TempArena *arena, void *old_memory, isize old_size, isize size, isize alignment) {
+	TempArenaBlock *block = arena->curr;
+	if (block != nullptr && old_memory == temp_arena_block_data(block) + block->last_offset) {
+		// NOTE: Growing the most recent allocation (e.g. a gbString being appended to) can be done in place
+		if (block->last_offset + size <= block->size) {
+			if (size > old_size) {
+				gb_zero_size(cast(u8 *)old_memory + old_size, size - old_size);
+			}
+			block->used = block->last_offset + size;
+			return old_memory;
+		}
 	}
-	array_clear(&s->leaked_allocations);
-	gb_zero_size(s->data, s->len);
+	if (size <= old_size) {
+		return old_memory;
+	}
+	void *ptr = temp_arena_alloc(arena, size, alignment);
+	gb_memmove(ptr, old_memory, old_size);
+	return ptr;
 }
 
-GB_ALLOCATOR_PROC(temp_allocator_proc) {
-	void *ptr = nullptr;
-	Temp_Allocator *s = cast(Temp_Allocator *)allocator_data;
-	GB_ASSERT_NOT_NULL(s);
+TempArenaMark temp_arena_mark(TempArena *arena) {
+	TempArenaMark mark = {};
+	mark.arena = arena;
+	mark.block = arena->curr;
+	mark.used  = arena->curr ? arena->curr->used : 0;
+	return mark;
+}
 
-	mutex_lock(&s->mutex);
-	defer (mutex_unlock(&s->mutex));
+void temp_arena_reset(TempArenaMark const &mark) {
+	TempArena *arena = mark.arena;
+	while (arena->curr != mark.block) {
+		GB_ASSERT_MSG(arena->curr != nullptr, "Temporary arena mark reset out of order");
+		TempArenaBlock *prev = arena->curr->prev;
+		temp_arena_free_block(arena, arena->curr);
+		arena->curr = prev;
+	}
+	if (arena->curr != nullptr) {
+		GB_ASSERT(mark.used <= arena->curr->used);
+		arena->curr->used = mark.used;
+		arena->curr->last_offset = mark.used;
+	}
+}
+
+void temp_arena_free_all(TempArena *arena) {
+	while (arena->curr != nullptr) {
+		TempArenaBlock *prev = arena->curr->prev;
+		temp_arena_free_block(arena, arena->curr);
+		arena->curr = prev;
+	}
+}
+
+// Called by every thread on exit, as its thread local arena would otherwise be leaked
+void temporary_allocator_thread_exit(void) {
+	temp_arena_free_all(&temporary_arena);
+}
+
+struct TempArenaGuard {
+	TempArenaMark mark;
+	TempArenaGuard(TempArena *arena) : mark(temp_arena_mark(arena)) {}
+	~TempArenaGuard() { temp_arena_reset(mark); }
+};
+
+// Everything allocated with temporary_allocator() on this thread after this point is freed at the end of the scope
+#define TEMPORARY_ALLOCATOR_GUARD() TempArenaGuard GB_DEFER_3(_temp_arena_guard_)(&temporary_arena)
+
+GB_ALLOCATOR_PROC(temp_arena_allocator_proc) {
+	void *ptr = nullptr;
+	TempArena *arena = cast(TempArena *)allocator_data;
+	GB_ASSERT_NOT_NULL(arena);
 
 	switch (type) {
 	case gbAllocation_Alloc:
-		return temp_allocator_alloc(s, size, alignment);
+		ptr = temp_arena_alloc(arena, size, alignment);
+		break;
 	case gbAllocation_Free:
 		break;
 	case gbAllocation_Resize:
 		if (size == 0) {
 			ptr = nullptr;
-		} else if (size <= old_size) {
-			ptr = old_memory;
 		} else {
-			ptr = temp_allocator_alloc(s, size, alignment);
-			gb_memmove(ptr, old_memory, old_size);
+			ptr = temp_arena_resize(arena, old_memory, old_size, size, alignment);
 		}
 		break;
 	case gbAllocation_FreeAll:
-		temp_allocator_free_all(s);
+		temp_arena_free_all(arena);
 		break;
 	}
 
@@ -610,59 +766,78 @@ GB_ALLOCATOR_PROC(temp_allocator_proc) {
 }
 
 
+// NOTE: The returned allocator is only valid on the calling thread
 gbAllocator temporary_allocator() {
-	return permanent_allocator();
-	// return {temp_allocator_proc, &temporary_allocator_data};
+	return {temp_arena_allocator_proc, &temporary_arena};
 }
 
 
 
 
-#include "string_map.cpp"
 #include "map.cpp"
+#include "string_map.cpp"
 #include "ptr_set.cpp"
 #include "string_set.cpp"
 #include "priority_queue.cpp"
 #include "thread_pool.cpp"
 
 
+// NOTE: The interner is lock-free so that the tokenizer can intern identifiers from every parser
+// thread. Each bucket is a singly linked list that only ever has entries pushed onto its head with a
+// CAS, and entries are never removed, so readers can walk a list without synchronization.
+// The bucket count is fixed, as even the largest projects only have around a hundred thousand
+// distinct identifiers
+#define STRING_INTERN_BUCKET_COUNT (1<<16)
+
 struct StringIntern {
 	StringIntern *next;
+	u64 hash;
 	isize len;
 	char str[1];
 };
 
-Map<StringIntern *> string_intern_map = {}; // Key: u64
+gb_global std::atomic<StringIntern *> string_intern_buckets[STRING_INTERN_BUCKET_COUNT];
 Arena string_intern_arena = {};
 
 char const *string_intern(char const *text, isize len) {
 	u64 hash = gb_fnv64a(text, len);
-	u64 key = hash ? hash : 1;
-	StringIntern **found = map_get(&string_intern_map, hash_integer(key));
-	if (found) {
-		for (StringIntern *it = *found; it != nullptr; it = it->next) {
-			if (it->len == len && gb_strncmp(it->str, (char *)text, len) == 0) {
+	std::atomic<StringIntern *> *bucket = &string_intern_buckets[hash & (STRING_INTERN_BUCKET_COUNT-1)];
+
+	StringIntern *head = bucket->load(std::memory_order_acquire);
+	StringIntern *seen = nullptr; // Everything from here on has already been checked
+	StringIntern *new_intern = nullptr;
+	for (;;) {
+		for (StringIntern *it = head; it != seen; it = it->next) {
+			if (it->hash == hash && it->len == len && gb_memcompare(it->str, text, len) == 0) {
+				// NOTE: If another thread got there first, `new_intern` is just left in the arena
 				return it->str;
 			}
 		}
+		if (new_intern == nullptr) {
+			new_intern = cast(StringIntern *)arena_alloc(&string_intern_arena, gb_offset_of(StringIntern, str) + len + 1, gb_align_of(StringIntern));
+			new_intern->hash = hash;
+			new_intern->len = len;
+			gb_memmove(new_intern->str, text, len);
+			new_intern->str[len] = 0;
+		}
+		seen = head;
+		new_intern->next = head;
+		if (bucket->compare_exchange_weak(head, new_intern, std::memory_order_release, std::memory_order_acquire)) {
+			return new_intern->str;
+		}
 	}
-
-	StringIntern *new_intern = cast(StringIntern *)arena_alloc(&string_intern_arena, gb_offset_of(StringIntern, str) + len + 1, gb_align_of(StringIntern));
-	new_intern->len = len;
-	new_intern->next = found ? *found : nullptr;
-	gb_memmove(new_intern->str, text, len);
-	new_intern->str[len] = 0;
-	map_set(&string_intern_map, hash_integer(key), new_intern);
-	return new_intern->str;
 }
 
 char const *string_intern(String const &string) {
 	return string_intern(cast(char const *)string.text, string.len);
 }
 
+String string_intern_string(String const &string) {
+	return make_string(cast(u8 const *)string_intern(string), string.len);
+}
+
 void init_string_interner(void) {
-	map_init(&string_intern_map, heap_allocator());
-	arena_init(&string_intern_arena, heap_allocator());
+	arena_init(&string_intern_arena, heap_allocator(), ARENA_DEFAULT_BLOCK_SIZE, true);
 }
 
 
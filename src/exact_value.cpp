@@ -75,8 +75,12 @@ HashKey hash_exact_value(ExactValue v) {
 		}
 	case ExactValue_Integer:
 		{
-			HashKey key = hashing_proc(v.value_integer.dp, gb_size_of(*v.value_integer.dp) * v.value_integer.used);
-			u8 last = (u8)v.value_integer.sign;
+			BigInt const *i = &v.value_integer;
+			if (i->big == nullptr) {
+				return hash_integer(cast(u64)i->small);
+			}
+			HashKey key = hashing_proc(i->big->dp, gb_size_of(*i->big->dp) * i->big->used);
+			u8 last = (u8)i->big->sign;
 			key.key = (key.key ^ last) * 0x100000001b3ll;
 			return key;
 		}
@@ -99,6 +103,29 @@ HashKey hash_exact_value(ExactValue v) {
 
 }
 
+// NOTE: Unlike `hash_exact_value`, two values which `compare_exact_values` treats as equal always hash
+// the same (e.g. an integer and a float of the same value), and this does not touch the string interner
+u64 hash_exact_value_identity(ExactValue v) {
+	switch (v.kind) {
+	case ExactValue_Bool:
+		return 1 + cast(u64)v.value_bool;
+	case ExactValue_String:
+		return fnv64a(v.value_string.text, v.value_string.len);
+	case ExactValue_Integer:
+	case ExactValue_Float:
+		{
+			f64 f = v.kind == ExactValue_Integer ? big_int_to_f64(&v.value_integer) : v.value_float;
+			if (f == 0) {
+				f = 0; // -0.0 == +0.0
+			}
+			u64 bits = 0;
+			gb_memmove(&bits, &f, gb_size_of(f));
+			return bits;
+		}
+	}
+	return 0;
+}
+
 
 ExactValue exact_value_compound(Ast *node) {
 	ExactValue result = {ExactValue_Compound};
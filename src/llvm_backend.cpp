@@ -58,17 +58,35 @@ void lb_set_entity_from_other_modules_linkage_correctly(lbModule *other_module,
 	if (other_module == nullptr) {
 		return;
 	}
-	char const *cname = alloc_cstring(temporary_allocator(), name);
-
-	LLVMValueRef other_global = nullptr;
-	if (e->kind == Entity_Variable) {
-		other_global = LLVMGetNamedGlobal(other_module->mod, cname);
-	} else if (e->kind == Entity_Procedure) {
-		other_global = LLVMGetNamedFunction(other_module->mod, cname);
+	if (e->kind != Entity_Variable && e->kind != Entity_Procedure) {
+		return;
 	}
-	if (other_global) {
-		LLVMSetLinkage(other_global, LLVMExternalLinkage);
+
+	lbEntityCorrection ec = {};
+	ec.other_module = other_module;
+	ec.e = e;
+	ec.cname = alloc_cstring(permanent_allocator(), name);
+
+	mutex_lock(&other_module->gen->entities_to_correct_linkage_mutex);
+	array_add(&other_module->gen->entities_to_correct_linkage, ec);
+	mutex_unlock(&other_module->gen->entities_to_correct_linkage_mutex);
+}
+
+void lb_correct_entity_linkage(lbGenerator *gen) {
+	for_array(i, gen->entities_to_correct_linkage) {
+		lbEntityCorrection ec = gen->entities_to_correct_linkage[i];
+
+		LLVMValueRef other_global = nullptr;
+		if (ec.e->kind == Entity_Variable) {
+			other_global = LLVMGetNamedGlobal(ec.other_module->mod, ec.cname);
+		} else if (ec.e->kind == Entity_Procedure) {
+			other_global = LLVMGetNamedFunction(ec.other_module->mod, ec.cname);
+		}
+		if (other_global) {
+			LLVMSetLinkage(other_global, LLVMExternalLinkage);
+		}
 	}
+	array_clear(&gen->entities_to_correct_linkage);
 }
 
 void lb_emit_init_context(lbProcedure *p, lbAddr addr) {
@@ -132,14 +150,14 @@ lbValue lb_get_equal_proc_for_type(lbModule *m, Type *type) {
 		return {compare_proc->value, compare_proc->type};
 	}
 
-	static u32 proc_index = 0;
-
 	char buf[16] = {};
-	isize n = gb_snprintf(buf, 16, "__$equal%u", ++proc_index);
+	isize n = gb_snprintf(buf, 16, "__$equal%u", ++m->equal_proc_index);
 	char *str = gb_alloc_str_len(permanent_allocator(), buf, n-1);
 	String proc_name = make_string_c(str);
 
 	lbProcedure *p = lb_create_dummy_procedure(m, proc_name, t_equal_proc);
+	// NOTE: Each module makes its own, so the name is only unique within the module
+	LLVMSetLinkage(p->value, LLVMInternalLinkage);
 	map_set(&m->equal_procs, key, p);
 	lb_begin_procedure_body(p);
 
@@ -286,14 +304,14 @@ lbValue lb_get_hasher_proc_for_type(lbModule *m, Type *type) {
 		return {(*found)->value, (*found)->type};
 	}
 
-	static u32 proc_index = 0;
-
 	char buf[16] = {};
-	isize n = gb_snprintf(buf, 16, "__$hasher%u", ++proc_index);
+	isize n = gb_snprintf(buf, 16, "__$hasher%u", ++m->hasher_proc_index);
 	char *str = gb_alloc_str_len(permanent_allocator(), buf, n-1);
 	String proc_name = make_string_c(str);
 
 	lbProcedure *p = lb_create_dummy_procedure(m, proc_name, t_hasher_proc);
+	// NOTE: Each module makes its own, so the name is only unique within the module
+	LLVMSetLinkage(p->value, LLVMInternalLinkage);
 	map_set(&m->hasher_procs, key, p);
 	lb_begin_procedure_body(p);
 	defer (lb_end_procedure_body(p));
@@ -432,6 +450,9 @@ lbValue lb_get_hasher_proc_for_type(lbModule *m, Type *type) {
 
 
 lbValue lb_generate_anonymous_proc_lit(lbModule *m, String const &prefix_name, Ast *expr, lbProcedure *parent) {
+	mutex_lock(&m->gen->anonymous_proc_lits_mutex);
+	defer (mutex_unlock(&m->gen->anonymous_proc_lits_mutex));
+
 	lbProcedure **found = map_get(&m->gen->anonymous_proc_lits, hash_pointer(expr));
 	if (found) {
 		return lb_find_procedure_value_from_entity(m, (*found)->entity);
@@ -440,12 +461,18 @@ lbValue lb_generate_anonymous_proc_lit(lbModule *m, String const &prefix_name, A
 	ast_node(pl, ProcLit, expr);
 
 	// NOTE(bill): Generate a new name
-	// parent$count
-	isize name_len = prefix_name.len + 1 + 8 + 1;
+	// parent$anon-id
+	// NOTE: The id comes from where the literal is rather than from how many have been generated so far,
+	// as the modules may be generated in parallel
+	TokenPos pos = ast_token(expr).pos;
+	u64 name_id = cast(u64)pos.offset;
+	if (expr->file != nullptr) {
+		name_id = hash_combine_u64(fnv64a(expr->file->fullpath.text, expr->file->fullpath.len), name_id);
+	}
+	isize name_len = prefix_name.len + 6 + 16 + 1;
 	char *name_text = gb_alloc_array(permanent_allocator(), char, name_len);
-	i32 name_id = cast(i32)m->gen->anonymous_proc_lits.entries.count;
 
-	name_len = gb_snprintf(name_text, name_len, "%.*s$anon-%d", LIT(prefix_name), name_id);
+	name_len = gb_snprintf(name_text, name_len, "%.*s$anon-%llx", LIT(prefix_name), cast(unsigned long long)name_id);
 	String name = make_string((u8 *)name_text, name_len-1);
 
 	Type *type = type_of_expr(expr);
@@ -477,6 +504,45 @@ lbValue lb_generate_anonymous_proc_lit(lbModule *m, String const &prefix_name, A
 	return value;
 }
 
+// NOTE: Must match runtime.Map_Key_Compare
+enum lbMapKeyCompare {
+	lbMapKeyCompare_Proc   = 0,
+	lbMapKeyCompare_Bytes  = 1,
+	lbMapKeyCompare_String = 2,
+};
+
+bool lb_is_type_bytewise_compare(Type *type) {
+	Type *t = core_type(type);
+	switch (t->kind) {
+	case Type_Basic:
+		if (t->Basic.flags & (BasicFlag_Float|BasicFlag_Complex|BasicFlag_Quaternion)) {
+			// NOTE: -0 == +0 and NaN != NaN
+			return false;
+		}
+		return is_type_simple_compare(t);
+	case Type_Pointer:
+	case Type_MultiPointer:
+	case Type_Proc:
+	case Type_BitSet:
+		return true;
+	case Type_Array:
+		return lb_is_type_bytewise_compare(t->Array.elem);
+	case Type_EnumeratedArray:
+		return lb_is_type_bytewise_compare(t->EnumeratedArray.elem);
+	}
+	return false;
+}
+
+lbMapKeyCompare lb_map_key_compare_kind(Type *key_type) {
+	if (lb_is_type_bytewise_compare(key_type)) {
+		return lbMapKeyCompare_Bytes;
+	}
+	if (is_type_string(key_type) && !is_type_cstring(key_type)) {
+		return lbMapKeyCompare_String;
+	}
+	return lbMapKeyCompare_Proc;
+}
+
 lbValue lb_gen_map_header(lbProcedure *p, lbValue map_val_ptr, Type *map_type) {
 	GB_ASSERT_MSG(is_type_pointer(map_val_ptr.type), "%s", type_to_string(map_val_ptr.type));
 	lbAddr h = lb_add_local_generated(p, t_map_header, false); // all the values will be initialzed later
@@ -509,6 +575,9 @@ lbValue lb_gen_map_header(lbProcedure *p, lbValue map_val_ptr, Type *map_type) {
 	lb_emit_store(p, lb_emit_struct_ep(p, h.addr, 6), lb_const_int(p->module, t_uintptr, value_offset));
 	lb_emit_store(p, lb_emit_struct_ep(p, h.addr, 7), lb_const_int(p->module, t_int, value_size));
 
+	lbValue key_compare = lb_emit_struct_ep(p, h.addr, 8);
+	lb_emit_store(p, key_compare, lb_const_int(p->module, type_deref(key_compare.type), lb_map_key_compare_kind(key_type)));
+
 	return lb_addr_load(p, h);
 }
 
@@ -611,36 +680,7 @@ struct lbGlobalVariable {
 	bool is_initialized;
 };
 
-lbProcedure *lb_create_startup_type_info(lbModule *m) {
-	LLVMPassManagerRef default_function_pass_manager = LLVMCreateFunctionPassManagerForModule(m->mod);
-	lb_populate_function_pass_manager(m, default_function_pass_manager, false, build_context.optimization_level);
-	LLVMFinalizeFunctionPassManager(default_function_pass_manager);
-
-	Type *proc_type = alloc_type_proc(nullptr, nullptr, 0, nullptr, 0, false, ProcCC_CDecl);
-
-	lbProcedure *p = lb_create_dummy_procedure(m, str_lit(LB_STARTUP_TYPE_INFO_PROC_NAME), proc_type);
-	p->is_startup = true;
-	LLVMSetLinkage(p->value, LLVMInternalLinkage);
-
-	lb_begin_procedure_body(p);
-
-	lb_setup_type_info_data(p);
-
-	lb_end_procedure_body(p);
-
-	if (!m->debug_builder && LLVMVerifyFunction(p->value, LLVMReturnStatusAction)) {
-		gb_printf_err("LLVM CODE GEN FAILED FOR PROCEDURE: %s\n", "main");
-		LLVMDumpValue(p->value);
-		gb_printf_err("\n\n\n\n");
-		LLVMVerifyFunction(p->value, LLVMAbortProcessAction);
-	}
-
-	lb_run_function_pass_manager(default_function_pass_manager, p);
-
-	return p;
-}
-
-lbProcedure *lb_create_startup_runtime(lbModule *main_module, lbProcedure *startup_type_info, Array<lbGlobalVariable> &global_variables) { // Startup Runtime
+lbProcedure *lb_create_startup_runtime(lbModule *main_module, Array<lbGlobalVariable> &global_variables) { // Startup Runtime
 	LLVMPassManagerRef default_function_pass_manager = LLVMCreateFunctionPassManagerForModule(main_module->mod);
 	lb_populate_function_pass_manager(main_module, default_function_pass_manager, false, build_context.optimization_level);
 	LLVMFinalizeFunctionPassManager(default_function_pass_manager);
@@ -652,8 +692,6 @@ lbProcedure *lb_create_startup_runtime(lbModule *main_module, lbProcedure *start
 
 	lb_begin_procedure_body(p);
 
-	LLVMBuildCall2(p->builder, LLVMGetElementType(lb_type(main_module, startup_type_info->type)), startup_type_info->value, nullptr, 0, "");
-
 	for_array(i, global_variables) {
 		auto *var = &global_variables[i];
 		if (var->is_initialized) {
@@ -938,6 +976,186 @@ bool lb_is_module_empty(lbModule *m) {
 	return true;
 }
 
+String lb_module_trace_name(lbModule *m) {
+	if (m->pkg) {
+		return m->pkg->name;
+	}
+	return str_lit("<default module>");
+}
+
+GB_COMPARE_PROC(lb_entity_generation_cmp) {
+	Entity *x = *cast(Entity **)a;
+	Entity *y = *cast(Entity **)b;
+	i32 res = token_pos_cmp(x->token.pos, y->token.pos);
+	if (res != 0 || x == y) {
+		return res;
+	}
+	// NOTE: The instances of a polymorphic procedure share a position
+	gbString xs = type_to_string(x->type);
+	gbString ys = type_to_string(y->type);
+	res = gb_strcmp(xs, ys);
+	gb_string_free(ys);
+	gb_string_free(xs);
+	if (res != 0) {
+		return res;
+	}
+	// NOTE: An aliased procedure is a copy of the entity, id and all
+	if (x->id != y->id) {
+		return x->id < y->id ? -1 : +1;
+	}
+	return x < y ? -1 : +1;
+}
+
+// NOTE: With -object-cache, each module's object file is kept on disk along with the module's unoptimized
+// IR and the compiler, target and code generation settings it was made with. The IR already holds
+// everything the module depends upon (its entities, the types they use and the declarations it
+// needs from other modules), and it is named the same from build to build, so on a hit the passes
+// and emission are skipped and the cached object file is written out instead
+#define LB_OBJECT_CACHE_MAGIC   "odinobj"
+#define LB_OBJECT_CACHE_VERSION 1
+
+// NOTE: Fixed layout, followed by the settings, the module's bitcode and then the object file itself
+struct lbObjectCacheRecord {
+	char magic[8];
+	u32  version;
+	u32  settings_len;
+	u64  bitcode_len;
+	u64  object_len;
+};
+
+bool lb_object_cache_enabled(void) {
+	return build_context.object_cache_dir.len != 0 && build_context.build_mode != BuildMode_Assembly;
+}
+
+String lb_object_cache_settings(LLVMTargetMachineRef target_machine, LLVMRelocMode reloc_mode, LLVMCodeModel code_mode) {
+	char *triple   = LLVMGetTargetMachineTriple(target_machine);
+	char *cpu      = LLVMGetTargetMachineCPU(target_machine);
+	char *features = LLVMGetTargetMachineFeatureString(target_machine);
+	defer (LLVMDisposeMessage(triple));
+	defer (LLVMDisposeMessage(cpu));
+	defer (LLVMDisposeMessage(features));
+
+	gbString s = gb_string_make(heap_allocator(), "");
+	s = gb_string_append_fmt(s, "odin %.*s", LIT(ODIN_VERSION));
+#ifdef GIT_SHA
+	s = gb_string_append_fmt(s, " %s", GIT_SHA);
+#endif
+	s = gb_string_append_fmt(s, "\nllvm %s", LLVM_VERSION_STRING);
+	s = gb_string_append_fmt(s, "\ntarget %s %s %s", triple, cpu, features);
+	s = gb_string_append_fmt(s, "\nreloc %d code-model %d", cast(int)reloc_mode, cast(int)code_mode);
+	s = gb_string_append_fmt(s, "\nopt %d build-mode %d debug %d", cast(int)build_context.optimization_level, cast(int)build_context.build_mode, cast(int)build_context.ODIN_DEBUG);
+	return make_string(cast(u8 *)s, gb_string_length(s));
+}
+
+String lb_object_cache_path(lbModule *m) {
+	char buf[32] = {};
+	isize len = gb_snprintf(buf, gb_size_of(buf), "%016llx.odinobj", cast(unsigned long long)m->object_cache_key)-1;
+	return concatenate3_strings(permanent_allocator(), build_context.object_cache_dir, STR_LIT("/"), make_string(cast(u8 *)buf, len));
+}
+
+WORKER_TASK_PROC(lb_object_cache_lookup_worker_proc) {
+	lbModule *m = cast(lbModule *)data;
+	TRACE_SPAN(str_lit("object cache lookup"), lb_module_trace_name(m));
+
+	String settings = m->gen->object_cache_settings;
+	LLVMMemoryBufferRef bitcode = LLVMWriteBitcodeToMemoryBuffer(m->mod);
+	u8 const *bitcode_data = cast(u8 const *)LLVMGetBufferStart(bitcode);
+	usize bitcode_size = LLVMGetBufferSize(bitcode);
+	m->object_cache_key = hash_combine_u64(fnv64a(settings.text, settings.len), fnv64a(bitcode_data, bitcode_size));
+	// NOTE: Kept until the object file is stored, as the passes change the module
+	m->object_cache_bitcode = bitcode;
+
+	String cached_path = lb_object_cache_path(m);
+	gbFileContents fc = gb_file_read_contents(heap_allocator(), false, cast(char const *)cached_path.text);
+	if (fc.data == nullptr) {
+		return 0;
+	}
+	defer (gb_file_free_contents(&fc));
+	if (fc.size < gb_size_of(lbObjectCacheRecord)) {
+		return 0;
+	}
+	lbObjectCacheRecord *record = cast(lbObjectCacheRecord *)fc.data;
+	if (gb_memcompare(record->magic, LB_OBJECT_CACHE_MAGIC, gb_size_of(record->magic)) != 0 ||
+	    record->version != LB_OBJECT_CACHE_VERSION ||
+	    record->settings_len != cast(u64)settings.len ||
+	    record->bitcode_len != cast(u64)bitcode_size ||
+	    cast(u64)fc.size != gb_size_of(lbObjectCacheRecord) + record->settings_len + record->bitcode_len + record->object_len) {
+		return 0;
+	}
+	// NOTE: The whole key is compared rather than just its hash, so that a collision can never link in the wrong object file
+	u8 const *record_settings = cast(u8 const *)(record+1);
+	u8 const *record_bitcode  = record_settings + record->settings_len;
+	u8 const *record_object   = record_bitcode  + record->bitcode_len;
+	if (gb_memcompare(record_settings, settings.text, settings.len) != 0 ||
+	    gb_memcompare(record_bitcode, bitcode_data, bitcode_size) != 0) {
+		return 0;
+	}
+
+	String filepath_obj = lb_filepath_obj_for_module(m);
+	gbFile f = {};
+	if (gb_file_create(&f, cast(char const *)filepath_obj.text) != gbFileError_None) {
+		return 0;
+	}
+	bool ok = gb_file_write(&f, record_object, cast(isize)record->object_len);
+	gb_file_close(&f);
+	if (ok) {
+		m->object_cache_hit = true;
+		LLVMDisposeMemoryBuffer(m->object_cache_bitcode);
+		m->object_cache_bitcode = nullptr;
+	}
+	return 0;
+}
+
+void lb_object_cache_store(lbModule *m, String const &filepath_obj) {
+	if (m->object_cache_bitcode == nullptr) {
+		return;
+	}
+	defer ({
+		LLVMDisposeMemoryBuffer(m->object_cache_bitcode);
+		m->object_cache_bitcode = nullptr;
+	});
+
+	gbFileContents object = gb_file_read_contents(heap_allocator(), false, cast(char const *)filepath_obj.text);
+	if (object.data == nullptr) {
+		return;
+	}
+	defer (gb_file_free_contents(&object));
+
+	String settings = m->gen->object_cache_settings;
+	void const *bitcode_data = LLVMGetBufferStart(m->object_cache_bitcode);
+	usize bitcode_size = LLVMGetBufferSize(m->object_cache_bitcode);
+
+	lbObjectCacheRecord record = {};
+	gb_memmove(record.magic, LB_OBJECT_CACHE_MAGIC, gb_size_of(record.magic));
+	record.version      = LB_OBJECT_CACHE_VERSION;
+	record.settings_len = cast(u32)settings.len;
+	record.bitcode_len  = cast(u64)bitcode_size;
+	record.object_len   = cast(u64)object.size;
+
+	// NOTE: Written to a file of its own first, so that other builds sharing the cache never see a partial record
+	String cached_path = lb_object_cache_path(m);
+	gbString tmp = gb_string_make(heap_allocator(), "");
+	defer (gb_string_free(tmp));
+	tmp = gb_string_append_fmt(tmp, "%.*s.%u.tmp", LIT(cached_path), thread_current_id());
+
+	gbFile f = {};
+	if (gb_file_create(&f, tmp) != gbFileError_None) {
+		return;
+	}
+	bool ok = gb_file_write(&f, &record, gb_size_of(record)) &&
+	          gb_file_write(&f, settings.text, settings.len) &&
+	          gb_file_write(&f, bitcode_data, cast(isize)bitcode_size) &&
+	          gb_file_write(&f, object.data, object.size);
+	gb_file_close(&f);
+	if (ok) {
+		gb_file_remove(cast(char const *)cached_path.text);
+		ok = gb_file_move(tmp, cast(char const *)cached_path.text);
+	}
+	if (!ok) {
+		gb_file_remove(tmp);
+	}
+}
+
 struct lbLLVMEmitWorker {
 	LLVMTargetMachineRef target_machine;
 	LLVMCodeGenFileType code_gen_file_type;
@@ -951,11 +1169,15 @@ WORKER_TASK_PROC(lb_llvm_emit_worker_proc) {
 	char *llvm_error = nullptr;
 
 	auto wd = cast(lbLLVMEmitWorker *)data;
+	TRACE_SPAN(str_lit("emit module"), lb_module_trace_name(wd->m));
 
 	if (LLVMTargetMachineEmitToFile(wd->target_machine, wd->m->mod, cast(char *)wd->filepath_obj.text, wd->code_gen_file_type, &llvm_error)) {
 		gb_printf_err("LLVM Error: %s\n", llvm_error);
 		gb_exit(1);
 	}
+	if (lb_object_cache_enabled()) {
+		lb_object_cache_store(wd->m, wd->filepath_obj);
+	}
 
 	return 0;
 }
@@ -964,6 +1186,7 @@ WORKER_TASK_PROC(lb_llvm_function_pass_worker_proc) {
 	GB_ASSERT(MULTITHREAD_OBJECT_GENERATION);
 
 	auto m = cast(lbModule *)data;
+	TRACE_SPAN(str_lit("function passes"), lb_module_trace_name(m));
 
 	LLVMPassManagerRef default_function_pass_manager = LLVMCreateFunctionPassManagerForModule(m->mod);
 	LLVMPassManagerRef function_pass_manager_minimal = LLVMCreateFunctionPassManagerForModule(m->mod);
@@ -1043,6 +1266,7 @@ WORKER_TASK_PROC(lb_llvm_module_pass_worker_proc) {
 	GB_ASSERT(MULTITHREAD_OBJECT_GENERATION);
 
 	auto wd = cast(lbLLVMModulePassWorkerData *)data;
+	TRACE_SPAN(str_lit("module passes"), lb_module_trace_name(wd->m));
 
 	LLVMPassManagerRef module_pass_manager = LLVMCreatePassManager();
 	lb_populate_module_pass_manager(wd->target_machine, module_pass_manager, build_context.optimization_level);
@@ -1056,6 +1280,8 @@ void lb_generate_procedure(lbModule *m, lbProcedure *p) {
 	if (p->is_done) {
 		return;
 	}
+	TEMPORARY_ALLOCATOR_GUARD();
+
 	if (p->body != nullptr) { // Build Procedure
 		m->curr_procedure = p;
 		lb_begin_procedure_body(p);
@@ -1092,6 +1318,45 @@ void lb_generate_procedure(lbModule *m, lbProcedure *p) {
 }
 
 
+WORKER_TASK_PROC(lb_generate_procedures_worker_proc) {
+	lbModule *m = cast(lbModule *)data;
+	TRACE_SPAN(str_lit("generate procedures"), lb_module_trace_name(m));
+	for_array(i, m->procedures_to_generate) {
+		lbProcedure *p = m->procedures_to_generate[i];
+		lb_generate_procedure(m, p);
+	}
+	return 0;
+}
+
+WORKER_TASK_PROC(lb_generate_missing_procedures_worker_proc) {
+	lbModule *m = cast(lbModule *)data;
+	TRACE_SPAN(str_lit("generate missing procedures"), lb_module_trace_name(m));
+	for_array(i, m->missing_procedures_to_check) {
+		lbProcedure *p = m->missing_procedures_to_check[i];
+		debugf("Generate missing procedure: %.*s\n", LIT(p->name));
+		lb_generate_procedure(m, p);
+	}
+	return 0;
+}
+
+void lb_generate_procedures_for_modules(lbGenerator *gen, WorkerTaskProc *worker_proc, bool do_threading) {
+	if (do_threading) {
+		for_array(i, gen->modules.entries) {
+			lbModule *m = gen->modules.entries[i].value;
+			thread_pool_add_task(&lb_thread_pool, worker_proc, m);
+		}
+
+		thread_pool_start(&lb_thread_pool);
+		thread_pool_wait_to_process(&lb_thread_pool);
+	} else {
+		for_array(i, gen->modules.entries) {
+			lbModule *m = gen->modules.entries[i].value;
+			worker_proc(m);
+		}
+	}
+}
+
+
 void lb_generate_code(lbGenerator *gen) {
 	#define TIME_SECTION(str) do { if (build_context.show_more_timings) timings_start_section(&global_timings, str_lit(str)); } while (0)
 	#define TIME_SECTION_WITH_LEN(str, len) do { if (build_context.show_more_timings) timings_start_section(&global_timings, make_string((u8 *)str, len)); } while (0)
@@ -1133,6 +1398,7 @@ void lb_generate_code(lbGenerator *gen) {
 
 	TIME_SECTION("LLVM Create Target Machine");
 
+	LLVMRelocMode reloc_mode = LLVMRelocDefault;
 	LLVMCodeModel code_mode = LLVMCodeModelDefault;
 	if (is_arch_wasm()) {
 		code_mode = LLVMCodeModelJITDefault;
@@ -1172,7 +1438,7 @@ void lb_generate_code(lbGenerator *gen) {
 			target, target_triple, llvm_cpu,
 			llvm_features,
 			code_gen_level,
-			LLVMRelocDefault,
+			reloc_mode,
 			code_mode);
 		LLVMSetModuleDataLayout(gen->modules.entries[i].value->mod, LLVMCreateTargetDataLayout(target_machines[i]));
 	}
@@ -1483,8 +1749,15 @@ void lb_generate_code(lbGenerator *gen) {
 
 
 	TIME_SECTION("LLVM Global Procedures and Types");
-	for_array(i, info->entities) {
-		Entity *e = info->entities[i];
+	// NOTE: The checker's threads add to info->entities in whatever order they get to them, so they are
+	// sorted first to make the IR of each module the same from build to build
+	auto sorted_entities = array_make<Entity *>(heap_allocator(), info->entities.count);
+	defer (array_free(&sorted_entities));
+	gb_memmove(sorted_entities.data, info->entities.data, info->entities.count*gb_size_of(Entity *));
+	gb_sort_array(sorted_entities.data, sorted_entities.count, lb_entity_generation_cmp);
+
+	for_array(i, sorted_entities) {
+		Entity *e = sorted_entities[i];
 		String  name  = e->token.string;
 		Scope * scope = e->scope;
 
@@ -1542,20 +1815,15 @@ void lb_generate_code(lbGenerator *gen) {
 
 
 	TIME_SECTION("LLVM Runtime Type Information Creation");
-	lbProcedure *startup_type_info = lb_create_startup_type_info(default_module);
+	lb_setup_type_info_data(default_module);
 
 	TIME_SECTION("LLVM Runtime Startup Creation (Global Variables)");
-	lbProcedure *startup_runtime = lb_create_startup_runtime(default_module, startup_type_info, global_variables);
+	lbProcedure *startup_runtime = lb_create_startup_runtime(default_module, global_variables);
 
 
 	TIME_SECTION("LLVM Procedure Generation");
-	for_array(j, gen->modules.entries) {
-		lbModule *m = gen->modules.entries[j].value;
-		for_array(i, m->procedures_to_generate) {
-			lbProcedure *p = m->procedures_to_generate[i];
-			lb_generate_procedure(m, p);
-		}
-	}
+	// NOTE: Each module has its own LLVMContextRef, so the procedures of each module can be generated in parallel
+	lb_generate_procedures_for_modules(gen, lb_generate_procedures_worker_proc, do_threading);
 
 
 	if (!(build_context.build_mode == BuildMode_DynamicLibrary && !has_dll_main)) {
@@ -1563,14 +1831,11 @@ void lb_generate_code(lbGenerator *gen) {
 		lb_create_main_procedure(default_module, startup_runtime);
 	}
 
-	for_array(j, gen->modules.entries) {
-		lbModule *m = gen->modules.entries[j].value;
-		for_array(i, m->missing_procedures_to_check) {
-			lbProcedure *p = m->missing_procedures_to_check[i];
-			debugf("Generate missing procedure: %.*s\n", LIT(p->name));
-			lb_generate_procedure(m, p);
-		}
-	}
+	TIME_SECTION("LLVM Missing Procedure Generation");
+	lb_generate_procedures_for_modules(gen, lb_generate_missing_procedures_worker_proc, do_threading);
+
+	TIME_SECTION("LLVM Correct Entity Linkage");
+	lb_correct_entity_linkage(gen);
 
 	if (build_context.ODIN_DEBUG) {
 		TIME_SECTION("LLVM Debug Info Complete Types and Finalize");
@@ -1584,23 +1849,65 @@ void lb_generate_code(lbGenerator *gen) {
 	}
 
 
+	if (lb_object_cache_enabled()) {
+		TIME_SECTION("LLVM Object Cache Lookup");
+		gen->object_cache_settings = lb_object_cache_settings(target_machines[0], reloc_mode, code_mode);
+		for_array(i, gen->modules.entries) {
+			lbModule *m = gen->modules.entries[i].value;
+			if (lb_is_module_empty(m)) {
+				continue;
+			}
+			if (do_threading) {
+				thread_pool_add_task(&lb_thread_pool, lb_object_cache_lookup_worker_proc, m);
+			} else {
+				lb_object_cache_lookup_worker_proc(m);
+			}
+		}
+		if (do_threading) {
+			thread_pool_start(&lb_thread_pool);
+			thread_pool_wait_to_process(&lb_thread_pool);
+		}
+	}
+
 	TIME_SECTION("LLVM Function Pass");
 	for_array(i, gen->modules.entries) {
 		lbModule *m = gen->modules.entries[i].value;
+		if (m->object_cache_hit) {
+			continue;
+		}
 
-		lb_llvm_function_pass_worker_proc(m);
+		if (do_threading) {
+			thread_pool_add_task(&lb_thread_pool, lb_llvm_function_pass_worker_proc, m);
+		} else {
+			lb_llvm_function_pass_worker_proc(m);
+		}
+	}
+	if (do_threading) {
+		thread_pool_start(&lb_thread_pool);
+		thread_pool_wait_to_process(&lb_thread_pool);
 	}
 
 	TIME_SECTION("LLVM Module Pass");
 
 	for_array(i, gen->modules.entries) {
 		lbModule *m = gen->modules.entries[i].value;
+		if (m->object_cache_hit) {
+			continue;
+		}
 
 		auto wd = gb_alloc_item(permanent_allocator(), lbLLVMModulePassWorkerData);
 		wd->m = m;
 		wd->target_machine = target_machines[i];
 
-		lb_llvm_module_pass_worker_proc(wd);
+		if (do_threading) {
+			thread_pool_add_task(&lb_thread_pool, lb_llvm_module_pass_worker_proc, wd);
+		} else {
+			lb_llvm_module_pass_worker_proc(wd);
+		}
+	}
+	if (do_threading) {
+		thread_pool_start(&lb_thread_pool);
+		thread_pool_wait_to_process(&lb_thread_pool);
 	}
 
 
@@ -1614,6 +1921,10 @@ void lb_generate_code(lbGenerator *gen) {
 
 	for_array(j, gen->modules.entries) {
 		lbModule *m = gen->modules.entries[j].value;
+		if (m->object_cache_hit) {
+			// NOTE: identical IR was already verified by the build which stored it
+			continue;
+		}
 		if (LLVMVerifyModule(m->mod, LLVMReturnStatusAction, &llvm_error)) {
 			gb_printf_err("LLVM Error:\n%s\n", llvm_error);
 			if (build_context.keep_temp_files) {
@@ -1684,6 +1995,9 @@ void lb_generate_code(lbGenerator *gen) {
 			String filepath_obj = lb_filepath_obj_for_module(m);
 			array_add(&gen->output_object_paths, filepath_obj);
 			array_add(&gen->output_temp_paths, filepath_ll);
+			if (m->object_cache_hit) {
+				continue;
+			}
 
 			auto *wd = gb_alloc_item(heap_allocator(), lbLLVMEmitWorker);
 			wd->target_machine = target_machines[j];
@@ -1704,6 +2018,9 @@ void lb_generate_code(lbGenerator *gen) {
 
 			String filepath_obj = lb_filepath_obj_for_module(m);
 			array_add(&gen->output_object_paths, filepath_obj);
+			if (m->object_cache_hit) {
+				continue;
+			}
 
 			String short_name = remove_directory_from_path(filepath_obj);
 			gbString section_name = gb_string_make(heap_allocator(), "LLVM Generate Object: ");
@@ -1716,6 +2033,9 @@ void lb_generate_code(lbGenerator *gen) {
 				gb_exit(1);
 				return;
 			}
+			if (lb_object_cache_enabled()) {
+				lb_object_cache_store(m, filepath_obj);
+			}
 		}
 	}
 
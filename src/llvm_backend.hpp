@@ -119,7 +119,12 @@ struct lbModule {
 	Map<lbProcedure *> equal_procs; // Key: Type *
 	Map<lbProcedure *> hasher_procs; // Key: Type *
 
-	u32 nested_type_name_guid;
+	// NOTE: Per module, so that the names of the module's internal globals and procedures do not depend
+	// upon how far the other modules, which may be generated in parallel, have got
+	std::atomic<u32> global_array_index;
+	std::atomic<u32> global_generated_index;
+	std::atomic<u32> equal_proc_index;
+	std::atomic<u32> hasher_proc_index;
 
 	Array<lbProcedure *> procedures_to_generate;
 	Array<String> foreign_library_paths;
@@ -131,6 +136,16 @@ struct lbModule {
 	Map<LLVMMetadataRef> debug_values; // Key: Pointer
 
 	Array<lbIncompleteDebugType> debug_incomplete_types;
+
+	u64                 object_cache_key;
+	bool                object_cache_hit;
+	LLVMMemoryBufferRef object_cache_bitcode; // NOTE: Unoptimized, kept from the lookup until the object file is stored
+};
+
+struct lbEntityCorrection {
+	lbModule *  other_module;
+	Entity *    e;
+	char const *cname;
 };
 
 struct lbGenerator {
@@ -140,14 +155,17 @@ struct lbGenerator {
 	Array<String> output_temp_paths;
 	String   output_base;
 	String   output_name;
+	String   object_cache_settings;
 	Map<lbModule *> modules; // Key: AstPackage *
 	Map<lbModule *> modules_through_ctx; // Key: LLVMContextRef *
 	lbModule default_module;
 
+	BlockingMutex anonymous_proc_lits_mutex;
 	Map<lbProcedure *> anonymous_proc_lits; // Key: Ast *
 
-	std::atomic<u32> global_array_index;
-	std::atomic<u32> global_generated_index;
+	// NOTE: Modules may be generated in parallel, so linkage changes to another module are deferred until all procedures are generated
+	BlockingMutex entities_to_correct_linkage_mutex;
+	Array<lbEntityCorrection> entities_to_correct_linkage;
 };
 
 
@@ -286,6 +304,7 @@ bool lb_init_generator(lbGenerator *gen, Checker *c);
 void lb_generate_module(lbGenerator *gen);
 
 String lb_mangle_name(lbModule *m, Entity *e);
+u64 lb_entity_name_suffix(Entity *e);
 String lb_get_entity_name(lbModule *m, Entity *e, String name = {});
 
 LLVMAttributeRef lb_create_enum_attribute(LLVMContextRef ctx, char const *name, u64 value=0);
@@ -326,6 +345,7 @@ lbValue lb_build_gep(lbProcedure *p, lbValue const &value, i32 index) ;
 lbValue lb_emit_struct_ep(lbProcedure *p, lbValue s, i32 index);
 lbValue lb_emit_struct_ev(lbProcedure *p, lbValue s, i32 index);
 lbValue lb_emit_array_epi(lbProcedure *p, lbValue value, isize index);
+lbValue lb_const_array_epi(lbModule *m, lbValue value, isize index);
 lbValue lb_emit_array_ep(lbProcedure *p, lbValue s, lbValue index);
 lbValue lb_emit_deep_field_gep(lbProcedure *p, lbValue e, Selection sel);
 lbValue lb_emit_deep_field_ev(lbProcedure *p, lbValue e, Selection sel);
@@ -357,6 +377,7 @@ lbAddr lb_add_local(lbProcedure *p, Type *type, Entity *e=nullptr, bool zero_ini
 void lb_add_foreign_library_path(lbModule *m, Entity *e);
 
 lbValue lb_typeid(lbModule *m, Type *type);
+LLVMValueRef lb_typeid_index_mask(lbModule *m);
 
 lbValue lb_address_from_load_or_generate_local(lbProcedure *p, lbValue value);
 lbValue lb_address_from_load(lbProcedure *p, lbValue value);
@@ -409,6 +430,7 @@ lbValue lb_find_value_from_entity(lbModule *m, Entity *e);
 void lb_store_type_case_implicit(lbProcedure *p, Ast *clause, lbValue value);
 lbAddr lb_store_range_stmt_val(lbProcedure *p, Ast *stmt_val, lbValue value);
 lbValue lb_emit_source_code_location(lbProcedure *p, String const &procedure, TokenPos const &pos);
+lbValue lb_const_source_code_location(lbModule *m, String const &procedure, TokenPos const &pos);
 
 lbValue lb_handle_param_value(lbProcedure *p, Type *parameter_type, ParameterValue const &param_value, TokenPos const &pos);
 
@@ -447,7 +469,6 @@ void lb_reset_copy_elision_hint(lbProcedure *p, lbCopyElisionHint prev_hint);
 lbValue lb_consume_copy_elision_hint(lbProcedure *p);
 
 #define LB_STARTUP_RUNTIME_PROC_NAME   "__$startup_runtime"
-#define LB_STARTUP_TYPE_INFO_PROC_NAME "__$startup_type_info"
 #define LB_TYPE_INFO_DATA_NAME       "__$type_info_data"
 #define LB_TYPE_INFO_TYPES_NAME      "__$type_info_types_data"
 #define LB_TYPE_INFO_NAMES_NAME      "__$type_info_names_data"
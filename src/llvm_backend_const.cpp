@@ -225,14 +225,12 @@ lbValue lb_expr_untyped_const_to_typed(lbModule *m, Ast *expr, Type *t) {
 	return lb_const_value(m, t, tv.value);
 }
 
-lbValue lb_emit_source_code_location(lbProcedure *p, String const &procedure, TokenPos const &pos) {
-	lbModule *m = p->module;
-
+lbValue lb_const_source_code_location(lbModule *m, String const &procedure, TokenPos const &pos) {
 	LLVMValueRef fields[4] = {};
-	fields[0]/*file*/      = lb_find_or_add_entity_string(p->module, get_file_path_string(pos.file_id)).value;
+	fields[0]/*file*/      = lb_find_or_add_entity_string(m, get_file_path_string(pos.file_id)).value;
 	fields[1]/*line*/      = lb_const_int(m, t_i32, pos.line).value;
 	fields[2]/*column*/    = lb_const_int(m, t_i32, pos.column).value;
-	fields[3]/*procedure*/ = lb_find_or_add_entity_string(p->module, procedure).value;
+	fields[3]/*procedure*/ = lb_find_or_add_entity_string(m, procedure).value;
 
 	lbValue res = {};
 	res.value = llvm_const_named_struct(lb_type(m, t_source_code_location), fields, gb_count_of(fields));
@@ -240,6 +238,10 @@ lbValue lb_emit_source_code_location(lbProcedure *p, String const &procedure, To
 	return res;
 }
 
+lbValue lb_emit_source_code_location(lbProcedure *p, String const &procedure, TokenPos const &pos) {
+	return lb_const_source_code_location(p->module, procedure, pos);
+}
+
 lbValue lb_emit_source_code_location(lbProcedure *p, Ast *node) {
 	String proc_name = {};
 	if (p->entity) {
@@ -289,25 +291,14 @@ LLVMValueRef lb_big_int_to_llvm(lbModule *m, Type *original_type, BigInt const *
 	u64 rop64[4] = {}; // 2 u64 is the maximum we will ever need, so doubling it will be fine :P
 	u8 *rop = cast(u8 *)rop64;
 
-	size_t max_count = 0;
-	size_t written = 0;
-	size_t size = 1;
-	size_t nails = 0;
-	mp_endian endian = MP_LITTLE_ENDIAN;
+	GB_ASSERT(gb_size_of(rop64) >= sz);
 
-	max_count = mp_pack_count(a, nails, size);
+	size_t max_count = big_int_pack_magnitude(a, rop, sz);
 	if (sz < max_count) {
 		debug_print_big_int(a);
 		gb_printf_err("%s -> %tu\n", type_to_string(original_type), sz);;
 	}
-	GB_ASSERT_MSG(sz >= max_count, "max_count: %tu, sz: %tu, written: %tu", max_count, sz, written);
-	GB_ASSERT(gb_size_of(rop64) >= sz);
-
-	mp_err err = mp_pack(rop, sz, &written,
-	                     MP_LSB_FIRST,
-	                     size, endian, nails,
-	                     a);
-	GB_ASSERT(err == MP_OKAY);
+	GB_ASSERT_MSG(sz >= max_count, "max_count: %tu, sz: %tu", max_count, sz);
 
 	if (!is_type_endian_little(original_type)) {
 		for (size_t i = 0; i < sz/2; i++) {
@@ -400,7 +391,7 @@ lbValue lb_const_value(lbModule *m, Type *type, ExactValue value, bool allow_loc
 			} else {
 				isize max_len = 7+8+1;
 				char *str = gb_alloc_array(permanent_allocator(), char, max_len);
-				u32 id = m->gen->global_array_index.fetch_add(1);
+				u32 id = m->global_array_index.fetch_add(1);
 				isize len = gb_snprintf(str, max_len, "csba$%x", id);
 
 				String name = make_string(cast(u8 *)str, len-1);
@@ -408,6 +399,7 @@ lbValue lb_const_value(lbModule *m, Type *type, ExactValue value, bool allow_loc
 				Entity *e = alloc_entity_constant(nullptr, make_token_ident(name), t, value);
 				array_data = LLVMAddGlobal(m->mod, lb_type(m, t), str);
 				LLVMSetInitializer(array_data, backing_array.value);
+				LLVMSetLinkage(array_data, LLVMInternalLinkage);
 
 				lbValue g = {};
 				g.value = array_data;
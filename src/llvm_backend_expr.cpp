@@ -220,6 +220,97 @@ lbValue lb_emit_unary_arith(lbProcedure *p, TokenKind op, lbValue x, Type *type)
 	return res;
 }
 
+LLVMValueRef lb_emit_vector_arith_values(lbProcedure *p, TokenKind op, LLVMValueRef x, LLVMValueRef y, Type *elem_type) {
+	LLVMValueRef z = nullptr;
+
+	Type *integral_type = base_type(elem_type);
+	if (is_type_simd_vector(integral_type)) {
+		integral_type = core_array_type(integral_type);
+	}
+	if (is_type_bit_set(integral_type)) {
+		switch (op) {
+		case Token_Add: op = Token_Or;     break;
+		case Token_Sub: op = Token_AndNot; break;
+		}
+	}
+
+	if (is_type_float(integral_type)) {
+		switch (op) {
+		case Token_Add:
+			z = LLVMBuildFAdd(p->builder, x, y, "");
+			break;
+		case Token_Sub:
+			z = LLVMBuildFSub(p->builder, x, y, "");
+			break;
+		case Token_Mul:
+			z = LLVMBuildFMul(p->builder, x, y, "");
+			break;
+		case Token_Quo:
+			z = LLVMBuildFDiv(p->builder, x, y, "");
+			break;
+		case Token_Mod:
+			z = LLVMBuildFRem(p->builder, x, y, "");
+			break;
+		default:
+			GB_PANIC("Unsupported vector operation");
+			break;
+		}
+
+	} else {
+
+		switch (op) {
+		case Token_Add:
+			z = LLVMBuildAdd(p->builder, x, y, "");
+			break;
+		case Token_Sub:
+			z = LLVMBuildSub(p->builder, x, y, "");
+			break;
+		case Token_Mul:
+			z = LLVMBuildMul(p->builder, x, y, "");
+			break;
+		case Token_Quo:
+			if (is_type_unsigned(integral_type)) {
+				z = LLVMBuildUDiv(p->builder, x, y, "");
+			} else {
+				z = LLVMBuildSDiv(p->builder, x, y, "");
+			}
+			break;
+		case Token_Mod:
+			if (is_type_unsigned(integral_type)) {
+				z = LLVMBuildURem(p->builder, x, y, "");
+			} else {
+				z = LLVMBuildSRem(p->builder, x, y, "");
+			}
+			break;
+		case Token_ModMod:
+			if (is_type_unsigned(integral_type)) {
+				z = LLVMBuildURem(p->builder, x, y, "");
+			} else {
+				LLVMValueRef a = LLVMBuildSRem(p->builder, x, y, "");
+				LLVMValueRef b = LLVMBuildAdd(p->builder, a, y, "");
+				z = LLVMBuildSRem(p->builder, b, y, "");
+			}
+			break;
+		case Token_And:
+			z = LLVMBuildAnd(p->builder, x, y, "");
+			break;
+		case Token_AndNot:
+			z = LLVMBuildAnd(p->builder, x, LLVMBuildNot(p->builder, y, ""), "");
+			break;
+		case Token_Or:
+			z = LLVMBuildOr(p->builder, x, y, "");
+			break;
+		case Token_Xor:
+			z = LLVMBuildXor(p->builder, x, y, "");
+			break;
+		default:
+			GB_PANIC("Unsupported vector operation");
+			break;
+		}
+	}
+	return z;
+}
+
 bool lb_try_direct_vector_arith(lbProcedure *p, TokenKind op, lbValue lhs, lbValue rhs, Type *type, lbValue *res_) {
 	GB_ASSERT(is_type_array_like(type));
 	Type *elem_type = base_array_type(type);
@@ -251,94 +342,7 @@ bool lb_try_direct_vector_arith(lbProcedure *p, TokenKind op, lbValue lhs, lbVal
 		LLVMValueRef rhs_vp = LLVMBuildPointerCast(p->builder, rhs_ptr.value, LLVMPointerType(vector_type, 0), "");
 		LLVMValueRef x = LLVMBuildLoad2(p->builder, vector_type, lhs_vp, "");
 		LLVMValueRef y = LLVMBuildLoad2(p->builder, vector_type, rhs_vp, "");
-		LLVMValueRef z = nullptr;
-
-		Type *integral_type = base_type(elem_type);
-		if (is_type_simd_vector(integral_type)) {
-			integral_type = core_array_type(integral_type);
-		}
-		if (is_type_bit_set(integral_type)) {
-			switch (op) {
-			case Token_Add: op = Token_Or;     break;
-			case Token_Sub: op = Token_AndNot; break;
-			}
-		}
-
-		if (is_type_float(integral_type)) {
-			switch (op) {
-			case Token_Add:
-				z = LLVMBuildFAdd(p->builder, x, y, "");
-				break;
-			case Token_Sub:
-				z = LLVMBuildFSub(p->builder, x, y, "");
-				break;
-			case Token_Mul:
-				z = LLVMBuildFMul(p->builder, x, y, "");
-				break;
-			case Token_Quo:
-				z = LLVMBuildFDiv(p->builder, x, y, "");
-				break;
-			case Token_Mod:
-				z = LLVMBuildFRem(p->builder, x, y, "");
-				break;
-			default:
-				GB_PANIC("Unsupported vector operation");
-				break;
-			}
-
-		} else {
-
-			switch (op) {
-			case Token_Add:
-				z = LLVMBuildAdd(p->builder, x, y, "");
-				break;
-			case Token_Sub:
-				z = LLVMBuildSub(p->builder, x, y, "");
-				break;
-			case Token_Mul:
-				z = LLVMBuildMul(p->builder, x, y, "");
-				break;
-			case Token_Quo:
-				if (is_type_unsigned(integral_type)) {
-					z = LLVMBuildUDiv(p->builder, x, y, "");
-				} else {
-					z = LLVMBuildSDiv(p->builder, x, y, "");
-				}
-				break;
-			case Token_Mod:
-				if (is_type_unsigned(integral_type)) {
-					z = LLVMBuildURem(p->builder, x, y, "");
-				} else {
-					z = LLVMBuildSRem(p->builder, x, y, "");
-				}
-				break;
-			case Token_ModMod:
-				if (is_type_unsigned(integral_type)) {
-					z = LLVMBuildURem(p->builder, x, y, "");
-				} else {
-					LLVMValueRef a = LLVMBuildSRem(p->builder, x, y, "");
-					LLVMValueRef b = LLVMBuildAdd(p->builder, a, y, "");
-					z = LLVMBuildSRem(p->builder, b, y, "");
-				}
-				break;
-			case Token_And:
-				z = LLVMBuildAnd(p->builder, x, y, "");
-				break;
-			case Token_AndNot:
-				z = LLVMBuildAnd(p->builder, x, LLVMBuildNot(p->builder, y, ""), "");
-				break;
-			case Token_Or:
-				z = LLVMBuildOr(p->builder, x, y, "");
-				break;
-			case Token_Xor:
-				z = LLVMBuildXor(p->builder, x, y, "");
-				break;
-			default:
-				GB_PANIC("Unsupported vector operation");
-				break;
-			}
-		}
-
+		LLVMValueRef z = lb_emit_vector_arith_values(p, op, x, y, elem_type);
 
 		if (z != nullptr) {
 			lbAddr res = lb_add_local_generated_temp(p, type, lb_alignof(vector_type));
@@ -355,6 +359,73 @@ bool lb_try_direct_vector_arith(lbProcedure *p, TokenKind op, lbValue lhs, lbVal
 }
 
 
+// NOTE: For arrays too large to be a single vector, apply `op` in vectors of the target's natural
+// width (max_align bytes) followed by a scalar tail; `dst` may alias either operand
+bool lb_try_chunked_vector_arith(lbProcedure *p, TokenKind op, lbValue dst, lbValue lhs_ptr, lbValue rhs_ptr, Type *array_type) {
+	lbModule *m = p->module;
+	Type *elem_type = base_array_type(array_type);
+	if (!is_type_valid_vector_elem(elem_type)) {
+		return false;
+	}
+	if (is_type_float(elem_type)) {
+		switch (op) {
+		case Token_Add:
+		case Token_Sub:
+		case Token_Mul:
+		case Token_Quo:
+		case Token_Mod:
+			break;
+		default:
+			return false;
+		}
+	} else if (op == Token_Shl || op == Token_Shr) {
+		return false;
+	}
+
+	i64 elem_size = type_size_of(elem_type);
+	if (elem_size <= 0 || elem_size > 8) {
+		return false;
+	}
+	i64 lanes = build_context.max_align / elem_size;
+	i64 count = get_array_type_count(array_type);
+	if (lanes < 2 || count < lanes) {
+		return false;
+	}
+	i64 chunks = count / lanes;
+
+	LLVMTypeRef vector_type = LLVMVectorType(lb_type(m, elem_type), cast(unsigned)lanes);
+	LLVMTypeRef vector_ptr_type = LLVMPointerType(vector_type, 0);
+	unsigned alignment = cast(unsigned)type_align_of(elem_type);
+
+	auto loop_data = lb_loop_start(p, cast(isize)chunks, t_i32);
+	{
+		lbValue index = lb_emit_arith(p, Token_Mul, loop_data.idx, lb_const_int(m, t_i32, lanes), t_i32);
+
+		LLVMValueRef x_ptr = LLVMBuildPointerCast(p->builder, lb_emit_array_ep(p, lhs_ptr, index).value, vector_ptr_type, "");
+		LLVMValueRef y_ptr = LLVMBuildPointerCast(p->builder, lb_emit_array_ep(p, rhs_ptr, index).value, vector_ptr_type, "");
+		LLVMValueRef z_ptr = LLVMBuildPointerCast(p->builder, lb_emit_array_ep(p, dst,     index).value, vector_ptr_type, "");
+
+		LLVMValueRef x = LLVMBuildLoad2(p->builder, vector_type, x_ptr, "");
+		LLVMValueRef y = LLVMBuildLoad2(p->builder, vector_type, y_ptr, "");
+		LLVMSetAlignment(x, alignment);
+		LLVMSetAlignment(y, alignment);
+
+		LLVMValueRef z = lb_emit_vector_arith_values(p, op, x, y, elem_type);
+		LLVMValueRef store = LLVMBuildStore(p->builder, z, z_ptr);
+		LLVMSetAlignment(store, alignment);
+	}
+	lb_loop_end(p, loop_data);
+
+	for (i64 i = chunks*lanes; i < count; i++) {
+		lbValue a = lb_emit_load(p, lb_emit_array_epi(p, lhs_ptr, cast(isize)i));
+		lbValue b = lb_emit_load(p, lb_emit_array_epi(p, rhs_ptr, cast(isize)i));
+		lbValue c = lb_emit_arith(p, op, a, b, elem_type);
+		lb_emit_store(p, lb_emit_array_epi(p, dst, cast(isize)i), c);
+	}
+	return true;
+}
+
+
 lbValue lb_emit_arith_array(lbProcedure *p, TokenKind op, lbValue lhs, lbValue rhs, Type *type) {
 	GB_ASSERT(is_type_array_like(lhs.type) || is_type_array_like(rhs.type));
 
@@ -410,6 +481,10 @@ lbValue lb_emit_arith_array(lbProcedure *p, TokenKind op, lbValue lhs, lbValue r
 
 		lbAddr res = lb_add_local_generated(p, type, false);
 
+		if (lb_try_chunked_vector_arith(p, op, res.addr, x, y, type)) {
+			return lb_addr_load(p, res);
+		}
+
 		auto loop_data = lb_loop_start(p, cast(isize)count, t_i32);
 
 		lbValue a_ptr = lb_emit_array_ep(p, x, loop_data.idx);
@@ -1419,18 +1494,70 @@ lbValue lb_emit_conv(lbProcedure *p, lbValue value, Type *t) {
 	return {};
 }
 
+// NOTE: Simple compare records up to this size are compared with inline loads rather than a runtime call
+#define LB_INLINE_MEMORY_EQUAL_MAX_SIZE 64
+
+lbValue lb_emit_inline_memory_equal(lbProcedure *p, TokenKind op_kind, lbValue left_ptr, lbValue right_ptr, i64 size, i64 align) {
+	GB_ASSERT(0 < size && size <= LB_INLINE_MEMORY_EQUAL_MAX_SIZE);
+	LLVMContextRef ctx = p->module->ctx;
+
+	// NOTE: Power of two sizes up to 16 bytes are a single integer compare; anything else is
+	// compared as a byte vector whose lane mask must be all ones
+	LLVMTypeRef load_type = nullptr;
+	switch (size) {
+	case 1: case 2: case 4: case 8: case 16:
+		load_type = LLVMIntTypeInContext(ctx, cast(unsigned)(8*size));
+		break;
+	default:
+		load_type = LLVMVectorType(LLVMInt8TypeInContext(ctx), cast(unsigned)size);
+		break;
+	}
+
+	LLVMValueRef lhs_ptr = LLVMBuildPointerCast(p->builder, left_ptr.value,  LLVMPointerType(load_type, 0), "");
+	LLVMValueRef rhs_ptr = LLVMBuildPointerCast(p->builder, right_ptr.value, LLVMPointerType(load_type, 0), "");
+	LLVMValueRef x = LLVMBuildLoad2(p->builder, load_type, lhs_ptr, "");
+	LLVMValueRef y = LLVMBuildLoad2(p->builder, load_type, rhs_ptr, "");
+	LLVMSetAlignment(x, cast(unsigned)align);
+	LLVMSetAlignment(y, cast(unsigned)align);
+
+	LLVMIntPredicate pred = op_kind == Token_NotEq ? LLVMIntNE : LLVMIntEQ;
+
+	lbValue res = {};
+	res.type = t_llvm_bool;
+	if (LLVMGetTypeKind(load_type) == LLVMIntegerTypeKind) {
+		res.value = LLVMBuildICmp(p->builder, pred, x, y, "");
+	} else {
+		LLVMTypeRef mask_type = LLVMIntTypeInContext(ctx, cast(unsigned)size);
+		LLVMValueRef lanes = LLVMBuildICmp(p->builder, LLVMIntEQ, x, y, "");
+		LLVMValueRef mask = LLVMBuildBitCast(p->builder, lanes, mask_type, "");
+		res.value = LLVMBuildICmp(p->builder, pred, mask, LLVMConstAllOnes(mask_type), "");
+	}
+	return res;
+}
+
 lbValue lb_compare_records(lbProcedure *p, TokenKind op_kind, lbValue left, lbValue right, Type *type) {
 	GB_ASSERT((is_type_struct(type) || is_type_union(type)) && is_type_comparable(type));
 	lbValue left_ptr  = lb_address_from_load_or_generate_local(p, left);
 	lbValue right_ptr = lb_address_from_load_or_generate_local(p, right);
 	lbValue res = {};
 	if (is_type_simple_compare(type)) {
-		// TODO(bill): Test to see if this is actually faster!!!!
+		i64 size  = type_size_of(type);
+		i64 align = type_align_of(type);
+		if (0 < size && size <= LB_INLINE_MEMORY_EQUAL_MAX_SIZE) {
+			return lb_emit_inline_memory_equal(p, op_kind, left_ptr, right_ptr, size, align);
+		}
+
+		// NOTE: Word aligned records can skip the byte tail and ordering of memory_compare
+		char const *name = "memory_equal";
+		i64 word_size = build_context.word_size;
+		if (size % word_size == 0 && align >= word_size) {
+			name = "memory_equal_words";
+		}
 		auto args = array_make<lbValue>(permanent_allocator(), 3);
 		args[0] = lb_emit_conv(p, left_ptr, t_rawptr);
 		args[1] = lb_emit_conv(p, right_ptr, t_rawptr);
-		args[2] = lb_const_int(p->module, t_int, type_size_of(type));
-		res = lb_emit_runtime_call(p, "memory_equal", args);
+		args[2] = lb_const_int(p->module, t_int, size);
+		res = lb_emit_runtime_call(p, name, args);
 	} else {
 		lbValue value = lb_get_equal_proc_for_type(p->module, type);
 		auto args = array_make<lbValue>(permanent_allocator(), 2);
@@ -1,6 +1,8 @@
 void lb_add_debug_local_variable(lbProcedure *p, LLVMValueRef ptr, Type *type, Token const &token);
 
 gb_global ThreadPool lb_thread_pool = {};
+gb_global BlockingMutex lb_entity_name_mutex = {};
+gb_global Map<Entity *> lb_entity_name_suffixes = {}; // Key: u64, guarded by lb_entity_name_mutex
 
 gb_global Entity *lb_global_type_info_data_entity   = {};
 gb_global lbAddr lb_global_type_info_member_types   = {};
@@ -16,6 +18,13 @@ gb_global isize lb_global_type_info_member_offsets_index = 0;
 gb_global isize lb_global_type_info_member_usings_index  = 0;
 gb_global isize lb_global_type_info_member_tags_index    = 0;
 
+// NOTE: The constant initializers of the member arrays, filled in by lb_setup_type_info_data
+gb_global LLVMValueRef *lb_global_type_info_member_types_values   = nullptr;
+gb_global LLVMValueRef *lb_global_type_info_member_names_values   = nullptr;
+gb_global LLVMValueRef *lb_global_type_info_member_offsets_values = nullptr;
+gb_global LLVMValueRef *lb_global_type_info_member_usings_values  = nullptr;
+gb_global LLVMValueRef *lb_global_type_info_member_tags_values    = nullptr;
+
 
 void lb_init_module(lbModule *m, Checker *c) {
 	m->info = &c->info;
@@ -125,7 +134,11 @@ bool lb_init_generator(lbGenerator *gen, Checker *c) {
 
 	map_init(&gen->modules, permanent_allocator(), gen->info->packages.entries.count*2);
 	map_init(&gen->modules_through_ctx, permanent_allocator(), gen->info->packages.entries.count*2);
+	mutex_init(&gen->anonymous_proc_lits_mutex, "anonymous_proc_lits_mutex");
 	map_init(&gen->anonymous_proc_lits, heap_allocator(), 1024);
+	mutex_init(&gen->entities_to_correct_linkage_mutex, "entities_to_correct_linkage_mutex");
+	array_init(&gen->entities_to_correct_linkage, heap_allocator());
+	map_init(&lb_entity_name_suffixes, heap_allocator(), 1024);
 
 	if (USE_SEPARATE_MODULES) {
 		for_array(i, gen->info->packages.entries) {
@@ -1171,6 +1184,48 @@ LLVMTypeRef lb_alignment_prefix_type_hack(lbModule *m, i64 alignment) {
 	return nullptr;
 }
 
+// NOTE: Entity ids depend upon the order in which the (possibly threaded) checker made the entities, so the
+// suffix is a hash of where the entity was declared, and of its type to tell the instances of a polymorphic
+// procedure apart. The suffix only changes when the source does, which -object-cache relies upon.
+// The caller must hold lb_entity_name_mutex
+u64 lb_entity_name_suffix(Entity *e) {
+	u64 h = fnv64a(e->token.string.text, e->token.string.len);
+	AstFile *file = e->file;
+	if (file == nullptr) {
+		file = get_ast_file_from_id(e->token.pos.file_id);
+	}
+	if (file != nullptr) {
+		h = hash_combine_u64(h, fnv64a(file->fullpath.text, file->fullpath.len));
+	}
+	h = hash_combine_u64(h, cast(u64)e->token.pos.offset);
+
+	Type *types[2] = {e->type, nullptr};
+	if (e->parent_proc_decl != nullptr && e->parent_proc_decl->entity != nullptr) {
+		types[1] = e->parent_proc_decl->entity->type;
+	}
+	for (isize i = 0; i < gb_count_of(types); i++) {
+		if (types[i] != nullptr) {
+			gbString str = type_to_string(types[i]);
+			h = hash_combine_u64(h, fnv64a(str, gb_string_length(str)));
+			gb_string_free(str);
+		}
+	}
+
+	// NOTE: Two entities which only differ in ways that the above does not see (e.g. types of the same name
+	// declared in different procedures) take the next free suffix
+	for (;;) {
+		Entity **found = map_get(&lb_entity_name_suffixes, hash_integer(h));
+		if (found == nullptr) {
+			map_set(&lb_entity_name_suffixes, hash_integer(h), e);
+			return h;
+		}
+		if (*found == e) {
+			return h;
+		}
+		h += 1;
+	}
+}
+
 String lb_mangle_name(lbModule *m, Entity *e) {
 	String name = e->token.string;
 
@@ -1205,7 +1260,7 @@ String lb_mangle_name(lbModule *m, Entity *e) {
 	if (require_suffix_id) {
 		char *str = new_name + new_name_len-1;
 		isize len = max_len-new_name_len;
-		isize extra = gb_snprintf(str, len, "-%llu", cast(unsigned long long)e->id);
+		isize extra = gb_snprintf(str, len, "-%llx", cast(unsigned long long)lb_entity_name_suffix(e));
 		new_name_len += extra-1;
 	}
 
@@ -1213,76 +1268,69 @@ String lb_mangle_name(lbModule *m, Entity *e) {
 	return mangled_name;
 }
 
-String lb_set_nested_type_name_ir_mangled_name(Entity *e, lbProcedure *p) {
+String lb_set_nested_type_name_ir_mangled_name(Entity *e) {
 	// NOTE(bill, 2020-03-08): A polymorphic procedure may take a nested type declaration
 	// and as a result, the declaration does not have time to determine what it should be
 
 	GB_ASSERT(e != nullptr && e->kind == Entity_TypeName);
+	mutex_lock(&lb_entity_name_mutex);
+	defer (mutex_unlock(&lb_entity_name_mutex));
+
 	if (e->TypeName.ir_mangled_name.len != 0)  {
 		return e->TypeName.ir_mangled_name;
 	}
 	GB_ASSERT((e->scope->flags & ScopeFlag_File) == 0);
 
-	if (p == nullptr) {
-		Entity *proc = nullptr;
-		if (e->parent_proc_decl != nullptr) {
-			proc = e->parent_proc_decl->entity;
-		} else {
-			Scope *scope = e->scope;
-			while (scope != nullptr && (scope->flags & ScopeFlag_Proc) == 0) {
-				scope = scope->parent;
-			}
-			GB_ASSERT(scope != nullptr);
-			GB_ASSERT(scope->flags & ScopeFlag_Proc);
-			proc = scope->procedure_entity;
+	// NOTE: The name only depends upon the entity, not upon which procedure (possibly in another module)
+	// happened to need the type first
+	Entity *proc = nullptr;
+	if (e->parent_proc_decl != nullptr) {
+		proc = e->parent_proc_decl->entity;
+	} else {
+		Scope *scope = e->scope;
+		while (scope != nullptr && (scope->flags & ScopeFlag_Proc) == 0) {
+			scope = scope->parent;
 		}
-		GB_ASSERT(proc->kind == Entity_Procedure);
-		if (proc->code_gen_procedure != nullptr) {
-			p = proc->code_gen_procedure;
+		if (scope != nullptr) {
+			proc = scope->procedure_entity;
 		}
 	}
+	String proc_name = str_lit("_internal");
+	if (proc != nullptr) {
+		proc_name = proc->token.string;
+	}
 
 	// NOTE(bill): Generate a new name
-	// parent_proc.name-guid
+	// parent_proc.name-suffix
 	String ts_name = e->token.string;
+	isize name_len = proc_name.len + 1 + ts_name.len + 1 + 16 + 1;
+	char *name_text = gb_alloc_array(permanent_allocator(), char, name_len);
+	u64 suffix = lb_entity_name_suffix(e);
+	name_len = gb_snprintf(name_text, name_len, "%.*s.%.*s-%llx", LIT(proc_name), LIT(ts_name), cast(unsigned long long)suffix);
 
-	if (p != nullptr) {
-		isize name_len = p->name.len + 1 + ts_name.len + 1 + 10 + 1;
-		char *name_text = gb_alloc_array(permanent_allocator(), char, name_len);
-		u32 guid = ++p->module->nested_type_name_guid;
-		name_len = gb_snprintf(name_text, name_len, "%.*s.%.*s-%u", LIT(p->name), LIT(ts_name), guid);
-
-		String name = make_string(cast(u8 *)name_text, name_len-1);
-		e->TypeName.ir_mangled_name = name;
-		return name;
-	} else {
-		// NOTE(bill): a nested type be required before its parameter procedure exists. Just give it a temp name for now
-		isize name_len = 9 + 1 + ts_name.len + 1 + 10 + 1;
-		char *name_text = gb_alloc_array(permanent_allocator(), char, name_len);
-		static u32 guid = 0;
-		guid += 1;
-		name_len = gb_snprintf(name_text, name_len, "_internal.%.*s-%u", LIT(ts_name), guid);
-
-		String name = make_string(cast(u8 *)name_text, name_len-1);
-		e->TypeName.ir_mangled_name = name;
-		return name;
-	}
+	String name = make_string(cast(u8 *)name_text, name_len-1);
+	e->TypeName.ir_mangled_name = name;
+	return name;
 }
 
 String lb_get_entity_name(lbModule *m, Entity *e, String default_name) {
-	if (e != nullptr && e->kind == Entity_TypeName && e->TypeName.ir_mangled_name.len != 0) {
+	GB_ASSERT(e != nullptr);
+	if (e->kind == Entity_TypeName && e->pkg != nullptr && (e->scope->flags & ScopeFlag_File) == 0) {
+		return lb_set_nested_type_name_ir_mangled_name(e);
+	}
+
+	// NOTE: The mangled name is cached on the entity which may be shared between modules generated on different threads
+	mutex_lock(&lb_entity_name_mutex);
+	defer (mutex_unlock(&lb_entity_name_mutex));
+
+	if (e->kind == Entity_TypeName && e->TypeName.ir_mangled_name.len != 0) {
 		return e->TypeName.ir_mangled_name;
 	}
-	GB_ASSERT(e != nullptr);
 
 	if (e->pkg == nullptr) {
 		return e->token.string;
 	}
 
-	if (e->kind == Entity_TypeName && (e->scope->flags & ScopeFlag_File) == 0) {
-		return lb_set_nested_type_name_ir_mangled_name(e, nullptr);
-	}
-
 	String name = {};
 
 	bool no_name_mangle = false;
@@ -2196,7 +2244,7 @@ LLVMValueRef lb_find_or_add_entity_string_ptr(lbModule *m, String const &str) {
 		isize max_len = 7+8+1;
 		char *name = gb_alloc_array(permanent_allocator(), char, max_len);
 
-		u32 id = m->gen->global_array_index.fetch_add(1);
+		u32 id = m->global_array_index.fetch_add(1);
 		isize len = gb_snprintf(name, max_len, "csbs$%x", id);
 		len -= 1;
 
@@ -2238,7 +2286,7 @@ lbValue lb_find_or_add_entity_string_byte_slice(lbModule *m, String const &str)
 	{
 		isize max_len = 7+8+1;
 		name = gb_alloc_array(permanent_allocator(), char, max_len);
-		u32 id = m->gen->global_array_index.fetch_add(1);
+		u32 id = m->global_array_index.fetch_add(1);
 		isize len = gb_snprintf(name, max_len, "csbs$%x", id);
 		len -= 1;
 	}
@@ -2350,7 +2398,7 @@ lbAddr lb_add_global_generated(lbModule *m, Type *type, lbValue value) {
 	isize max_len = 7+8+1;
 	u8 *str = cast(u8 *)gb_alloc_array(permanent_allocator(), u8, max_len);
 
-	u32 id = m->gen->global_generated_index.fetch_add(1);
+	u32 id = m->global_generated_index.fetch_add(1);
 
 	isize len = gb_snprintf(cast(char *)str, max_len, "ggv$%x", id);
 	String name = make_string(str, len-1);
@@ -2360,6 +2408,8 @@ lbAddr lb_add_global_generated(lbModule *m, Type *type, lbValue value) {
 	lbValue g = {};
 	g.type = alloc_type_pointer(type);
 	g.value = LLVMAddGlobal(m->mod, lb_type(m, type), cast(char const *)str);
+	// NOTE: Only ever referenced from within this module, and the name is only unique within it
+	LLVMSetLinkage(g.value, LLVMInternalLinkage);
 	if (value.value != nullptr) {
 		GB_ASSERT_MSG(LLVMIsConstant(value.value), LLVMPrintValueToString(value.value));
 		LLVMSetInitializer(g.value, value.value);
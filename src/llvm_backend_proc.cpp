@@ -28,8 +28,11 @@ lbProcedure *lb_create_procedure(lbModule *m, Entity *entity, bool ignore_body)
 	lbProcedure *p = gb_alloc_item(permanent_allocator(), lbProcedure);
 
 	p->module = m;
-	entity->code_gen_module = m;
-	entity->code_gen_procedure = p;
+	if (!ignore_body) {
+		// NOTE: Only the module which generates the body may claim the entity, as other modules may be generated in parallel
+		entity->code_gen_module = m;
+		entity->code_gen_procedure = p;
+	}
 	p->entity = entity;
 	p->name = link_name;
 
@@ -576,6 +579,8 @@ void lb_build_nested_proc(lbProcedure *p, AstProcLit *pd, Entity *e) {
 
 	// NOTE(bill): Generate a new name
 	// parent.name-guid
+	// NOTE: Other modules may read the link name through lb_get_entity_name in the meantime
+	mutex_lock(&lb_entity_name_mutex);
 	String original_name = e->token.string;
 	String pd_name = original_name;
 	if (e->Procedure.link_name.len > 0) {
@@ -591,6 +596,7 @@ void lb_build_nested_proc(lbProcedure *p, AstProcLit *pd, Entity *e) {
 	String name = make_string(cast(u8 *)name_text, name_len-1);
 
 	e->Procedure.link_name = name;
+	mutex_unlock(&lb_entity_name_mutex);
 
 	lbProcedure *nested_proc = lb_create_procedure(p->module, e);
 	e->code_gen_procedure = nested_proc;
@@ -56,12 +56,8 @@ void lb_build_constant_value_decl(lbProcedure *p, AstValueDecl *vd) {
 			continue;
 		}
 
-		if (e->TypeName.ir_mangled_name.len != 0) {
-			// NOTE(bill): Already set
-			continue;
-		}
-
-		lb_set_nested_type_name_ir_mangled_name(e, p);
+		// NOTE: Returns the name straight away if it has been set already
+		lb_set_nested_type_name_ir_mangled_name(e);
 	}
 
 	for_array(i, vd->names) {
@@ -107,9 +103,12 @@ void lb_build_constant_value_decl(lbProcedure *p, AstValueDecl *vd) {
 				lb_add_foreign_library_path(p->module, e->Procedure.foreign_library);
 			}
 
+			// NOTE: Other modules may read the link name through lb_get_entity_name in the meantime
+			mutex_lock(&lb_entity_name_mutex);
 			if (e->Procedure.link_name.len > 0) {
 				name = e->Procedure.link_name;
 			}
+			mutex_unlock(&lb_entity_name_mutex);
 
 			lbValue *prev_value = string_map_get(&p->module->members, name);
 			if (prev_value != nullptr) {
@@ -117,7 +116,9 @@ void lb_build_constant_value_decl(lbProcedure *p, AstValueDecl *vd) {
 				return;
 			}
 
+			mutex_lock(&lb_entity_name_mutex);
 			e->Procedure.link_name = name;
+			mutex_unlock(&lb_entity_name_mutex);
 
 			lbProcedure *nested_proc = lb_create_procedure(p->module, e);
 
@@ -1293,6 +1294,9 @@ void lb_build_type_switch_stmt(lbProcedure *p, AstTypeSwitchStmt *ss) {
 		}
 	} else if (switch_kind == TypeSwitch_Any) {
 		tag = lb_emit_load(p, lb_emit_struct_ep(p, parent_ptr, 1));
+		// NOTE: Switch on the type table index held in the low bits of the typeid alone. It is unique
+		// per type, and unlike the kind bits above it, dense enough for LLVM to build a jump table
+		tag.value = LLVMBuildAnd(p->builder, tag.value, lb_typeid_index_mask(m), "");
 	} else {
 		GB_PANIC("Unknown switch kind");
 	}
@@ -1339,6 +1343,7 @@ void lb_build_type_switch_stmt(lbProcedure *p, AstTypeSwitchStmt *ss) {
 
 			} else if (switch_kind == TypeSwitch_Any) {
 				on_val = lb_typeid(m, case_type);
+				on_val.value = LLVMConstAnd(on_val.value, lb_typeid_index_mask(m));
 			}
 			GB_ASSERT(on_val.value != nullptr);
 			LLVMAddCase(switch_instr, on_val.value, body->block);
@@ -1399,9 +1404,13 @@ void lb_build_static_variables(lbProcedure *p, AstValueDecl *vd) {
 
 		String mangled_name = {};
 		{
+			mutex_lock(&lb_entity_name_mutex);
+			u64 suffix = lb_entity_name_suffix(e);
+			mutex_unlock(&lb_entity_name_mutex);
+
 			gbString str = gb_string_make_length(permanent_allocator(), p->name.text, p->name.len);
 			str = gb_string_appendc(str, "-");
-			str = gb_string_append_fmt(str, ".%.*s-%llu", LIT(name), cast(long long)e->id);
+			str = gb_string_append_fmt(str, ".%.*s-%llx", LIT(name), cast(unsigned long long)suffix);
 			mangled_name.text = cast(u8 *)str;
 			mangled_name.len = gb_string_length(str);
 		}
@@ -1936,6 +1945,10 @@ void lb_build_assign_stmt_array(lbProcedure *p, TokenKind op, lbAddr const &lhs,
 	} else {
 		lbValue y = lb_address_from_load_or_generate_local(p, rhs);
 
+		if (lb_try_chunked_vector_arith(p, op, x, x, y, array_type)) {
+			return;
+		}
+
 		auto loop_data = lb_loop_start(p, cast(isize)count, t_i32);
 
 		lbValue a_ptr = lb_emit_array_ep(p, x, loop_data.idx);
@@ -87,6 +87,12 @@ lbValue lb_typeid(lbModule *m, Type *type) {
 	return res;
 }
 
+LLVMValueRef lb_typeid_index_mask(lbModule *m) {
+	// NOTE: Matches the index field layout in lb_typeid
+	u64 mask = (1ull<<(8*build_context.word_size - 8)) - 1;
+	return LLVMConstInt(lb_type(m, t_typeid), mask, false);
+}
+
 lbValue lb_type_info(lbModule *m, Type *type) {
 	type = default_type(type);
 
@@ -122,40 +128,87 @@ lbValue lb_get_type_info_ptr(lbModule *m, Type *type) {
 }
 
 
-lbValue lb_type_info_member_types_offset(lbProcedure *p, isize count) {
-	GB_ASSERT(p->module == &p->module->gen->default_module);
-	lbValue offset = lb_emit_array_epi(p, lb_global_type_info_member_types.addr, lb_global_type_info_member_types_index);
-	lb_global_type_info_member_types_index += cast(i32)count;
+isize lb_type_info_member_types_offset(isize count) {
+	isize offset = lb_global_type_info_member_types_index;
+	lb_global_type_info_member_types_index += count;
 	return offset;
 }
-lbValue lb_type_info_member_names_offset(lbProcedure *p, isize count) {
-	GB_ASSERT(p->module == &p->module->gen->default_module);
-	lbValue offset = lb_emit_array_epi(p, lb_global_type_info_member_names.addr, lb_global_type_info_member_names_index);
-	lb_global_type_info_member_names_index += cast(i32)count;
+isize lb_type_info_member_names_offset(isize count) {
+	isize offset = lb_global_type_info_member_names_index;
+	lb_global_type_info_member_names_index += count;
 	return offset;
 }
-lbValue lb_type_info_member_offsets_offset(lbProcedure *p, isize count) {
-	GB_ASSERT(p->module == &p->module->gen->default_module);
-	lbValue offset = lb_emit_array_epi(p, lb_global_type_info_member_offsets.addr, lb_global_type_info_member_offsets_index);
-	lb_global_type_info_member_offsets_index += cast(i32)count;
+isize lb_type_info_member_offsets_offset(isize count) {
+	isize offset = lb_global_type_info_member_offsets_index;
+	lb_global_type_info_member_offsets_index += count;
 	return offset;
 }
-lbValue lb_type_info_member_usings_offset(lbProcedure *p, isize count) {
-	GB_ASSERT(p->module == &p->module->gen->default_module);
-	lbValue offset = lb_emit_array_epi(p, lb_global_type_info_member_usings.addr, lb_global_type_info_member_usings_index);
-	lb_global_type_info_member_usings_index += cast(i32)count;
+isize lb_type_info_member_usings_offset(isize count) {
+	isize offset = lb_global_type_info_member_usings_index;
+	lb_global_type_info_member_usings_index += count;
 	return offset;
 }
-lbValue lb_type_info_member_tags_offset(lbProcedure *p, isize count) {
-	GB_ASSERT(p->module == &p->module->gen->default_module);
-	lbValue offset = lb_emit_array_epi(p, lb_global_type_info_member_tags.addr, lb_global_type_info_member_tags_index);
-	lb_global_type_info_member_tags_index += cast(i32)count;
+isize lb_type_info_member_tags_offset(isize count) {
+	isize offset = lb_global_type_info_member_tags_index;
+	lb_global_type_info_member_tags_index += count;
 	return offset;
 }
 
+lbValue lb_type_info_member_ptr(lbModule *m, lbAddr const &member_array, isize offset) {
+	GB_ASSERT(m == &m->gen->default_module);
+	return lb_const_array_epi(m, member_array.addr, offset);
+}
 
-void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info data
-	lbModule *m = p->module;
+LLVMValueRef *lb_type_info_member_values_make(lbModule *m, lbAddr const &member_array) {
+	if (member_array.addr.value == nullptr) {
+		return nullptr;
+	}
+	Type *t = base_type(type_deref(member_array.addr.type));
+	GB_ASSERT(t->kind == Type_Array);
+	LLVMValueRef *values = gb_alloc_array(permanent_allocator(), LLVMValueRef, t->Array.count);
+	LLVMValueRef zero = LLVMConstNull(lb_type(m, t->Array.elem));
+	for (i64 i = 0; i < t->Array.count; i++) {
+		values[i] = zero;
+	}
+	return values;
+}
+
+void lb_type_info_member_values_set_initializer(lbModule *m, lbAddr const &member_array, LLVMValueRef *values) {
+	if (member_array.addr.value == nullptr) {
+		return;
+	}
+	Type *t = base_type(type_deref(member_array.addr.type));
+	LLVMSetInitializer(member_array.addr.value, llvm_const_array(lb_type(m, t->Array.elem), values, t->Array.count));
+	LLVMSetGlobalConstant(member_array.addr.value, true);
+}
+
+// NOTE: Lays out `values` at their byte `offsets` (which must be ascending) as a packed constant of exactly `size` bytes,
+// zero filling any gaps in between. This allows for a constant of a union which is not of the union's first variant.
+LLVMValueRef lb_const_packed_at_offsets(lbModule *m, LLVMValueRef const *values, i64 const *offsets, isize count, i64 size) {
+	LLVMTargetDataRef target_data = LLVMGetModuleDataLayout(m->mod);
+	LLVMTypeRef u8_type = lb_type(m, t_u8);
+
+	LLVMValueRef *fields = gb_alloc_array(temporary_allocator(), LLVMValueRef, 2*count+1);
+	unsigned field_count = 0;
+	i64 curr_offset = 0;
+	for (isize i = 0; i < count; i++) {
+		GB_ASSERT(curr_offset <= offsets[i]);
+		if (curr_offset < offsets[i]) {
+			fields[field_count++] = LLVMConstNull(LLVMArrayType(u8_type, cast(unsigned)(offsets[i]-curr_offset)));
+		}
+		fields[field_count++] = values[i];
+		curr_offset = offsets[i] + cast(i64)LLVMABISizeOfType(target_data, LLVMTypeOf(values[i]));
+	}
+	GB_ASSERT_MSG(curr_offset <= size, "%lld <= %lld", cast(long long)curr_offset, cast(long long)size);
+	if (curr_offset < size) {
+		fields[field_count++] = LLVMConstNull(LLVMArrayType(u8_type, cast(unsigned)(size-curr_offset)));
+	}
+	return LLVMConstStructInContext(m->ctx, fields, field_count, true);
+}
+
+
+void lb_setup_type_info_data(lbModule *m) { // NOTE(bill): Setup type_info data
+	GB_ASSERT(m == &m->gen->default_module);
 	CheckerInfo *info = m->info;
 
 	{
@@ -179,32 +232,54 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 	Entity *type_info_flags_entity = find_core_entity(info->checker, str_lit("Type_Info_Flags"));
 	Type *t_type_info_flags = type_info_flags_entity->type;
 
-	for_array(type_info_type_index, info->type_info_types) {
-		Type *t = info->type_info_types[type_info_type_index];
-		if (t == nullptr || t == t_invalid) {
-			continue;
-		}
+	// NOTE: The whole table is built as constant data rather than being stored into at startup.
+	// As each entry's variant differs, an entry is a packed struct laid out exactly like a Type_Info
+	LLVMTargetDataRef target_data = LLVMGetModuleDataLayout(m->mod);
+	Type *t_type_info_variant = get_struct_field_type(t_type_info, 4);
+	GB_ASSERT(is_type_union(t_type_info_variant));
+	GB_ASSERT(!is_type_union_maybe_pointer(t_type_info_variant));
 
-		isize entry_index = lb_type_info_index(info, t, false);
-		if (entry_index <= 0) {
+	i64 const type_info_size = type_size_of(t_type_info);
+	GB_ASSERT(cast(i64)LLVMABISizeOfType(target_data, lb_type(m, t_type_info)) == type_info_size);
+
+	i64 type_info_offsets[6] = {};
+	for (i32 i = 0; i < 5; i++) {
+		type_info_offsets[i] = type_offset_of(t_type_info, i);
+	}
+	type_info_offsets[5] = type_info_offsets[4] + cast(i64)LLVMOffsetOfElement(target_data, lb_type(m, t_type_info_variant), 2);
+
+	isize type_info_count = base_type(lb_global_type_info_data_entity->type)->Array.count;
+	LLVMValueRef *type_info_entries = gb_alloc_array(permanent_allocator(), LLVMValueRef, type_info_count);
+	for (isize i = 0; i < type_info_count; i++) {
+		type_info_entries[i] = LLVMConstNull(lb_type(m, t_type_info));
+	}
+
+	lb_global_type_info_member_types_values   = lb_type_info_member_values_make(m, lb_global_type_info_member_types);
+	lb_global_type_info_member_names_values   = lb_type_info_member_values_make(m, lb_global_type_info_member_names);
+	lb_global_type_info_member_offsets_values = lb_type_info_member_values_make(m, lb_global_type_info_member_offsets);
+	lb_global_type_info_member_usings_values  = lb_type_info_member_values_make(m, lb_global_type_info_member_usings);
+	lb_global_type_info_member_tags_values    = lb_type_info_member_values_make(m, lb_global_type_info_member_tags);
+
+	// NOTE: Walked in the order of the table rather than of info->type_info_types, which the checker's threads
+	// add to in whatever order they get to the types, as the member arrays are handed out in this order
+	auto *type_info_set = &info->minimum_dependency_type_info_set;
+	for_array(set_index, type_info_set->entries) {
+		Type *t = info->type_info_types[type_info_set->entries[set_index].ptr];
+		if (t == nullptr || t == t_invalid) {
 			continue;
 		}
 
-		lbValue tag = {};
-		lbValue ti_ptr = lb_emit_array_epi(p, lb_global_type_info_data_ptr(m), cast(i32)entry_index);
-		lbValue variant_ptr = lb_emit_struct_ep(p, ti_ptr, 4);
+		isize entry_index = set_index+1;
 
-		lbValue type_info_flags = lb_const_int(p->module, t_type_info_flags, type_info_flags_of_type(t));
+		Type *tag_type = nullptr;
+		LLVMValueRef variant = nullptr;
 
-		lb_emit_store(p, lb_emit_struct_ep(p, ti_ptr, 0), lb_const_int(m, t_int, type_size_of(t)));
-		lb_emit_store(p, lb_emit_struct_ep(p, ti_ptr, 1), lb_const_int(m, t_int, type_align_of(t)));
-		lb_emit_store(p, lb_emit_struct_ep(p, ti_ptr, 2), type_info_flags);
-		lb_emit_store(p, lb_emit_struct_ep(p, ti_ptr, 3), lb_typeid(m, t));
+		lbValue type_info_flags = lb_const_int(m, t_type_info_flags, type_info_flags_of_type(t));
 
 
 		switch (t->kind) {
 		case Type_Named: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_named_ptr);
+			tag_type = t_type_info_named;
 
 			LLVMValueRef pkg_name = nullptr;
 			if (t->Named.type_name->pkg) {
@@ -222,19 +297,19 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			}
 			TokenPos pos = t->Named.type_name->token.pos;
 
-			lbValue loc = lb_emit_source_code_location(p, proc_name, pos);
+			lbValue loc = lb_const_source_code_location(m, proc_name, pos);
 
 			LLVMValueRef vals[4] = {
-				lb_const_string(p->module, t->Named.type_name->token.string).value,
+				lb_const_string(m, t->Named.type_name->token.string).value,
 				lb_get_type_info_ptr(m, t->Named.base).value,
 				pkg_name,
 				loc.value
 			};
 
 			lbValue res = {};
-			res.type = type_deref(tag.type);
+			res.type = tag_type;
 			res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-			lb_emit_store(p, tag, res);
+			variant = res.value;
 			break;
 		}
 
@@ -245,7 +320,7 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			case Basic_b16:
 			case Basic_b32:
 			case Basic_b64:
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_boolean_ptr);
+				tag_type = t_type_info_boolean;
 				break;
 
 			case Basic_i8:
@@ -279,7 +354,7 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			case Basic_int:
 			case Basic_uint:
 			case Basic_uintptr: {
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_integer_ptr);
+				tag_type = t_type_info_integer;
 
 				lbValue is_signed = lb_const_bool(m, t_bool, (t->Basic.flags & BasicFlag_Unsigned) == 0);
 				// NOTE(bill): This is matches the runtime layout
@@ -297,14 +372,14 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 				};
 
 				lbValue res = {};
-				res.type = type_deref(tag.type);
+				res.type = tag_type;
 				res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-				lb_emit_store(p, tag, res);
+				variant = res.value;
 				break;
 			}
 
 			case Basic_rune:
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_rune_ptr);
+				tag_type = t_type_info_rune;
 				break;
 
 			case Basic_f16:
@@ -317,7 +392,7 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			case Basic_f32be:
 			case Basic_f64be:
 				{
-					tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_float_ptr);
+					tag_type = t_type_info_float;
 
 					// NOTE(bill): This is matches the runtime layout
 					u8 endianness_value = 0;
@@ -333,58 +408,58 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 					};
 
 					lbValue res = {};
-					res.type = type_deref(tag.type);
+					res.type = tag_type;
 					res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-					lb_emit_store(p, tag, res);
+					variant = res.value;
 				}
 				break;
 
 			case Basic_complex32:
 			case Basic_complex64:
 			case Basic_complex128:
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_complex_ptr);
+				tag_type = t_type_info_complex;
 				break;
 
 			case Basic_quaternion64:
 			case Basic_quaternion128:
 			case Basic_quaternion256:
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_quaternion_ptr);
+				tag_type = t_type_info_quaternion;
 				break;
 
 			case Basic_rawptr:
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_pointer_ptr);
+				tag_type = t_type_info_pointer;
 				break;
 
 			case Basic_string:
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_string_ptr);
+				tag_type = t_type_info_string;
 				break;
 
 			case Basic_cstring:
 				{
-					tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_string_ptr);
+					tag_type = t_type_info_string;
 					LLVMValueRef vals[1] = {
 						lb_const_bool(m, t_bool, true).value,
 					};
 
 					lbValue res = {};
-					res.type = type_deref(tag.type);
+					res.type = tag_type;
 					res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-					lb_emit_store(p, tag, res);
+					variant = res.value;
 				}
 				break;
 
 			case Basic_any:
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_any_ptr);
+				tag_type = t_type_info_any;
 				break;
 
 			case Basic_typeid:
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_typeid_ptr);
+				tag_type = t_type_info_typeid;
 				break;
 			}
 			break;
 
 		case Type_Pointer: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_pointer_ptr);
+			tag_type = t_type_info_pointer;
 			lbValue gep = lb_get_type_info_ptr(m, t->Pointer.elem);
 
 			LLVMValueRef vals[1] = {
@@ -392,13 +467,13 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			};
 
 			lbValue res = {};
-			res.type = type_deref(tag.type);
+			res.type = tag_type;
 			res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-			lb_emit_store(p, tag, res);
+			variant = res.value;
 			break;
 		}
 		case Type_MultiPointer: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_multi_pointer_ptr);
+			tag_type = t_type_info_multi_pointer;
 			lbValue gep = lb_get_type_info_ptr(m, t->MultiPointer.elem);
 
 			LLVMValueRef vals[1] = {
@@ -406,13 +481,13 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			};
 
 			lbValue res = {};
-			res.type = type_deref(tag.type);
+			res.type = tag_type;
 			res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-			lb_emit_store(p, tag, res);
+			variant = res.value;
 			break;
 		}
 		case Type_Array: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_array_ptr);
+			tag_type = t_type_info_array;
 			i64 ez = type_size_of(t->Array.elem);
 
 			LLVMValueRef vals[3] = {
@@ -422,13 +497,13 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			};
 
 			lbValue res = {};
-			res.type = type_deref(tag.type);
+			res.type = tag_type;
 			res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-			lb_emit_store(p, tag, res);
+			variant = res.value;
 			break;
 		}
 		case Type_EnumeratedArray: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_enumerated_array_ptr);
+			tag_type = t_type_info_enumerated_array;
 
 			LLVMValueRef vals[6] = {
 				lb_get_type_info_ptr(m, t->EnumeratedArray.elem).value,
@@ -436,29 +511,18 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 				lb_const_int(m, t_int, type_size_of(t->EnumeratedArray.elem)).value,
 				lb_const_int(m, t_int, t->EnumeratedArray.count).value,
 
-				// Unions
-				LLVMConstNull(lb_type(m, t_type_info_enum_value)),
-				LLVMConstNull(lb_type(m, t_type_info_enum_value)),
+				lb_const_value(m, t_i64, t->EnumeratedArray.min_value).value,
+				lb_const_value(m, t_i64, t->EnumeratedArray.max_value).value,
 			};
 
 			lbValue res = {};
-			res.type = type_deref(tag.type);
+			res.type = tag_type;
 			res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-			lb_emit_store(p, tag, res);
-
-			// NOTE(bill): Union assignment
-			lbValue min_value = lb_emit_struct_ep(p, tag, 4);
-			lbValue max_value = lb_emit_struct_ep(p, tag, 5);
-
-			lbValue min_v = lb_const_value(m, t_i64, t->EnumeratedArray.min_value);
-			lbValue max_v = lb_const_value(m, t_i64, t->EnumeratedArray.max_value);
-
-			lb_emit_store(p, min_value, min_v);
-			lb_emit_store(p, max_value, max_v);
+			variant = res.value;
 			break;
 		}
 		case Type_DynamicArray: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_dynamic_array_ptr);
+			tag_type = t_type_info_dynamic_array;
 
 			LLVMValueRef vals[2] = {
 				lb_get_type_info_ptr(m, t->DynamicArray.elem).value,
@@ -466,13 +530,13 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			};
 
 			lbValue res = {};
-			res.type = type_deref(tag.type);
+			res.type = tag_type;
 			res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-			lb_emit_store(p, tag, res);
+			variant = res.value;
 			break;
 		}
 		case Type_Slice: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_slice_ptr);
+			tag_type = t_type_info_slice;
 
 			LLVMValueRef vals[2] = {
 				lb_get_type_info_ptr(m, t->Slice.elem).value,
@@ -480,13 +544,13 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			};
 
 			lbValue res = {};
-			res.type = type_deref(tag.type);
+			res.type = tag_type;
 			res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-			lb_emit_store(p, tag, res);
+			variant = res.value;
 			break;
 		}
 		case Type_Proc: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_procedure_ptr);
+			tag_type = t_type_info_procedure;
 
 			LLVMValueRef params = LLVMConstNull(lb_type(m, t_type_info_ptr));
 			LLVMValueRef results = LLVMConstNull(lb_type(m, t_type_info_ptr));
@@ -505,34 +569,31 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			};
 
 			lbValue res = {};
-			res.type = type_deref(tag.type);
+			res.type = tag_type;
 			res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-			lb_emit_store(p, tag, res);
+			variant = res.value;
 			break;
 		}
 		case Type_Tuple: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_tuple_ptr);
-
+			tag_type = t_type_info_tuple;
 
-			lbValue memory_types = lb_type_info_member_types_offset(p, t->Tuple.variables.count);
-			lbValue memory_names = lb_type_info_member_names_offset(p, t->Tuple.variables.count);
 
+			isize types_offset = lb_type_info_member_types_offset(t->Tuple.variables.count);
+			isize names_offset = lb_type_info_member_names_offset(t->Tuple.variables.count);
 
 			for_array(i, t->Tuple.variables) {
 				// NOTE(bill): offset is not used for tuples
 				Entity *f = t->Tuple.variables[i];
 
-				lbValue index     = lb_const_int(m, t_int, i);
-				lbValue type_info = lb_emit_ptr_offset(p, memory_types, index);
-
-				// TODO(bill): Make this constant if possible, 'lb_const_store' does not work
-				lb_emit_store(p, type_info, lb_type_info(m, f->type));
+				lb_global_type_info_member_types_values[types_offset+i] = lb_type_info(m, f->type).value;
 				if (f->token.string.len > 0) {
-					lbValue name = lb_emit_ptr_offset(p, memory_names, index);
-					lb_emit_store(p, name, lb_const_string(m, f->token.string));
+					lb_global_type_info_member_names_values[names_offset+i] = lb_const_string(m, f->token.string).value;
 				}
 			}
 
+			lbValue memory_types = lb_type_info_member_ptr(m, lb_global_type_info_member_types, types_offset);
+			lbValue memory_names = lb_type_info_member_ptr(m, lb_global_type_info_member_names, names_offset);
+
 			lbValue count = lb_const_int(m, t_int, t->Tuple.variables.count);
 
 			LLVMValueRef types_slice = llvm_const_slice(m, memory_types, count);
@@ -544,15 +605,15 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			};
 
 			lbValue res = {};
-			res.type = type_deref(tag.type);
+			res.type = tag_type;
 			res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-			lb_emit_store(p, tag, res);
+			variant = res.value;
 
 			break;
 		}
 
 		case Type_Enum:
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_enum_ptr);
+			tag_type = t_type_info_enum;
 
 			{
 				GB_ASSERT(t->Enum.base_type != nullptr);
@@ -583,11 +644,13 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 					LLVMValueRef value_init = llvm_const_array(lb_type(m, t_type_info_enum_value), value_values, cast(unsigned)fields.count);
 					LLVMSetInitializer(name_array.value,  name_init);
 					LLVMSetInitializer(value_array.value, value_init);
+					LLVMSetGlobalConstant(name_array.value, true);
+					LLVMSetGlobalConstant(value_array.value, true);
 
 					lbValue v_count = lb_const_int(m, t_int, fields.count);
 
-					vals[1] = llvm_const_slice(m, lb_array_elem(p, name_array), v_count);
-					vals[2] = llvm_const_slice(m, lb_array_elem(p, value_array), v_count);
+					vals[1] = llvm_const_slice(m, lb_const_array_epi(m, name_array, 0), v_count);
+					vals[2] = llvm_const_slice(m, lb_const_array_epi(m, value_array, 0), v_count);
 				} else {
 					vals[1] = LLVMConstNull(lb_type(m, base_type(t_type_info_enum)->Struct.fields[1]->type));
 					vals[2] = LLVMConstNull(lb_type(m, base_type(t_type_info_enum)->Struct.fields[2]->type));
@@ -595,30 +658,27 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 
 
 				lbValue res = {};
-				res.type = type_deref(tag.type);
+				res.type = tag_type;
 				res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-				lb_emit_store(p, tag, res);
+				variant = res.value;
 			}
 			break;
 
 		case Type_Union: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_union_ptr);
+			tag_type = t_type_info_union;
 
 			{
 				LLVMValueRef vals[7] = {};
 
 				isize variant_count = gb_max(0, t->Union.variants.count);
-				lbValue memory_types = lb_type_info_member_types_offset(p, variant_count);
+				isize types_offset = lb_type_info_member_types_offset(variant_count);
 
 				// NOTE(bill): Zeroth is nil so ignore it
 				for (isize variant_index = 0; variant_index < variant_count; variant_index++) {
 					Type *vt = t->Union.variants[variant_index];
-					lbValue tip = lb_get_type_info_ptr(m, vt);
-
-					lbValue index     = lb_const_int(m, t_int, variant_index);
-					lbValue type_info = lb_emit_ptr_offset(p, memory_types, index);
-					lb_emit_store(p, type_info, lb_type_info(m, vt));
+					lb_global_type_info_member_types_values[types_offset+variant_index] = lb_type_info(m, vt).value;
 				}
+				lbValue memory_types = lb_type_info_member_ptr(m, lb_global_type_info_member_types, types_offset);
 
 				lbValue count = lb_const_int(m, t_int, variant_count);
 				vals[0] = llvm_const_slice(m, memory_types, count);
@@ -644,21 +704,21 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 
 				for (isize i = 0; i < gb_count_of(vals); i++) {
 					if (vals[i] == nullptr) {
-						vals[i]  = LLVMConstNull(lb_type(m, get_struct_field_type(tag.type, i)));
+						vals[i]  = LLVMConstNull(lb_type(m, get_struct_field_type(tag_type, i)));
 					}
 				}
 
 				lbValue res = {};
-				res.type = type_deref(tag.type);
+				res.type = tag_type;
 				res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-				lb_emit_store(p, tag, res);
+				variant = res.value;
 			}
 
 			break;
 		}
 
 		case Type_Struct: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_struct_ptr);
+			tag_type = t_type_info_struct;
 
 			LLVMValueRef vals[12] = {};
 
@@ -676,8 +736,7 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 
 
 				if (t->Struct.soa_kind != StructSoa_None) {
-					lbValue kind = lb_emit_struct_ep(p, tag, 9);
-					Type *kind_type = type_deref(kind.type);
+					Type *kind_type = get_struct_field_type(tag_type, 9);
 
 					lbValue soa_kind = lb_const_value(m, kind_type, exact_value_i64(t->Struct.soa_kind));
 					lbValue soa_type = lb_type_info(m, t->Struct.soa_elem);
@@ -691,46 +750,44 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 
 			isize count = t->Struct.fields.count;
 			if (count > 0) {
-				lbValue memory_types   = lb_type_info_member_types_offset  (p, count);
-				lbValue memory_names   = lb_type_info_member_names_offset  (p, count);
-				lbValue memory_offsets = lb_type_info_member_offsets_offset(p, count);
-				lbValue memory_usings  = lb_type_info_member_usings_offset (p, count);
-				lbValue memory_tags    = lb_type_info_member_tags_offset   (p, count);
+				isize types_offset   = lb_type_info_member_types_offset  (count);
+				isize names_offset   = lb_type_info_member_names_offset  (count);
+				isize offsets_offset = lb_type_info_member_offsets_offset(count);
+				isize usings_offset  = lb_type_info_member_usings_offset (count);
+				isize tags_offset    = lb_type_info_member_tags_offset   (count);
 
 				type_set_offsets(t); // NOTE(bill): Just incase the offsets have not been set yet
 				for (isize source_index = 0; source_index < count; source_index++) {
 					// TODO(bill): Order fields in source order not layout order
 					Entity *f = t->Struct.fields[source_index];
-					lbValue tip = lb_get_type_info_ptr(m, f->type);
 					i64 foffset = 0;
 					if (!t->Struct.is_raw_union) {
 						foffset = t->Struct.offsets[f->Variable.field_index];
 					}
 					GB_ASSERT(f->kind == Entity_Variable && f->flags & EntityFlag_Field);
 
-					lbValue index     = lb_const_int(m, t_int, source_index);
-					lbValue type_info = lb_emit_ptr_offset(p, memory_types,   index);
-					lbValue offset    = lb_emit_ptr_offset(p, memory_offsets, index);
-					lbValue is_using  = lb_emit_ptr_offset(p, memory_usings,  index);
-
-					lb_emit_store(p, type_info, lb_type_info(m, f->type));
+					lb_global_type_info_member_types_values[types_offset+source_index] = lb_type_info(m, f->type).value;
 					if (f->token.string.len > 0) {
-						lbValue name = lb_emit_ptr_offset(p, memory_names,   index);
-						lb_emit_store(p, name, lb_const_string(m, f->token.string));
+						lb_global_type_info_member_names_values[names_offset+source_index] = lb_const_string(m, f->token.string).value;
 					}
-					lb_emit_store(p, offset, lb_const_int(m, t_uintptr, foffset));
-					lb_emit_store(p, is_using, lb_const_bool(m, t_bool, (f->flags&EntityFlag_Using) != 0));
+					lb_global_type_info_member_offsets_values[offsets_offset+source_index] = lb_const_int(m, t_uintptr, foffset).value;
+					lb_global_type_info_member_usings_values[usings_offset+source_index] = lb_const_bool(m, t_bool, (f->flags&EntityFlag_Using) != 0).value;
 
 					if (t->Struct.tags.count > 0) {
 						String tag_string = t->Struct.tags[source_index];
 						if (tag_string.len > 0) {
-							lbValue tag_ptr = lb_emit_ptr_offset(p, memory_tags, index);
-							lb_emit_store(p, tag_ptr, lb_const_string(m, tag_string));
+							lb_global_type_info_member_tags_values[tags_offset+source_index] = lb_const_string(m, tag_string).value;
 						}
 					}
 
 				}
 
+				lbValue memory_types   = lb_type_info_member_ptr(m, lb_global_type_info_member_types,   types_offset);
+				lbValue memory_names   = lb_type_info_member_ptr(m, lb_global_type_info_member_names,   names_offset);
+				lbValue memory_offsets = lb_type_info_member_ptr(m, lb_global_type_info_member_offsets, offsets_offset);
+				lbValue memory_usings  = lb_type_info_member_ptr(m, lb_global_type_info_member_usings,  usings_offset);
+				lbValue memory_tags    = lb_type_info_member_ptr(m, lb_global_type_info_member_tags,    tags_offset);
+
 				lbValue cv = lb_const_int(m, t_int, count);
 				vals[0] = llvm_const_slice(m, memory_types,   cv);
 				vals[1] = llvm_const_slice(m, memory_names,   cv);
@@ -740,21 +797,21 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			}
 			for (isize i = 0; i < gb_count_of(vals); i++) {
 				if (vals[i] == nullptr) {
-					vals[i]  = LLVMConstNull(lb_type(m, get_struct_field_type(tag.type, i)));
+					vals[i]  = LLVMConstNull(lb_type(m, get_struct_field_type(tag_type, i)));
 				}
 			}
 
 
 			lbValue res = {};
-			res.type = type_deref(tag.type);
+			res.type = tag_type;
 			res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-			lb_emit_store(p, tag, res);
+			variant = res.value;
 
 			break;
 		}
 
 		case Type_Map: {
-			tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_map_ptr);
+			tag_type = t_type_info_map;
 			init_map_internal_types(t);
 
 			LLVMValueRef vals[5] = {
@@ -766,15 +823,15 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 			};
 
 			lbValue res = {};
-			res.type = type_deref(tag.type);
+			res.type = tag_type;
 			res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-			lb_emit_store(p, tag, res);
+			variant = res.value;
 			break;
 		}
 
 		case Type_BitSet:
 			{
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_bit_set_ptr);
+				tag_type = t_type_info_bit_set;
 
 				GB_ASSERT(is_type_typed(t->BitSet.elem));
 
@@ -790,15 +847,15 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 				}
 
 				lbValue res = {};
-				res.type = type_deref(tag.type);
+				res.type = tag_type;
 				res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-				lb_emit_store(p, tag, res);
+				variant = res.value;
 			}
 			break;
 
 		case Type_SimdVector:
 			{
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_simd_vector_ptr);
+				tag_type = t_type_info_simd_vector;
 
 				LLVMValueRef vals[3] = {};
 
@@ -807,53 +864,93 @@ void lb_setup_type_info_data(lbProcedure *p) { // NOTE(bill): Setup type_info da
 				vals[2] = lb_const_int(m, t_int, t->SimdVector.count).value;
 
 				lbValue res = {};
-				res.type = type_deref(tag.type);
+				res.type = tag_type;
 				res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-				lb_emit_store(p, tag, res);
+				variant = res.value;
 			}
 			break;
 
 		case Type_RelativePointer:
 			{
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_relative_pointer_ptr);
+				tag_type = t_type_info_relative_pointer;
 				LLVMValueRef vals[2] = {
 					lb_get_type_info_ptr(m, t->RelativePointer.pointer_type).value,
 					lb_get_type_info_ptr(m, t->RelativePointer.base_integer).value,
 				};
 
 				lbValue res = {};
-				res.type = type_deref(tag.type);
+				res.type = tag_type;
 				res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-				lb_emit_store(p, tag, res);
+				variant = res.value;
 			}
 			break;
 		case Type_RelativeSlice:
 			{
-				tag = lb_const_ptr_cast(m, variant_ptr, t_type_info_relative_slice_ptr);
+				tag_type = t_type_info_relative_slice;
 				LLVMValueRef vals[2] = {
 					lb_get_type_info_ptr(m, t->RelativeSlice.slice_type).value,
 					lb_get_type_info_ptr(m, t->RelativeSlice.base_integer).value,
 				};
 
 				lbValue res = {};
-				res.type = type_deref(tag.type);
+				res.type = tag_type;
 				res.value = llvm_const_named_struct(lb_type(m, res.type), vals, gb_count_of(vals));
-				lb_emit_store(p, tag, res);
+				variant = res.value;
 			}
 			break;
 
 		}
 
 
-		if (tag.value != nullptr) {
-			Type *tag_type = type_deref(tag.type);
+		if (tag_type != nullptr) {
 			GB_ASSERT(is_type_named(tag_type));
-			// lb_emit_store_union_variant(p, variant_ptr, lb_emit_load(p, tag), tag_type);
-			lb_emit_store_union_variant_tag(p, variant_ptr, tag_type);
+			if (variant == nullptr) {
+				variant = LLVMConstNull(lb_type(m, tag_type));
+			}
+
+			LLVMValueRef entry_values[6] = {
+				lb_const_int(m, t_int, type_size_of(t)).value,
+				lb_const_int(m, t_int, type_align_of(t)).value,
+				type_info_flags.value,
+				lb_typeid(m, t).value,
+				variant,
+				lb_const_union_tag(m, t_type_info_variant, tag_type).value,
+			};
+			type_info_entries[entry_index] = lb_const_packed_at_offsets(m, entry_values, type_info_offsets, gb_count_of(entry_values), type_info_size);
 		} else {
 			if (t != t_llvm_bool) {
 				GB_PANIC("Unhandled Type_Info variant: %s", type_to_string(t));
 			}
 		}
 	}
+
+	lb_type_info_member_values_set_initializer(m, lb_global_type_info_member_types,   lb_global_type_info_member_types_values);
+	lb_type_info_member_values_set_initializer(m, lb_global_type_info_member_names,   lb_global_type_info_member_names_values);
+	lb_type_info_member_values_set_initializer(m, lb_global_type_info_member_offsets, lb_global_type_info_member_offsets_values);
+	lb_type_info_member_values_set_initializer(m, lb_global_type_info_member_usings,  lb_global_type_info_member_usings_values);
+	lb_type_info_member_values_set_initializer(m, lb_global_type_info_member_tags,    lb_global_type_info_member_tags_values);
+
+	{
+		// NOTE: The entries are of differing types so the table cannot be the initializer of the [N]Type_Info global
+		// which has already been referenced, replace that global with one of the same name and layout
+		LLVMValueRef old_global = lb_global_type_info_data_ptr(m).value;
+		GB_ASSERT(LLVMIsAGlobalVariable(old_global));
+
+		LLVMValueRef init = LLVMConstStructInContext(m->ctx, type_info_entries, cast(unsigned)type_info_count, false);
+		LLVMValueRef g = LLVMAddGlobal(m->mod, LLVMTypeOf(init), "");
+		LLVMSetInitializer(g, init);
+		LLVMSetLinkage(g, LLVMGetLinkage(old_global));
+		LLVMSetAlignment(g, cast(unsigned)type_align_of(t_type_info));
+		LLVMSetGlobalConstant(g, true);
+
+		lbValue value = {};
+		value.value = LLVMConstPointerCast(g, LLVMTypeOf(old_global));
+		value.type = alloc_type_pointer(lb_global_type_info_data_entity->type);
+
+		LLVMReplaceAllUsesWith(old_global, value.value);
+		LLVMDeleteGlobal(old_global);
+		LLVMSetValueName2(g, LB_TYPE_INFO_DATA_NAME, gb_strlen(LB_TYPE_INFO_DATA_NAME));
+
+		lb_add_entity(m, lb_global_type_info_data_entity, value);
+	}
 }
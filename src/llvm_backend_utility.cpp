@@ -1124,6 +1124,27 @@ lbValue lb_emit_array_epi(lbProcedure *p, lbValue s, isize index) {
 	return res;
 }
 
+lbValue lb_const_array_epi(lbModule *m, lbValue s, isize index) {
+	Type *t = s.type;
+	GB_ASSERT(is_type_pointer(t));
+	GB_ASSERT(lb_is_const(s));
+	Type *st = base_type(type_deref(t));
+	GB_ASSERT_MSG(is_type_array(st) || is_type_enumerated_array(st), "%s", type_to_string(st));
+
+	GB_ASSERT(0 <= index);
+	Type *ptr = base_array_type(st);
+
+	LLVMValueRef indices[2] = {
+		LLVMConstInt(lb_type(m, t_int), 0, false),
+		LLVMConstInt(lb_type(m, t_int), cast(unsigned)index, false),
+	};
+
+	lbValue res = {};
+	res.value = LLVMConstInBoundsGEP2(lb_type(m, st), s.value, indices, gb_count_of(indices));
+	res.type = alloc_type_pointer(ptr);
+	return res;
+}
+
 lbValue lb_emit_ptr_offset(lbProcedure *p, lbValue ptr, lbValue index) {
 	LLVMValueRef indices[1] = {index.value};
 	lbValue res = {};
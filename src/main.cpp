@@ -43,6 +43,8 @@ gb_global Timings global_timings = {0};
 #endif
 
 #include "query_data.cpp"
+#include "server.cpp"
+#include "package_cache.cpp"
 
 
 #if defined(GB_SYSTEM_WINDOWS)
@@ -546,6 +548,8 @@ void usage(String argv0) {
 	print_usage_line(1, "query     parse, type check, and output a .json file containing information about the program");
 	print_usage_line(1, "doc       generate documentation .odin file, or directory of .odin files");
 	print_usage_line(1, "version   print version");
+	print_usage_line(1, "server    keep the runtime and the given packages parsed, serving builds which pass -use-server");
+	print_usage_line(1, "          usage: server <socket path> [packages...], e.g. server /tmp/odin.sock core:fmt core:os");
 	print_usage_line(0, "");
 	print_usage_line(0, "For more information of flags, apply the flag to see what is possible");
 	print_usage_line(1, "-help");
@@ -594,6 +598,7 @@ enum BuildFlagKind {
 	BuildFlag_ShowUnused,
 	BuildFlag_ShowUnusedWithLocation,
 	BuildFlag_ShowMoreTimings,
+	BuildFlag_ExportTimings,
 	BuildFlag_ShowSystemCalls,
 	BuildFlag_ThreadCount,
 	BuildFlag_KeepTempFiles,
@@ -609,6 +614,9 @@ enum BuildFlagKind {
 	BuildFlag_NoEntryPoint,
 	BuildFlag_UseLLD,
 	BuildFlag_UseSeparateModules,
+	BuildFlag_ObjectCache,
+	BuildFlag_UseServer,
+	BuildFlag_CheckedCache,
 	BuildFlag_ThreadedChecker,
 	BuildFlag_NoThreadedChecker,
 	BuildFlag_ShowDebugMessages,
@@ -719,6 +727,7 @@ bool parse_build_flags(Array<String> args) {
 	add_flag(&build_flags, BuildFlag_OptimizationMode,  str_lit("O"),                   BuildFlagParam_String, Command__does_build);
 	add_flag(&build_flags, BuildFlag_ShowTimings,       str_lit("show-timings"),        BuildFlagParam_None, Command__does_check);
 	add_flag(&build_flags, BuildFlag_ShowMoreTimings,   str_lit("show-more-timings"),   BuildFlagParam_None, Command__does_check);
+	add_flag(&build_flags, BuildFlag_ExportTimings,     str_lit("export-timings"),      BuildFlagParam_String, Command__does_check);
 	add_flag(&build_flags, BuildFlag_ShowUnused,        str_lit("show-unused"),         BuildFlagParam_None, Command_check);
 	add_flag(&build_flags, BuildFlag_ShowUnusedWithLocation, str_lit("show-unused-with-location"), BuildFlagParam_None, Command_check);
 	add_flag(&build_flags, BuildFlag_ShowSystemCalls,   str_lit("show-system-calls"),   BuildFlagParam_None, Command_all);
@@ -736,6 +745,9 @@ bool parse_build_flags(Array<String> args) {
 	add_flag(&build_flags, BuildFlag_NoEntryPoint,      str_lit("no-entry-point"),      BuildFlagParam_None, Command__does_check &~ Command_test);
 	add_flag(&build_flags, BuildFlag_UseLLD,            str_lit("lld"),                 BuildFlagParam_None, Command__does_build);
 	add_flag(&build_flags, BuildFlag_UseSeparateModules,str_lit("use-separate-modules"),BuildFlagParam_None, Command__does_build);
+	add_flag(&build_flags, BuildFlag_ObjectCache,       str_lit("object-cache"),        BuildFlagParam_String, Command__does_build);
+	add_flag(&build_flags, BuildFlag_UseServer,         str_lit("use-server"),          BuildFlagParam_String, Command__does_check);
+	add_flag(&build_flags, BuildFlag_CheckedCache,      str_lit("checked-cache"),       BuildFlagParam_String, Command__does_check);
 	add_flag(&build_flags, BuildFlag_ThreadedChecker,   str_lit("threaded-checker"),    BuildFlagParam_None, Command__does_check);
 	add_flag(&build_flags, BuildFlag_NoThreadedChecker, str_lit("no-threaded-checker"), BuildFlagParam_None, Command__does_check);
 	add_flag(&build_flags, BuildFlag_ShowDebugMessages, str_lit("show-debug-messages"), BuildFlagParam_None, Command_all);
@@ -957,6 +969,7 @@ bool parse_build_flags(Array<String> args) {
 						case BuildFlag_ShowTimings:
 							GB_ASSERT(value.kind == ExactValue_Invalid);
 							build_context.show_timings = true;
+							mutex_stats_enabled = true;
 							break;
 						case BuildFlag_ShowUnused:
 							GB_ASSERT(value.kind == ExactValue_Invalid);
@@ -971,7 +984,20 @@ bool parse_build_flags(Array<String> args) {
 							GB_ASSERT(value.kind == ExactValue_Invalid);
 							build_context.show_timings = true;
 							build_context.show_more_timings = true;
+							mutex_stats_enabled = true;
 							break;
+						case BuildFlag_ExportTimings: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String path = string_trim_whitespace(value.value_string);
+							if (is_build_flag_path_valid(path)) {
+								build_context.export_timings_file = path_to_full_path(heap_allocator(), path);
+								trace_spans_enabled = true;
+							} else {
+								gb_printf_err("Invalid -export-timings path, got %.*s\n", LIT(path));
+								bad_flags = true;
+							}
+							break;
+						}
 						case BuildFlag_ShowSystemCalls:
 							GB_ASSERT(value.kind == ExactValue_Invalid);
 							build_context.show_system_calls = true;
@@ -1225,6 +1251,42 @@ bool parse_build_flags(Array<String> args) {
 							build_context.use_separate_modules = true;
 							break;
 
+						case BuildFlag_ObjectCache: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String path = string_trim_whitespace(value.value_string);
+							if (is_build_flag_path_valid(path) && path_is_directory(path)) {
+								build_context.object_cache_dir = path_to_full_path(heap_allocator(), path);
+							} else {
+								gb_printf_err("Invalid -object-cache directory, got %.*s\n", LIT(path));
+								bad_flags = true;
+							}
+							break;
+						}
+
+						case BuildFlag_UseServer: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String path = string_trim_whitespace(value.value_string);
+							if (path.len != 0) {
+								build_context.compile_server_socket = path;
+							} else {
+								gb_printf_err("Invalid -use-server socket path, got %.*s\n", LIT(path));
+								bad_flags = true;
+							}
+							break;
+						}
+
+						case BuildFlag_CheckedCache: {
+							GB_ASSERT(value.kind == ExactValue_String);
+							String path = string_trim_whitespace(value.value_string);
+							if (is_build_flag_path_valid(path) && path_is_directory(path)) {
+								build_context.checked_cache_dir = path_to_full_path(heap_allocator(), path);
+							} else {
+								gb_printf_err("Invalid -checked-cache directory, got %.*s\n", LIT(path));
+								bad_flags = true;
+							}
+							break;
+						}
+
 						case BuildFlag_ThreadedChecker:
 							#if defined(DEFAULT_TO_THREADED_CHECKER)
 							gb_printf_err("-threaded-checker is the default on this platform\n");
@@ -1476,6 +1538,55 @@ bool parse_build_flags(Array<String> args) {
 	return !bad_flags;
 }
 
+GB_COMPARE_PROC(mutex_stats_wait_time_cmp) {
+	MutexStats *x = *cast(MutexStats **)a;
+	MutexStats *y = *cast(MutexStats **)b;
+	u64 wx = x->wait_time.load(std::memory_order_relaxed);
+	u64 wy = y->wait_time.load(std::memory_order_relaxed);
+	if (wx != wy) {
+		return wx > wy ? -1 : +1;
+	}
+	u64 ax = x->acquired.load(std::memory_order_relaxed);
+	u64 ay = y->acquired.load(std::memory_order_relaxed);
+	return ax > ay ? -1 : ax < ay ? +1 : 0;
+}
+
+void show_lock_stats(Timings *t, char const *title, MutexStats *list) {
+	auto stats = array_make<MutexStats *>(heap_allocator(), 0, 64);
+	defer (array_free(&stats));
+	for (MutexStats *s = list; s != nullptr; s = s->next) {
+		if (s->acquired.load(std::memory_order_relaxed) != 0) {
+			array_add(&stats, s);
+		}
+	}
+	if (stats.count == 0) {
+		return;
+	}
+	gb_sort_array(stats.data, stats.count, mutex_stats_wait_time_cmp);
+
+	gb_printf("\n");
+	gb_printf("%s\n", title);
+	for_array(i, stats) {
+		MutexStats *s = stats[i];
+		u64 acquired  = s->acquired.load(std::memory_order_relaxed);
+		u64 contended = s->contended.load(std::memory_order_relaxed);
+		u64 wait_time = s->wait_time.load(std::memory_order_relaxed);
+		isize name_len = gb_strlen(s->name);
+		gb_printf("%s%.*s - %9llu acquired - %7llu contended (%.3f%%) - waited %9.3f ms\n",
+		          s->name, cast(int)gb_max(34 - name_len, 0), "                                  ",
+		          cast(unsigned long long)acquired,
+		          cast(unsigned long long)contended,
+		          100.0*cast(f64)contended/cast(f64)acquired,
+		          1000.0*cast(f64)wait_time/cast(f64)t->freq);
+	}
+}
+
+void export_timings(Timings *t) {
+	if (!timings_export_trace(t, build_context.export_timings_file)) {
+		gb_printf_err("Failed to write timings to: %.*s\n", LIT(build_context.export_timings_file));
+	}
+}
+
 void show_timings(Checker *c, Timings *t) {
 	Parser *p      = c->parser;
 	isize lines    = p->total_line_count;
@@ -1496,6 +1607,27 @@ void show_timings(Checker *c, Timings *t) {
 	}
 
 	timings_print_all(t);
+	if (build_context.show_more_timings) {
+		gb_printf("\n");
+		gb_printf("Permanent Arena - %.3f MiB used in %td blocks\n",
+		          cast(f64)permanent_arena.total_used.load()/(1024*1024),
+		          permanent_arena.blocks.count);
+	}
+	if (build_context.show_more_timings && c->procs_to_check_thread_stats.count > 0) {
+		gb_printf("\n");
+		gb_printf("Procedure Body Checking Threads\n");
+		for_array(i, c->procs_to_check_thread_stats) {
+			ProcBodyThreadStats const &stats = c->procs_to_check_thread_stats[i];
+			gb_printf("Thread %2td - busy % 9.3f ms - idle % 9.3f ms - %td bodies (%td stolen)\n",
+			          i,
+			          1000.0*cast(f64)stats.busy_time/cast(f64)t->freq,
+			          1000.0*cast(f64)stats.idle_time/cast(f64)t->freq,
+			          stats.bodies_checked,
+			          stats.bodies_stolen);
+		}
+	}
+	show_lock_stats(t, "Mutexes",    mutex_stats_list.load());
+	show_lock_stats(t, "Semaphores", semaphore_stats_list.load());
 	if (build_context.show_debug_messages && build_context.show_more_timings) {
 		{
 			gb_printf("\n");
@@ -1694,17 +1826,35 @@ void print_show_help(String const arg0, String const &command) {
 
 	if (check) {
 		print_usage_line(1, "-show-timings");
-		print_usage_line(2, "Shows basic overview of the timings of different stages within the compiler in milliseconds");
+		print_usage_line(2, "Shows basic overview of the timings of different stages within the compiler in milliseconds, and how often each named mutex and semaphore had to be waited on");
 		print_usage_line(0, "");
 
 		print_usage_line(1, "-show-more-timings");
 		print_usage_line(2, "Shows an advanced overview of the timings of different stages within the compiler in milliseconds");
 		print_usage_line(0, "");
 
+		print_usage_line(1, "-export-timings:<filename>");
+		print_usage_line(2, "Writes the timings of each thread's work (per file, package, procedure body and LLVM module) as Chrome trace JSON");
+		print_usage_line(2, "The file can be loaded into chrome://tracing or ui.perfetto.dev");
+		print_usage_line(2, "Example: -export-timings:trace.json");
+		print_usage_line(0, "");
+
 		print_usage_line(1, "-thread-count:<integer>");
 		print_usage_line(2, "Override the number of threads the compiler will use to compile with");
 		print_usage_line(2, "Example: -thread-count:2");
 		print_usage_line(0, "");
+
+		print_usage_line(1, "-checked-cache:<directory>");
+		print_usage_line(2, "Records in an existing directory which packages have been type checked without any errors or warnings");
+		print_usage_line(2, "Later builds only check the declarations they use from recorded packages which have not changed since");
+		print_usage_line(2, "Example: -checked-cache:.odin-cache");
+		print_usage_line(0, "");
+
+		print_usage_line(1, "-use-server:<socket path>");
+		print_usage_line(2, "Hands the build to a compile server started with 'odin server', which has the core packages already parsed");
+		print_usage_line(2, "The build is done locally if no server is listening on the socket");
+		print_usage_line(2, "Example: -use-server:/tmp/odin.sock");
+		print_usage_line(0, "");
 	}
 
 	if (check_only) {
@@ -1786,6 +1936,13 @@ void print_show_help(String const arg0, String const &command) {
 		print_usage_line(2, "Normally, a single build unit is generated for a standard project");
 		print_usage_line(0, "");
 
+		print_usage_line(1, "-object-cache:<directory>");
+		print_usage_line(2, "Caches the object file of each build unit in an existing directory, keyed by its unoptimized IR and the compiler and target settings");
+		print_usage_line(2, "Build units that have not changed skip the optimization passes and object generation");
+		print_usage_line(2, "Most effective with -use-separate-modules");
+		print_usage_line(2, "Example: -object-cache:.odin-cache");
+		print_usage_line(0, "");
+
 	}
 
 	if (check) {
@@ -2006,16 +2163,16 @@ int main(int arg_count, char const **arg_ptr) {
 
 	TIME_SECTION("initialization");
 
-	arena_init(&permanent_arena, heap_allocator());
-	temp_allocator_init(&temporary_allocator_data, 16*1024*1024);
-	arena_init(&global_ast_arena, heap_allocator());
-	mutex_init(&fullpath_mutex);
+	arena_init(&permanent_arena, heap_allocator(), ARENA_DEFAULT_BLOCK_SIZE, true);
+	arena_init(&global_ast_arena, heap_allocator(), ARENA_DEFAULT_BLOCK_SIZE, true);
+	mutex_init(&fullpath_mutex, "fullpath_mutex");
 
 	init_string_buffer_memory();
 	init_string_interner();
 	init_global_error_collector();
 	init_keyword_hash_table();
 	init_type_mutex();
+	init_type_intern_table();
 
 	if (!check_env()) {
 		return 1;
@@ -2033,6 +2190,18 @@ int main(int arg_count, char const **arg_ptr) {
 	Array<String> args = setup_args(arg_count, arg_ptr);
 
 	String command = args[1];
+	if (command == "server") {
+		if (args.count < 3) {
+			usage(args[0]);
+			return 1;
+		}
+		// NOTE: Only returns within the process forked for each request, which carries on with its arguments
+		if (!compile_server_run(args, &args)) {
+			return 1;
+		}
+		command = args[1];
+	}
+
 	String init_filename = {};
 	String run_args_string = {};
 
@@ -2153,6 +2322,13 @@ int main(int arg_count, char const **arg_ptr) {
 		return 0;
 	}
 
+	if (build_context.compile_server_socket.len != 0 && !compile_server.is_request) {
+		i32 exit_code = 0;
+		if (compile_server_request(build_context.compile_server_socket, arg_count, arg_ptr, &exit_code)) {
+			return exit_code;
+		}
+	}
+
 	// NOTE(bill): add 'shared' directory if it is not already set
 	if (!find_library_collection_path(str_lit("shared"), nullptr)) {
 		add_library_collection(str_lit("shared"),
@@ -2169,25 +2345,33 @@ int main(int arg_count, char const **arg_ptr) {
 	init_universal();
 	// TODO(bill): prevent compiling without a linker
 
-	Parser *parser = gb_alloc_item(permanent_allocator(), Parser);
+	Parser *parser = compile_server_parser(init_filename);
 	Checker *checker = gb_alloc_item(permanent_allocator(), Checker);
 
 	TIME_SECTION("parse files");
 
-	if (!init_parser(parser)) {
-		return 1;
+	if (parser == nullptr) {
+		parser = gb_alloc_item(permanent_allocator(), Parser);
+		if (!init_parser(parser)) {
+			return 1;
+		}
 	}
 	defer (destroy_parser(parser));
 
 	if (parse_packages(parser, init_filename) != ParseFile_None) {
 		return 1;
 	}
+	compile_server_prune_packages(parser);
 
 	if (any_errors()) {
 		return 1;
 	}
 
-	temp_allocator_free_all(&temporary_allocator_data);
+	if (package_cache_enabled()) {
+		package_cache_adopt(parser);
+	}
+
+	temp_arena_free_all(&temporary_arena);
 
 	TIME_SECTION("type check");
 
@@ -2200,7 +2384,11 @@ int main(int arg_count, char const **arg_ptr) {
 		return 1;
 	}
 
-	temp_allocator_free_all(&temporary_allocator_data);
+	if (package_cache_enabled()) {
+		package_cache_write_records(parser);
+	}
+
+	temp_arena_free_all(&temporary_arena);
 
 	if (build_context.generate_docs) {
 		if (global_error_collector.count != 0) {
@@ -2218,6 +2406,9 @@ int main(int arg_count, char const **arg_ptr) {
 		if (build_context.query_data_set_settings.ok) {
 			generate_and_print_query_data(checker, &global_timings);
 		} else {
+			if (build_context.export_timings_file.len != 0) {
+				export_timings(&global_timings);
+			}
 			if (build_context.show_timings) {
 				show_timings(checker, &global_timings);
 			}
@@ -2237,13 +2428,16 @@ int main(int arg_count, char const **arg_ptr) {
 	}
 	lb_generate_code(gen);
 
-	temp_allocator_free_all(&temporary_allocator_data);
+	temp_arena_free_all(&temporary_arena);
 
 	switch (build_context.build_mode) {
 	case BuildMode_Executable:
 	case BuildMode_DynamicLibrary:
 		i32 result = linker_stage(gen);
 		if (result != 0) {
+			if (build_context.export_timings_file.len != 0) {
+				export_timings(&global_timings);
+			}
 			if (build_context.show_timings) {
 				show_timings(checker, &global_timings);
 			}
@@ -2252,6 +2446,9 @@ int main(int arg_count, char const **arg_ptr) {
 		break;
 	}
 
+	if (build_context.export_timings_file.len != 0) {
+		export_timings(&global_timings);
+	}
 	if (build_context.show_timings) {
 		show_timings(checker, &global_timings);
 	}
@@ -7,12 +7,114 @@
 #ifndef MAP_UTIL_STUFF
 #define MAP_UTIL_STUFF
 // NOTE(bill): This util stuff is the same for every `Map`
+
+// NOTE: The tables are open addressed with linear probing. `entries` stays densely packed in
+// insertion order (a removal moves the last entry into the hole), and each slot in `hashes`
+// holds the index of its entry along with 32 bits of the entry's hash. The home slot is taken
+// from those same bits, so probing, rehashing and removal only touch `hashes`, and the entry
+// itself is only read once the tag matches.
+typedef u32 MapIndex;
+
+enum : MapIndex { MAP_SENTINEL = ~(MapIndex)0 };
+
+struct MapSlot {
+	MapIndex index;
+	u32      tag;
+};
+
 struct MapFindResult {
-	isize hash_index;
-	isize entry_prev;
+	isize slot_index;  // The slot of the entry, or the empty slot where it would be inserted
 	isize entry_index;
 };
 
+gb_inline u32 map_hash_tag(u64 x) {
+	// NOTE: Many keys are pointers, so their low bits must be mixed before they pick a slot
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdull;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ull;
+	x ^= x >> 33;
+	return cast(u32)x;
+}
+
+gb_inline bool map_slots_full(isize slot_count, isize entry_count) {
+	return 0.75f * slot_count <= entry_count;
+}
+
+void map_slots_clear(MapSlot *slots, isize count) {
+	for (isize i = 0; i < count; i++) {
+		slots[i].index = MAP_SENTINEL;
+	}
+}
+
+void map_slots_insert(MapSlot *slots, isize count, MapSlot slot) {
+	isize mask = count-1;
+	isize i = slot.tag & mask;
+	while (slots[i].index != MAP_SENTINEL) {
+		i = (i+1) & mask;
+	}
+	slots[i] = slot;
+}
+
+// NOTE: Puts `slot` at `i` and moves the rest of the probe run along by one, which keeps every
+// moved slot reachable from its home slot
+void map_slots_insert_before(MapSlot *slots, isize count, isize i, MapSlot slot) {
+	isize mask = count-1;
+	while (slots[i].index != MAP_SENTINEL) {
+		MapSlot next = slots[i];
+		slots[i] = slot;
+		slot = next;
+		i = (i+1) & mask;
+	}
+	slots[i] = slot;
+}
+
+// NOTE: Backward shift deletion, so no tombstones are ever needed
+void map_slots_erase(MapSlot *slots, isize count, isize hole) {
+	isize mask = count-1;
+	for (isize j = (hole+1) & mask; slots[j].index != MAP_SENTINEL; j = (j+1) & mask) {
+		isize home = slots[j].tag & mask;
+		if (((j - home) & mask) >= ((j - hole) & mask)) {
+			slots[hole] = slots[j];
+			hole = j;
+		}
+	}
+	slots[hole].index = MAP_SENTINEL;
+}
+
+void map_slots_reindex(MapSlot *slots, isize count, u32 tag, MapIndex old_index, MapIndex new_index) {
+	isize mask = count-1;
+	for (isize i = tag & mask; ; i = (i+1) & mask) {
+		GB_ASSERT(slots[i].index != MAP_SENTINEL);
+		if (slots[i].index == old_index) {
+			slots[i].index = new_index;
+			return;
+		}
+	}
+}
+
+void map_slots_rehash(Slice<MapSlot> *slots, gbAllocator a, isize new_count) {
+	Slice<MapSlot> new_slots = {};
+	slice_init(&new_slots, a, new_count);
+	map_slots_clear(new_slots.data, new_slots.count);
+
+	// NOTE: Start just after an empty slot, so that a probe run which wraps around the end is
+	// reinserted in its probe order, which keeps the order of the entries sharing a key
+	isize mask = slots->count-1;
+	isize start = 0;
+	while (start < slots->count && slots->data[start].index != MAP_SENTINEL) {
+		start++;
+	}
+	for (isize k = 1; k <= slots->count; k++) {
+		MapSlot slot = slots->data[(start+k) & mask];
+		if (slot.index != MAP_SENTINEL) {
+			map_slots_insert(new_slots.data, new_slots.count, slot);
+		}
+	}
+	slice_free(slots, a);
+	*slots = new_slots;
+}
+
 
 struct HashKey {
 	u64 key;
@@ -48,18 +150,80 @@ gb_inline bool hash_key_equal(HashKey a, HashKey b) {
 gb_inline bool operator==(HashKey a, HashKey b) { return hash_key_equal(a, b); }
 gb_inline bool operator!=(HashKey a, HashKey b) { return !hash_key_equal(a, b); }
 
+
+// NOTE: Building with -DMAP_TRACE=1 writes every operation on a `Map`, `PtrSet` or `StringMap` to the
+// file named by ODIN_MAP_TRACE, so that misc/benchmarks/map_bench.cpp can replay the tables of a real run
+#ifndef MAP_TRACE
+#define MAP_TRACE 0
+#endif
+
+enum MapTraceTable : u8 {
+	MapTraceTable_Map,
+	MapTraceTable_PtrSet,
+	MapTraceTable_StringMap,
+};
+
+enum MapTraceOp : u8 {
+	MapTraceOp_Init,
+	MapTraceOp_Destroy,
+	MapTraceOp_Get,
+	MapTraceOp_Set,
+	MapTraceOp_Remove,
+	MapTraceOp_Clear,
+	MapTraceOp_MultiInsert,
+	MapTraceOp_MultiFind,
+};
+
+struct MapTraceRecord {
+	u8  table_kind; // MapTraceTable
+	u8  op;         // MapTraceOp
+	u16 padding;
+	u32 string_len; // The text of a `StringMap` key follows the record
+	u64 table;
+	u64 key;        // The capacity for MapTraceOp_Init, the hash for a `StringMap` key
+};
+
+#if MAP_TRACE
+gb_global BlockingMutex map_trace_mutex = {};
+gb_global FILE *map_trace_file;
+gb_global bool map_trace_disabled;
+
+void map_trace(MapTraceTable table_kind, MapTraceOp op, void const *table, u64 key, String const &str = {}) {
+	mutex_lock(&map_trace_mutex);
+	if (map_trace_file == nullptr && !map_trace_disabled) {
+		char const *path = gb_get_env("ODIN_MAP_TRACE", heap_allocator());
+		if (path != nullptr) {
+			map_trace_file = fopen(path, "wb");
+		}
+		map_trace_disabled = map_trace_file == nullptr;
+	}
+	if (map_trace_file != nullptr) {
+		MapTraceRecord r = {};
+		r.table_kind = table_kind;
+		r.op         = op;
+		r.string_len = cast(u32)str.len;
+		r.table      = cast(u64)cast(uintptr)table;
+		r.key        = key;
+		fwrite(&r, gb_size_of(r), 1, map_trace_file);
+		fwrite(str.text, 1, str.len, map_trace_file);
+	}
+	mutex_unlock(&map_trace_mutex);
+}
+#else
+gb_inline void map_trace(MapTraceTable table_kind, MapTraceOp op, void const *table, u64 key, String const &str = {}) {}
+#endif
+
 #endif
 
 template <typename T>
 struct MapEntry {
 	HashKey  key;
-	isize    next;
 	T        value;
 };
 
 template <typename T>
 struct Map {
-	Slice<isize>        hashes;
+	Slice<MapSlot>      hashes;
 	Array<MapEntry<T> > entries;
 };
 
@@ -88,58 +252,69 @@ template <typename T> void  multi_map_remove_all(Map<T> *h, HashKey const &key);
 
 template <typename T>
 gb_inline void map_init(Map<T> *h, gbAllocator a, isize capacity) {
+	map_trace(MapTraceTable_Map, MapTraceOp_Init, h, cast(u64)capacity);
 	capacity = next_pow2_isize(capacity);
 	slice_init(&h->hashes,  a, capacity);
 	array_init(&h->entries, a, 0, capacity);
-	for (isize i = 0; i < capacity; i++) {
-		h->hashes.data[i] = -1;
-	}
+	map_slots_clear(h->hashes.data, h->hashes.count);
 }
 
 template <typename T>
 gb_inline void map_destroy(Map<T> *h) {
+	map_trace(MapTraceTable_Map, MapTraceOp_Destroy, h, 0);
 	slice_free(&h->hashes, h->entries.allocator);
 	array_free(&h->entries);
 }
 
 template <typename T>
-gb_internal isize map__add_entry(Map<T> *h, HashKey const &key) {
+gb_internal MapIndex map__add_entry(Map<T> *h, MapFindResult const &fr, HashKey const &key, u32 tag) {
 	MapEntry<T> e = {};
 	e.key = key;
-	e.next = -1;
 	array_add(&h->entries, e);
-	return h->entries.count-1;
+	MapIndex index = cast(MapIndex)(h->entries.count-1);
+	h->hashes.data[fr.slot_index].index = index;
+	h->hashes.data[fr.slot_index].tag   = tag;
+	return index;
 }
 
 template <typename T>
-gb_internal MapFindResult map__find(Map<T> *h, HashKey const &key) {
-	MapFindResult fr = {-1, -1, -1};
-	if (h->hashes.count > 0) {
-		fr.hash_index = key.key & (h->hashes.count-1);
-		fr.entry_index = h->hashes.data[fr.hash_index];
-		while (fr.entry_index >= 0) {
-			if (hash_key_equal(h->entries.data[fr.entry_index].key, key)) {
-				return fr;
+gb_internal MapFindResult map__find(Map<T> *h, HashKey const &key, u32 tag) {
+	MapFindResult fr = {-1, -1};
+	if (h->hashes.count != 0) {
+		isize mask = h->hashes.count-1;
+		for (isize i = tag & mask; ; i = (i+1) & mask) {
+			MapSlot slot = h->hashes.data[i];
+			if (slot.index == MAP_SENTINEL) {
+				fr.slot_index = i;
+				break;
+			}
+			if (slot.tag == tag && hash_key_equal(h->entries.data[slot.index].key, key)) {
+				fr.slot_index = i;
+				fr.entry_index = slot.index;
+				break;
 			}
-			fr.entry_prev = fr.entry_index;
-			fr.entry_index = h->entries.data[fr.entry_index].next;
 		}
 	}
 	return fr;
 }
 
+template <typename T>
+gb_internal MapFindResult map__find(Map<T> *h, HashKey const &key) {
+	return map__find(h, key, map_hash_tag(key.key));
+}
+
 template <typename T>
 gb_internal MapFindResult map__find_from_entry(Map<T> *h, MapEntry<T> *e) {
-	MapFindResult fr = {-1, -1, -1};
-	if (h->hashes.count > 0) {
-		fr.hash_index  = e->key.key & (h->hashes.count-1);
-		fr.entry_index = h->hashes.data[fr.hash_index];
-		while (fr.entry_index >= 0) {
-			if (&h->entries.data[fr.entry_index] == e) {
-				return fr;
+	MapFindResult fr = {-1, -1};
+	if (h->hashes.count != 0) {
+		MapIndex index = cast(MapIndex)(e - h->entries.data);
+		isize mask = h->hashes.count-1;
+		for (isize i = map_hash_tag(e->key.key) & mask; h->hashes.data[i].index != MAP_SENTINEL; i = (i+1) & mask) {
+			if (h->hashes.data[i].index == index) {
+				fr.slot_index = i;
+				fr.entry_index = index;
+				break;
 			}
-			fr.entry_prev = fr.entry_index;
-			fr.entry_index = h->entries.data[fr.entry_index].next;
 		}
 	}
 	return fr;
@@ -147,7 +322,7 @@ gb_internal MapFindResult map__find_from_entry(Map<T> *h, MapEntry<T> *e) {
 
 template <typename T>
 gb_internal b32 map__full(Map<T> *h) {
-	return 0.75f * h->hashes.count <= h->entries.count;
+	return map_slots_full(h->hashes.count, h->entries.count);
 }
 
 template <typename T>
@@ -158,41 +333,16 @@ gb_inline void map_grow(Map<T> *h) {
 
 template <typename T>
 void map_rehash(Map<T> *h, isize new_count) {
-	isize i, j;
-	Map<T> nh = {};
 	new_count = next_pow2_isize(new_count);
-	nh.hashes = h->hashes;
-	nh.entries.allocator = h->entries.allocator;
-	slice_resize(&nh.hashes, h->entries.allocator, new_count);
-	for (i = 0; i < new_count; i++) {
-		nh.hashes.data[i] = -1;
-	}
-	array_reserve(&nh.entries, ARRAY_GROW_FORMULA(h->entries.count));
-	for (i = 0; i < h->entries.count; i++) {
-		MapEntry<T> *e = &h->entries.data[i];
-		MapFindResult fr;
-		if (nh.hashes.count == 0) {
-			map_grow(&nh);
-		}
-		fr = map__find(&nh, e->key);
-		j = map__add_entry(&nh, e->key);
-		if (fr.entry_prev < 0) {
-			nh.hashes.data[fr.hash_index] = j;
-		} else {
-			nh.entries.data[fr.entry_prev].next = j;
-		}
-		nh.entries.data[j].next = fr.entry_index;
-		nh.entries.data[j].value = e->value;
-		if (map__full(&nh)) {
-			map_grow(&nh);
-		}
+	while (map_slots_full(new_count, h->entries.count)) {
+		new_count <<= 1;
 	}
-	array_free(&h->entries);
-	*h = nh;
+	map_slots_rehash(&h->hashes, h->entries.allocator, new_count);
 }
 
 template <typename T>
 T *map_get(Map<T> *h, HashKey const &key) {
+	map_trace(MapTraceTable_Map, MapTraceOp_Get, h, key.key);
 	isize index = map__find(h, key).entry_index;
 	if (index >= 0) {
 		return &h->entries.data[index].value;
@@ -202,6 +352,7 @@ T *map_get(Map<T> *h, HashKey const &key) {
 
 template <typename T>
 T &map_must_get(Map<T> *h, HashKey const &key) {
+	map_trace(MapTraceTable_Map, MapTraceOp_Get, h, key.key);
 	isize index = map__find(h, key).entry_index;
 	GB_ASSERT(index >= 0);
 	return h->entries.data[index].value;
@@ -209,21 +360,18 @@ T &map_must_get(Map<T> *h, HashKey const &key) {
 
 template <typename T>
 void map_set(Map<T> *h, HashKey const &key, T const &value) {
+	map_trace(MapTraceTable_Map, MapTraceOp_Set, h, key.key);
 	isize index;
 	MapFindResult fr;
 	if (h->hashes.count == 0) {
 		map_grow(h);
 	}
-	fr = map__find(h, key);
+	u32 tag = map_hash_tag(key.key);
+	fr = map__find(h, key, tag);
 	if (fr.entry_index >= 0) {
 		index = fr.entry_index;
 	} else {
-		index = map__add_entry(h, key);
-		if (fr.entry_prev >= 0) {
-			h->entries.data[fr.entry_prev].next = index;
-		} else {
-			h->hashes.data[fr.hash_index] = index;
-		}
+		index = map__add_entry(h, fr, key, tag);
 	}
 	h->entries.data[index].value = value;
 
@@ -235,27 +383,20 @@ void map_set(Map<T> *h, HashKey const &key, T const &value) {
 
 template <typename T>
 void map__erase(Map<T> *h, MapFindResult const &fr) {
-	MapFindResult last;
-	if (fr.entry_prev < 0) {
-		h->hashes.data[fr.hash_index] = h->entries.data[fr.entry_index].next;
-	} else {
-		h->entries.data[fr.entry_prev].next = h->entries.data[fr.entry_index].next;
-	}
-	if (fr.entry_index == h->entries.count-1) {
-		array_pop(&h->entries);
-		return;
-	}
-	h->entries.data[fr.entry_index] = h->entries.data[h->entries.count-1];
-	last = map__find(h, h->entries.data[fr.entry_index].key);
-	if (last.entry_prev >= 0) {
-		h->entries.data[last.entry_prev].next = fr.entry_index;
-	} else {
-		h->hashes.data[last.hash_index] = fr.entry_index;
+	map_slots_erase(h->hashes.data, h->hashes.count, fr.slot_index);
+
+	isize last = h->entries.count-1;
+	if (fr.entry_index != last) {
+		h->entries.data[fr.entry_index] = h->entries.data[last];
+		u32 tag = map_hash_tag(h->entries.data[fr.entry_index].key.key);
+		map_slots_reindex(h->hashes.data, h->hashes.count, tag, cast(MapIndex)last, cast(MapIndex)fr.entry_index);
 	}
+	array_pop(&h->entries);
 }
 
 template <typename T>
 void map_remove(Map<T> *h, HashKey const &key) {
+	map_trace(MapTraceTable_Map, MapTraceOp_Remove, h, key.key);
 	MapFindResult fr = map__find(h, key);
 	if (fr.entry_index >= 0) {
 		map__erase(h, fr);
@@ -264,16 +405,18 @@ void map_remove(Map<T> *h, HashKey const &key) {
 
 template <typename T>
 gb_inline void map_clear(Map<T> *h) {
+	map_trace(MapTraceTable_Map, MapTraceOp_Clear, h, 0);
 	array_clear(&h->entries);
-	for (isize i = 0; i < h->hashes.count; i++) {
-		h->hashes.data[i] = -1;
-	}
+	map_slots_clear(h->hashes.data, h->hashes.count);
 }
 
 
 #if MAP_ENABLE_MULTI_MAP
+// NOTE: Entries sharing a key share a home slot, so they all sit in the same probe sequence,
+// newest first. Removing an entry or rehashing keeps this order
 template <typename T>
 MapEntry<T> *multi_map_find_first(Map<T> *h, HashKey const &key) {
+	map_trace(MapTraceTable_Map, MapTraceOp_MultiFind, h, key.key);
 	isize i = map__find(h, key).entry_index;
 	if (i < 0) {
 		return nullptr;
@@ -283,12 +426,15 @@ MapEntry<T> *multi_map_find_first(Map<T> *h, HashKey const &key) {
 
 template <typename T>
 MapEntry<T> *multi_map_find_next(Map<T> *h, MapEntry<T> *e) {
-	isize i = e->next;
-	while (i >= 0) {
-		if (hash_key_equal(h->entries.data[i].key, e->key)) {
-			return &h->entries.data[i];
+	MapFindResult fr = map__find_from_entry(h, e);
+	GB_ASSERT(fr.entry_index >= 0);
+	u32 tag = map_hash_tag(e->key.key);
+	isize mask = h->hashes.count-1;
+	for (isize i = (fr.slot_index+1) & mask; h->hashes.data[i].index != MAP_SENTINEL; i = (i+1) & mask) {
+		MapSlot slot = h->hashes.data[i];
+		if (slot.tag == tag && hash_key_equal(h->entries.data[slot.index].key, e->key)) {
+			return &h->entries.data[slot.index];
 		}
-		i = h->entries.data[i].next;
 	}
 	return nullptr;
 }
@@ -316,21 +462,19 @@ void multi_map_get_all(Map<T> *h, HashKey const &key, T *items) {
 
 template <typename T>
 void multi_map_insert(Map<T> *h, HashKey const &key, T const &value) {
-	MapFindResult fr;
-	isize i;
+	map_trace(MapTraceTable_Map, MapTraceOp_MultiInsert, h, key.key);
 	if (h->hashes.count == 0) {
 		map_grow(h);
 	}
-	// Make
-	fr = map__find(h, key);
-	i = map__add_entry(h, key);
-	if (fr.entry_prev < 0) {
-		h->hashes.data[fr.hash_index] = i;
-	} else {
-		h->entries.data[fr.entry_prev].next = i;
-	}
-	h->entries.data[i].next = fr.entry_index;
-	h->entries.data[i].value = value;
+	// NOTE: Goes before any entries with the same key, so that it is found first
+	u32 tag = map_hash_tag(key.key);
+	MapFindResult fr = map__find(h, key, tag);
+	MapEntry<T> e = {};
+	e.key = key;
+	e.value = value;
+	array_add(&h->entries, e);
+	MapSlot slot = {cast(MapIndex)(h->entries.count-1), tag};
+	map_slots_insert_before(h->hashes.data, h->hashes.count, fr.slot_index, slot);
 	// Grow if needed
 	if (map__full(h)) {
 		map_grow(h);
@@ -0,0 +1,285 @@
+// NOTE: With -checked-cache, a record is kept for every package which has been type checked without any
+// errors or warnings. Its key covers the compiler, the settings visible to the source, the contents of the
+// package's files, the keys of every package it imports and the key of the runtime, which every package
+// uses without importing it. When a later build finds a record with the
+// same key, it already knows that every declaration within the package checks, so the package is treated
+// as if each of its files were tagged `+lazy`: only the declarations which the program uses are checked.
+
+#define PACKAGE_CACHE_MAGIC   "odinpkc"
+#define PACKAGE_CACHE_VERSION 1
+
+// NOTE: Fixed layout, followed by the package's fullpath, so that a record can be read in place
+struct PackageCacheRecord {
+	char magic[8];
+	u32  version;
+	u32  fullpath_len;
+	u64  key;
+};
+
+struct PackageCache {
+	u64                     settings_hash;
+	u64                     runtime_key; // 0 if the program has no runtime package
+	StringMap<AstPackage *> package_map; // Key: fullpath
+	Map<u64>                keys;        // Key: AstPackage *; 0 if the package cannot have a record
+	PtrSet<AstPackage *>    adopted;
+};
+
+gb_global PackageCache package_cache;
+
+
+bool package_cache_enabled(void) {
+	BuildContext *bc = &build_context;
+	if (bc->checked_cache_dir.len == 0 || bc->ignore_lazy) {
+		return false;
+	}
+	// NOTE: These need every declaration to be checked, not just the ones which are used
+	switch (bc->command_kind) {
+	case Command_run:
+	case Command_build:
+	case Command_check:
+		return !bc->show_unused;
+	}
+	return false;
+}
+
+u64 package_cache_settings_hash(void) {
+	BuildContext *bc = &build_context;
+	u64 h = fnv64a(ODIN_VERSION.text, ODIN_VERSION.len);
+#ifdef GIT_SHA
+	h = hash_combine_u64(h, fnv64a(GIT_SHA, gb_strlen(GIT_SHA)));
+#endif
+	h = hash_combine_u64(h, fnv64a(bc->ODIN_ROOT.text, bc->ODIN_ROOT.len));
+	h = hash_combine_u64(h, cast(u64)bc->metrics.os);
+	h = hash_combine_u64(h, cast(u64)bc->metrics.arch);
+	h = hash_combine_u64(h, cast(u64)bc->command_kind);
+
+	bool flags[] = {
+		bc->ODIN_DEBUG,
+		bc->ODIN_DISABLE_ASSERT,
+		bc->ODIN_DEFAULT_TO_NIL_ALLOCATOR,
+		bc->no_dynamic_literals,
+		bc->no_entry_point,
+		bc->vet,
+		bc->vet_extra,
+		bc->disallow_do,
+		bc->insert_semicolon,
+		bc->ignore_warnings,
+		bc->warnings_as_errors,
+		bc->ignore_unknown_attributes,
+	};
+	for (isize i = 0; i < gb_count_of(flags); i++) {
+		h = hash_combine_u64(h, cast(u64)flags[i]);
+	}
+
+	// NOTE: Summed, so that the order of the entries does not matter
+	u64 defines = 0;
+	for_array(i, bc->defined_values.entries) {
+		char const *name = cast(char const *)cast(uintptr)bc->defined_values.entries[i].key.key;
+		ExactValue value = bc->defined_values.entries[i].value;
+		defines += hash_combine_u64(fnv64a(name, gb_strlen(name)), hash_exact_value_identity(value));
+	}
+	return hash_combine_u64(h, defines);
+}
+
+u64 package_cache_files_hash(AstPackage *pkg) {
+	// NOTE: Summed, so that the order in which the files were parsed does not matter
+	u64 files = 0;
+	for_array(i, pkg->files) {
+		AstFile *f = pkg->files[i];
+		u64 path_hash = fnv64a(f->fullpath.text, f->fullpath.len);
+		u64 data_hash = fnv64a(f->tokenizer.start, f->tokenizer.end - f->tokenizer.start);
+		files += hash_combine_u64(path_hash, data_hash);
+	}
+	return files;
+}
+
+// NOTE: The runtime imports packages which import the runtime, so rather than following the cycle, its key
+// covers the contents of every package which it reaches
+u64 package_cache_runtime_key(AstPackage *runtime) {
+	PtrSet<AstPackage *> seen = {};
+	ptr_set_init(&seen, heap_allocator());
+	defer (ptr_set_destroy(&seen));
+
+	auto queue = array_make<AstPackage *>(heap_allocator(), 0, 16);
+	defer (array_free(&queue));
+	ptr_set_add(&seen, runtime);
+	array_add(&queue, runtime);
+
+	u64 contents = 0;
+	for (isize q = 0; q < queue.count; q++) {
+		AstPackage *pkg = queue[q];
+		contents += hash_combine_u64(fnv64a(pkg->fullpath.text, pkg->fullpath.len), package_cache_files_hash(pkg));
+		for_array(i, pkg->files) {
+			AstFile *f = pkg->files[i];
+			for_array(j, f->imports) {
+				Ast *decl = f->imports[j];
+				if (decl->kind != Ast_ImportDecl) {
+					continue;
+				}
+				AstPackage **import = string_map_get(&package_cache.package_map, decl->ImportDecl.fullpath);
+				if (import != nullptr && !ptr_set_update(&seen, *import)) {
+					array_add(&queue, *import);
+				}
+			}
+		}
+	}
+	return hash_combine_u64(package_cache.settings_hash, contents) | 1;
+}
+
+u64 package_cache_key(AstPackage *pkg) {
+	u64 *found = map_get(&package_cache.keys, hash_pointer(pkg));
+	if (found != nullptr) {
+		return *found;
+	}
+	if (pkg->kind == Package_Runtime) {
+		u64 key = package_cache_runtime_key(pkg);
+		map_set(&package_cache.keys, hash_pointer(pkg), key);
+		return key;
+	}
+	// NOTE: An import cycle, which the checker reports, leaves the key as 0
+	map_set(&package_cache.keys, hash_pointer(pkg), cast(u64)0);
+
+	u64 imports = 0;
+	PtrSet<AstPackage *> seen = {};
+	ptr_set_init(&seen, heap_allocator());
+	defer (ptr_set_destroy(&seen));
+
+	for_array(i, pkg->files) {
+		AstFile *f = pkg->files[i];
+		for_array(j, f->imports) {
+			Ast *decl = f->imports[j];
+			if (decl->kind != Ast_ImportDecl) {
+				continue;
+			}
+			AstPackage **import = string_map_get(&package_cache.package_map, decl->ImportDecl.fullpath);
+			if (import == nullptr || ptr_set_update(&seen, *import)) {
+				continue;
+			}
+			u64 import_key = package_cache_key(*import);
+			if (import_key == 0) {
+				return 0;
+			}
+			imports += import_key;
+		}
+	}
+
+	u64 key = hash_combine_u64(package_cache.settings_hash, fnv64a(pkg->fullpath.text, pkg->fullpath.len));
+	key = hash_combine_u64(key, package_cache_files_hash(pkg));
+	key = hash_combine_u64(key, imports);
+	key = hash_combine_u64(key, package_cache.runtime_key);
+	key |= 1; // NOTE: Never 0
+	map_set(&package_cache.keys, hash_pointer(pkg), key);
+	return key;
+}
+
+String package_cache_record_path(AstPackage *pkg) {
+	char buf[32] = {};
+	isize len = gb_snprintf(buf, gb_size_of(buf), "%016llx.pkc", cast(unsigned long long)fnv64a(pkg->fullpath.text, pkg->fullpath.len))-1;
+	return concatenate3_strings(permanent_allocator(), build_context.checked_cache_dir, STR_LIT("/"), make_string(cast(u8 *)buf, len));
+}
+
+bool package_cache_can_record(AstPackage *pkg) {
+	// NOTE: The runtime is looked up by the compiler itself, and the initial package is the one being worked on
+	return pkg->kind == Package_Normal && !pkg->is_extra;
+}
+
+void package_cache_adopt(Parser *p) {
+	package_cache.settings_hash = package_cache_settings_hash();
+	string_map_init(&package_cache.package_map, heap_allocator(), p->packages.count);
+	map_init(&package_cache.keys, heap_allocator(), p->packages.count);
+	ptr_set_init(&package_cache.adopted, heap_allocator(), p->packages.count);
+
+	for_array(i, p->packages) {
+		AstPackage *pkg = p->packages[i];
+		string_map_set(&package_cache.package_map, pkg->fullpath, pkg);
+	}
+	package_cache.runtime_key = 0;
+	for_array(i, p->packages) {
+		AstPackage *pkg = p->packages[i];
+		if (pkg->kind == Package_Runtime) {
+			package_cache.runtime_key = package_cache_key(pkg);
+			break;
+		}
+	}
+
+	for_array(i, p->packages) {
+		AstPackage *pkg = p->packages[i];
+		if (!package_cache_can_record(pkg)) {
+			continue;
+		}
+		u64 key = package_cache_key(pkg);
+		if (key == 0) {
+			continue;
+		}
+
+		String path = package_cache_record_path(pkg);
+		gbFileContents fc = gb_file_read_contents(heap_allocator(), false, cast(char const *)path.text);
+		if (fc.data == nullptr) {
+			continue;
+		}
+		defer (gb_file_free_contents(&fc));
+		if (fc.size < gb_size_of(PackageCacheRecord)) {
+			continue;
+		}
+		PackageCacheRecord *record = cast(PackageCacheRecord *)fc.data;
+		if (gb_memcompare(record->magic, PACKAGE_CACHE_MAGIC, gb_size_of(record->magic)) != 0 ||
+		    record->version != PACKAGE_CACHE_VERSION ||
+		    record->key != key ||
+		    fc.size != gb_size_of(PackageCacheRecord) + record->fullpath_len) {
+			continue;
+		}
+		String fullpath = make_string(cast(u8 *)(record+1), record->fullpath_len);
+		if (fullpath != pkg->fullpath) {
+			continue;
+		}
+
+		ptr_set_add(&package_cache.adopted, pkg);
+		for_array(j, pkg->files) {
+			pkg->files[j]->flags |= AstFile_IsLazy;
+		}
+	}
+	debugf("Adopted %td of %td packages from the checked package cache\n", package_cache.adopted.entries.count, p->packages.count);
+}
+
+void package_cache_write_records(Parser *p) {
+	if (any_errors() || global_error_collector.warning_count.load() != 0) {
+		return;
+	}
+	for_array(i, p->packages) {
+		AstPackage *pkg = p->packages[i];
+		if (!package_cache_can_record(pkg) || ptr_set_exists(&package_cache.adopted, pkg)) {
+			continue;
+		}
+		u64 key = package_cache_key(pkg);
+		if (key == 0) {
+			continue;
+		}
+
+		PackageCacheRecord record = {};
+		gb_memmove(record.magic, PACKAGE_CACHE_MAGIC, gb_size_of(record.magic));
+		record.version      = PACKAGE_CACHE_VERSION;
+		record.fullpath_len = cast(u32)pkg->fullpath.len;
+		record.key          = key;
+
+		// NOTE: Written to a file of its own first, so that other builds sharing the cache never see a partial record
+		String path = package_cache_record_path(pkg);
+		gbString tmp = gb_string_make(heap_allocator(), "");
+		defer (gb_string_free(tmp));
+		tmp = gb_string_append_fmt(tmp, "%.*s.%u.tmp", LIT(path), thread_current_id());
+
+		gbFile f = {};
+		if (gb_file_create(&f, tmp) != gbFileError_None) {
+			continue;
+		}
+		bool ok = gb_file_write(&f, &record, gb_size_of(record)) &&
+		          gb_file_write(&f, pkg->fullpath.text, pkg->fullpath.len);
+		gb_file_close(&f);
+		if (ok) {
+			gb_file_remove(cast(char const *)path.text);
+			ok = gb_file_move(tmp, cast(char const *)path.text);
+		}
+		if (!ok) {
+			gb_file_remove(tmp);
+		}
+	}
+}
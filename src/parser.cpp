@@ -1145,9 +1145,59 @@ Ast *ast_attribute(AstFile *f, Token token, Token open, Token close, Array<Ast *
 }
 
 
+// NOTE: Only tokens from `curr_token_index` onwards may be requested, and the result is only valid
+// until the next call as the ring buffer may grow. Returns nullptr past the end of the file
+Token *file_token_at(AstFile *f, isize index) {
+	GB_ASSERT(index >= f->curr_token_index);
+	if (!f->stream_tokens) {
+		if (index < f->tokens.count) {
+			return &f->tokens[index];
+		}
+		return nullptr;
+	}
+
+	while (f->token_ring_end <= index) {
+		if (f->token_ring_end > 0 && f->token_ring[(f->token_ring_end-1) & f->token_ring_mask].kind == Token_EOF) {
+			return nullptr;
+		}
+		if (f->token_ring_end - f->curr_token_index > f->token_ring_mask) {
+			// NOTE: Only needed when looking ahead over many comments
+			isize old_mask = f->token_ring_mask;
+			Token *old_ring = f->token_ring;
+			f->token_ring_mask = 2*(old_mask+1) - 1;
+			f->token_ring = gb_alloc_array(heap_allocator(), Token, f->token_ring_mask+1);
+			for (isize i = f->curr_token_index; i < f->token_ring_end; i++) {
+				f->token_ring[i & f->token_ring_mask] = old_ring[i & old_mask];
+			}
+			gb_free(heap_allocator(), old_ring);
+		}
+		Token *token = &f->token_ring[f->token_ring_end & f->token_ring_mask];
+		tokenizer_get_token(&f->tokenizer, token);
+		if (token->kind == Token_Invalid) {
+			// NOTE: The file fails as a whole, as smaller files do when tokenized up front. The stream
+			// ends here, and the errors which the parser finds in what is left are not reported
+			f->stream_invalid_pos = token->pos;
+			token->kind = Token_EOF;
+			syntax_errors_muted = true;
+		}
+		f->token_ring_end += 1;
+		f->token_count += 1;
+	}
+	return &f->token_ring[index & f->token_ring_mask];
+}
+
+Token file_token_after_curr(AstFile *f) {
+	Token *next = file_token_at(f, f->curr_token_index+1);
+	if (next != nullptr) {
+		return *next;
+	}
+	return f->curr_token;
+}
+
 bool next_token0(AstFile *f) {
-	if (f->curr_token_index+1 < f->tokens.count) {
-		f->curr_token = f->tokens[++f->curr_token_index];
+	if (Token *next = file_token_at(f, f->curr_token_index+1)) {
+		f->curr_token_index += 1;
+		f->curr_token = *next;
 		return true;
 	}
 	syntax_error(f->curr_token, "Token is EOF");
@@ -1259,23 +1309,29 @@ Token advance_token(AstFile *f) {
 }
 
 bool peek_token_kind(AstFile *f, TokenKind kind) {
-	for (isize i = f->curr_token_index+1; i < f->tokens.count; i++) {
-		Token tok = f->tokens[i];
-		if (kind != Token_Comment && tok.kind == Token_Comment) {
+	for (isize i = f->curr_token_index+1; ; i++) {
+		Token *tok = file_token_at(f, i);
+		if (tok == nullptr) {
+			break;
+		}
+		if (kind != Token_Comment && tok->kind == Token_Comment) {
 			continue;
 		}
-		return tok.kind == kind;
+		return tok->kind == kind;
 	}
 	return false;
 }
 
 Token peek_token(AstFile *f) {
-	for (isize i = f->curr_token_index+1; i < f->tokens.count; i++) {
-		Token tok = f->tokens[i];
-		if (tok.kind == Token_Comment) {
+	for (isize i = f->curr_token_index+1; ; i++) {
+		Token *tok = file_token_at(f, i);
+		if (tok == nullptr) {
+			break;
+		}
+		if (tok->kind == Token_Comment) {
 			continue;
 		}
-		return tok;
+		return *tok;
 	}
 	return {};
 }
@@ -1327,7 +1383,8 @@ Token expect_token(AstFile *f, TokenKind kind) {
 		String c = token_strings[kind];
 		String p = token_to_string(prev);
 		syntax_error(f->curr_token, "Expected '%.*s', got '%.*s'", LIT(c), LIT(p));
-		if (prev.kind == Token_EOF) {
+		// NOTE: A file which has already failed is parsed to its end, and is reported once that is done
+		if (prev.kind == Token_EOF && !syntax_errors_muted) {
 			gb_exit(1);
 		}
 	}
@@ -1882,11 +1939,7 @@ Ast *convert_stmt_to_expr(AstFile *f, Ast *statement, String kind) {
 	}
 
 	syntax_error(f->curr_token, "Expected '%.*s', found a simple statement.", LIT(kind));
-	Token end = f->curr_token;
-	if (f->tokens.count < f->curr_token_index) {
-		end = f->tokens[f->curr_token_index+1];
-	}
-	return ast_bad_expr(f, f->curr_token, end);
+	return ast_bad_expr(f, f->curr_token, f->curr_token);
 }
 
 Ast *convert_stmt_to_body(AstFile *f, Ast *stmt) {
@@ -3996,7 +4049,7 @@ Ast *parse_if_stmt(AstFile *f) {
 		} break;
 		default:
 			syntax_error(f->curr_token, "Expected if statement block statement");
-			else_stmt = ast_bad_stmt(f, f->curr_token, f->tokens[f->curr_token_index+1]);
+			else_stmt = ast_bad_stmt(f, f->curr_token, file_token_after_curr(f));
 			break;
 		}
 	}
@@ -4053,7 +4106,7 @@ Ast *parse_when_stmt(AstFile *f) {
 		} break;
 		default:
 			syntax_error(f->curr_token, "Expected when statement block statement");
-			else_stmt = ast_bad_stmt(f, f->curr_token, f->tokens[f->curr_token_index+1]);
+			else_stmt = ast_bad_stmt(f, f->curr_token, file_token_after_curr(f));
 			break;
 		}
 	}
@@ -4730,6 +4783,8 @@ Array<Ast *> parse_stmt_list(AstFile *f) {
 	return list;
 }
 
+// NOTE: Smaller files keep tokenizing up front, their token arrays are small enough
+#define PARSER_STREAM_TOKENS_MIN_FILE_SIZE (256*1024)
 
 ParseFileError init_ast_file(AstFile *f, String fullpath, TokenPos *err_pos) {
 	GB_ASSERT(f != nullptr);
@@ -4768,43 +4823,64 @@ ParseFileError init_ast_file(AstFile *f, String fullpath, TokenPos *err_pos) {
 	isize pow2_cap = gb_max(cast(isize)prev_pow2(cast(i64)token_cap)/2, 16);
 	token_cap = ((token_cap + pow2_cap-1)/pow2_cap) * pow2_cap;
 
-	isize init_token_cap = gb_max(token_cap, 16);
-	array_init(&f->tokens, heap_allocator(), 0, gb_max(init_token_cap, 16));
-
-	if (err == TokenizerInit_Empty) {
-		Token token = {Token_EOF};
-		token.pos.file_id = f->id;
-		token.pos.line    = 1;
-		token.pos.column  = 1;
-		array_add(&f->tokens, token);
-		return ParseFile_None;
-	}
-
-	u64 start = time_stamp_time_now();
+	f->stream_tokens = err == TokenizerInit_None && file_size >= PARSER_STREAM_TOKENS_MIN_FILE_SIZE;
+	f->curr_token_index = 0;
 
-	for (;;) {
-		Token *token = array_add_and_get(&f->tokens);
-		tokenizer_get_token(&f->tokenizer, token);
-		if (token->kind == Token_Invalid) {
-			err_pos->line   = token->pos.line;
-			err_pos->column = token->pos.column;
+	if (f->stream_tokens) {
+		// NOTE: The file is tokenized as it is parsed, so its tokenizing time is part of `time_to_parse`
+		f->token_ring_mask = 16-1;
+		f->token_ring = gb_alloc_array(heap_allocator(), Token, f->token_ring_mask+1);
+		f->token_ring_end = 0;
+		f->first_token = *file_token_at(f, 0);
+		if (f->stream_invalid_pos.line != 0) {
+			syntax_errors_muted = false;
+			err_pos->line   = f->stream_invalid_pos.line;
+			err_pos->column = f->stream_invalid_pos.column;
 			return ParseFile_InvalidToken;
 		}
+	} else {
+		isize init_token_cap = gb_max(token_cap, 16);
+		array_init(&f->tokens, heap_allocator(), 0, gb_max(init_token_cap, 16));
 
-		if (token->kind == Token_EOF) {
-			break;
+		if (err == TokenizerInit_Empty) {
+			Token token = {Token_EOF};
+			token.pos.file_id = f->id;
+			token.pos.line    = 1;
+			token.pos.column  = 1;
+			array_add(&f->tokens, token);
+			f->first_token = token;
+			f->token_count = f->tokens.count;
+			return ParseFile_None;
 		}
-	}
 
-	u64 end = time_stamp_time_now();
-	f->time_to_tokenize = cast(f64)(end-start)/cast(f64)time_stamp__freq();
+		u64 start = time_stamp_time_now();
 
-	f->curr_token_index = 0;
-	f->prev_token = f->tokens[f->curr_token_index];
-	f->curr_token = f->tokens[f->curr_token_index];
+		for (;;) {
+			Token *token = array_add_and_get(&f->tokens);
+			tokenizer_get_token(&f->tokenizer, token);
+			if (token->kind == Token_Invalid) {
+				err_pos->line   = token->pos.line;
+				err_pos->column = token->pos.column;
+				return ParseFile_InvalidToken;
+			}
+
+			if (token->kind == Token_EOF) {
+				break;
+			}
+		}
+
+		u64 end = time_stamp_time_now();
+		f->time_to_tokenize = cast(f64)(end-start)/cast(f64)time_stamp__freq();
+
+		f->first_token = f->tokens[0];
+		f->token_count = f->tokens.count;
+	}
+
+	f->prev_token = f->first_token;
+	f->curr_token = f->first_token;
 
 	isize const page_size = 4*1024;
-	isize block_size = 2*f->tokens.count*gb_size_of(Ast);
+	isize block_size = 2*(f->stream_tokens ? token_cap : f->tokens.count)*gb_size_of(Ast);
 	block_size = ((block_size + page_size-1)/page_size) * page_size;
 	block_size = gb_clamp(block_size, page_size, ARENA_DEFAULT_BLOCK_SIZE);
 
@@ -4822,6 +4898,7 @@ ParseFileError init_ast_file(AstFile *f, String fullpath, TokenPos *err_pos) {
 void destroy_ast_file(AstFile *f) {
 	GB_ASSERT(f != nullptr);
 	array_free(&f->tokens);
+	gb_free(heap_allocator(), f->token_ring);
 	array_free(&f->comments);
 	array_free(&f->imports);
 	gb_free(heap_allocator(), f->tokenizer.fullpath.text);
@@ -4833,10 +4910,10 @@ bool init_parser(Parser *p) {
 	string_set_init(&p->imported_files, heap_allocator());
 	array_init(&p->packages, heap_allocator());
 	array_init(&p->package_imports, heap_allocator());
-	mutex_init(&p->import_mutex);
-	mutex_init(&p->file_add_mutex);
-	mutex_init(&p->file_decl_mutex);
-	mutex_init(&p->packages_mutex);
+	mutex_init(&p->import_mutex,    "import_mutex");
+	mutex_init(&p->file_add_mutex,  "file_add_mutex");
+	mutex_init(&p->file_decl_mutex, "file_decl_mutex");
+	mutex_init(&p->packages_mutex,  "packages_mutex");
 	mpmc_init(&p->file_error_queue, heap_allocator(), 1024);
 	return true;
 }
@@ -4887,9 +4964,13 @@ WORKER_TASK_PROC(parser_worker_proc) {
 }
 
 
+// NOTE: File ids index the global file tables, so they must be unique across every parser within the process
+// and not just within one, as the compile server (see server.cpp) uses more than one
+gb_global std::atomic<isize> parser_file_index;
+
 void parser_add_file_to_process(Parser *p, AstPackage *pkg, FileInfo fi, TokenPos pos) {
 	// TODO(bill): Use a better allocator
-	ImportedFile f = {pkg, fi, pos, p->file_to_process_count++};
+	ImportedFile f = {pkg, fi, pos, parser_file_index.fetch_add(1)};
 	auto wd = gb_alloc_item(heap_allocator(), ParserWorkerData);
 	wd->parser = p;
 	wd->imported_file = f;
@@ -4927,7 +5008,7 @@ WORKER_TASK_PROC(foreign_file_worker_proc) {
 
 void parser_add_foreign_file_to_process(Parser *p, AstPackage *pkg, AstForeignFileKind kind, FileInfo fi, TokenPos pos) {
 	// TODO(bill): Use a better allocator
-	ImportedFile f = {pkg, fi, pos, p->file_to_process_count++};
+	ImportedFile f = {pkg, fi, pos, parser_file_index.fetch_add(1)};
 	auto wd = gb_alloc_item(heap_allocator(), ForeignFileWorkerData);
 	wd->parser = p;
 	wd->imported_file = f;
@@ -5446,10 +5527,10 @@ isize calc_decl_count(Ast *decl) {
 }
 
 bool parse_file(Parser *p, AstFile *f) {
-	if (f->tokens.count == 0) {
+	if (f->token_count == 0) {
 		return true;
 	}
-	if (f->tokens.count > 0 && f->tokens[0].kind == Token_EOF) {
+	if (f->token_count > 0 && f->first_token.kind == Token_EOF) {
 		return true;
 	}
 
@@ -5560,6 +5641,8 @@ ParseFileError process_imported_file(Parser *p, ImportedFile imported_file) {
 	FileInfo    fi  = imported_file.fi;
 	TokenPos    pos = imported_file.pos;
 
+	TRACE_SPAN(str_lit("parse file"), fi.fullpath);
+
 	AstFile *file = gb_alloc_item(heap_allocator(), AstFile);
 	file->pkg = pkg;
 	file->id = cast(i32)(imported_file.index+1);
@@ -5613,7 +5696,19 @@ ParseFileError process_imported_file(Parser *p, ImportedFile imported_file) {
 		}
 	}
 
-	if (parse_file(p, file)) {
+	bool parsed = parse_file(p, file);
+	if (file->stream_invalid_pos.line != 0) {
+		syntax_errors_muted = false;
+		file->last_error = ParseFile_InvalidToken;
+		TokenPos invalid_pos = {};
+		invalid_pos.file_id = file->id;
+		invalid_pos.line    = file->stream_invalid_pos.line;
+		invalid_pos.column  = file->stream_invalid_pos.column;
+		syntax_error(invalid_pos, "Failed to parse file: %.*s; invalid token found in file", LIT(fi.name));
+		return ParseFile_InvalidToken;
+	}
+
+	if (parsed) {
 		mutex_lock(&p->file_add_mutex);
 		defer (mutex_unlock(&p->file_add_mutex));
 
@@ -5622,7 +5717,7 @@ ParseFileError process_imported_file(Parser *p, ImportedFile imported_file) {
 		if (pkg->name.len == 0) {
 			pkg->name = file->package_name;
 		} else if (pkg->name != file->package_name) {
-			if (file->tokens.count > 0 && file->tokens[0].kind != Token_EOF) {
+			if (file->token_count > 0 && file->first_token.kind != Token_EOF) {
 				Token tok = file->package_token;
 				tok.pos.file_id = file->id;
 				tok.pos.line = gb_max(tok.pos.line, 1);
@@ -5632,13 +5727,15 @@ ParseFileError process_imported_file(Parser *p, ImportedFile imported_file) {
 		}
 
 		p->total_line_count += file->tokenizer.line_count;
-		p->total_token_count += file->tokens.count;
+		p->total_token_count += file->token_count;
 	}
 
 	return ParseFile_None;
 }
 
 
+ParseFileError parser_first_error(Parser *p);
+
 ParseFileError parse_packages(Parser *p, String init_filename) {
 	GB_ASSERT(init_filename.text[init_filename.len] == 0);
 
@@ -5688,6 +5785,35 @@ ParseFileError parse_packages(Parser *p, String init_filename) {
 	thread_pool_start(&parser_thread_pool);
 	thread_pool_wait_to_process(&parser_thread_pool);
 
+	return parser_first_error(p);
+}
+
+// NOTE: Parses the runtime and the given packages, along with everything they import, ahead of any build.
+// Used by the compile server (see server.cpp), each build is forked from it and parse_packages continues
+// from where this left off
+ParseFileError parse_resident_packages(Parser *p, Array<String> const &fullpaths) {
+	isize thread_count = gb_max(build_context.thread_count, 1);
+	isize worker_count = thread_count-1;
+	thread_pool_init(&parser_thread_pool, heap_allocator(), worker_count, "ParserWork");
+	// NOTE: fork only copies the calling thread, so none may be left behind
+	defer (thread_pool_destroy(&parser_thread_pool));
+
+	TokenPos init_pos = {};
+	{
+		String s = get_fullpath_core(heap_allocator(), str_lit("runtime"));
+		try_add_import_path(p, s, s, init_pos, Package_Runtime);
+	}
+	for_array(i, fullpaths) {
+		try_add_import_path(p, fullpaths[i], fullpaths[i], init_pos, Package_Normal);
+	}
+
+	thread_pool_start(&parser_thread_pool);
+	thread_pool_wait_to_process(&parser_thread_pool);
+
+	return parser_first_error(p);
+}
+
+ParseFileError parser_first_error(Parser *p) {
 	for (ParseFileError err = ParseFile_None; mpmc_dequeue(&p->file_error_queue, &err); /**/) {
 		if (err != ParseFile_None) {
 			return err;
@@ -99,11 +99,22 @@ struct AstFile {
 
 	Ast *        pkg_decl;
 	String       fullpath;
+	u32          path_order; // Rank of `fullpath` among every parsed file, see check_set_file_path_orders
 	Tokenizer    tokenizer;
-	Array<Token> tokens;
+	Array<Token> tokens;     // Every token in the file, empty when `stream_tokens` is set
 	isize        curr_token_index;
 	Token        curr_token;
 	Token        prev_token; // previous non-comment
+	Token        first_token;
+	isize        token_count;
+
+	// NOTE: Large files are not tokenized up front, rather the parser pulls the tokens it needs
+	// through a small ring buffer of lookahead which starts at `curr_token_index`
+	bool         stream_tokens;
+	Token *      token_ring;
+	isize        token_ring_mask;
+	isize        token_ring_end; // Index of the next token to be read from the tokenizer
+	TokenPos     stream_invalid_pos; // Set once the stream reaches an invalid token, which ends the file
 	Token        package_token;
 	String       package_name;
 
@@ -188,7 +199,6 @@ struct Parser {
 	StringSet                 imported_files; // fullpath
 	Array<AstPackage *>       packages;
 	Array<ImportedPackage>    package_imports;
-	isize                     file_to_process_count;
 	isize                     total_token_count;
 	isize                     total_line_count;
 	BlockingMutex             import_mutex;
@@ -1,23 +1,20 @@
-typedef u32 PtrSetIndex;
+typedef MapIndex PtrSetIndex;
 
 struct PtrSetFindResult {
-	PtrSetIndex hash_index;
-	PtrSetIndex entry_prev;
-	PtrSetIndex entry_index;
+	isize slot_index;  // The slot of the entry, or the empty slot where it would be inserted
+	isize entry_index;
 };
 
-enum : PtrSetIndex { PTR_SET_SENTINEL = ~(PtrSetIndex)0 };
-
 
 template <typename T>
 struct PtrSetEntry {
-	T           ptr;
-	PtrSetIndex next;
+	T ptr;
 };
 
+// NOTE: Laid out the same way as `Map`, see `MapSlot`
 template <typename T>
 struct PtrSet {
-	Array<PtrSetIndex>    hashes;
+	Slice<MapSlot>        hashes;
 	Array<PtrSetEntry<T>> entries;
 };
 
@@ -34,180 +31,142 @@ template <typename T> void ptr_set_rehash (PtrSet<T> *s, isize new_count);
 
 template <typename T>
 void ptr_set_init(PtrSet<T> *s, gbAllocator a, isize capacity) {
+	map_trace(MapTraceTable_PtrSet, MapTraceOp_Init, s, cast(u64)capacity);
 	capacity = next_pow2_isize(gb_max(16, capacity));
 
-	array_init(&s->hashes,  a, capacity);
+	slice_init(&s->hashes,  a, capacity);
 	array_init(&s->entries, a, 0, capacity);
-	for (isize i = 0; i < capacity; i++) {
-		s->hashes.data[i] = PTR_SET_SENTINEL;
-	}
+	map_slots_clear(s->hashes.data, s->hashes.count);
 }
 
 template <typename T>
 void ptr_set_destroy(PtrSet<T> *s) {
-	array_free(&s->hashes);
+	map_trace(MapTraceTable_PtrSet, MapTraceOp_Destroy, s, 0);
+	slice_free(&s->hashes, s->entries.allocator);
 	array_free(&s->entries);
 }
 
 template <typename T>
-gb_internal PtrSetIndex ptr_set__add_entry(PtrSet<T> *s, T ptr) {
+gb_inline u32 ptr_set__hash_tag(T ptr) {
+	return map_hash_tag(cast(u64)cast(uintptr)ptr);
+}
+
+template <typename T>
+gb_internal PtrSetIndex ptr_set__add_entry(PtrSet<T> *s, PtrSetFindResult const &fr, T ptr, u32 tag) {
 	PtrSetEntry<T> e = {};
 	e.ptr = ptr;
-	e.next = PTR_SET_SENTINEL;
 	array_add(&s->entries, e);
-	return cast(PtrSetIndex)(s->entries.count-1);
+	PtrSetIndex index = cast(PtrSetIndex)(s->entries.count-1);
+	s->hashes.data[fr.slot_index].index = index;
+	s->hashes.data[fr.slot_index].tag   = tag;
+	return index;
 }
 
 
 template <typename T>
-gb_internal PtrSetFindResult ptr_set__find(PtrSet<T> *s, T ptr) {
-	PtrSetFindResult fr = {PTR_SET_SENTINEL, PTR_SET_SENTINEL, PTR_SET_SENTINEL};
+gb_internal PtrSetFindResult ptr_set__find(PtrSet<T> *s, T ptr, u32 tag) {
+	PtrSetFindResult fr = {-1, -1};
 	if (s->hashes.count != 0) {
-		u64 hash = 0xcbf29ce484222325ull ^ cast(u64)cast(uintptr)ptr;
-		u64 n = cast(u64)s->hashes.count;
-		fr.hash_index = cast(PtrSetIndex)(hash & (n-1));
-		fr.entry_index = s->hashes.data[fr.hash_index];
-		while (fr.entry_index != PTR_SET_SENTINEL) {
-			if (s->entries.data[fr.entry_index].ptr == ptr) {
-				return fr;
+		isize mask = s->hashes.count-1;
+		for (isize i = tag & mask; ; i = (i+1) & mask) {
+			MapSlot slot = s->hashes.data[i];
+			if (slot.index == MAP_SENTINEL) {
+				fr.slot_index = i;
+				break;
+			}
+			if (slot.tag == tag && s->entries.data[slot.index].ptr == ptr) {
+				fr.slot_index = i;
+				fr.entry_index = slot.index;
+				break;
 			}
-			fr.entry_prev = fr.entry_index;
-			fr.entry_index = s->entries.data[fr.entry_index].next;
 		}
 	}
 	return fr;
 }
 
+template <typename T>
+gb_internal PtrSetFindResult ptr_set__find(PtrSet<T> *s, T ptr) {
+	return ptr_set__find(s, ptr, ptr_set__hash_tag(ptr));
+}
+
 template <typename T>
 gb_internal bool ptr_set__full(PtrSet<T> *s) {
-	return 0.75f * s->hashes.count <= s->entries.count;
+	return map_slots_full(s->hashes.count, s->entries.count);
 }
 
 template <typename T>
 gb_inline void ptr_set_grow(PtrSet<T> *s) {
-	isize new_count = s->hashes.count*2;
+	isize new_count = gb_max(s->hashes.count<<1, 16);
 	ptr_set_rehash(s, new_count);
 }
 
 template <typename T>
 void ptr_set_rehash(PtrSet<T> *s, isize new_count) {
-	isize i, j;
-	PtrSet<T> ns = {};
-	ptr_set_init(&ns, s->hashes.allocator);
-	array_resize(&ns.hashes, new_count);
-	array_reserve(&ns.entries, s->entries.count);
-	for (i = 0; i < new_count; i++) {
-		ns.hashes.data[i] = PTR_SET_SENTINEL;
-	}
-	for (i = 0; i < s->entries.count; i++) {
-		PtrSetEntry<T> *e = &s->entries.data[i];
-		PtrSetFindResult fr;
-		if (ns.hashes.count == 0) {
-			ptr_set_grow(&ns);
-		}
-		fr = ptr_set__find(&ns, e->ptr);
-		j = ptr_set__add_entry(&ns, e->ptr);
-		if (fr.entry_prev == PTR_SET_SENTINEL) {
-			ns.hashes.data[fr.hash_index] = cast(PtrSetIndex)j;
-		} else {
-			ns.entries.data[fr.entry_prev].next = cast(PtrSetIndex)j;
-		}
-		ns.entries.data[j].next = fr.entry_index;
-		if (ptr_set__full(&ns)) {
-			ptr_set_grow(&ns);
-		}
+	new_count = next_pow2_isize(new_count);
+	while (map_slots_full(new_count, s->entries.count)) {
+		new_count <<= 1;
 	}
-	ptr_set_destroy(s);
-	*s = ns;
+	map_slots_rehash(&s->hashes, s->entries.allocator, new_count);
 }
 
 template <typename T>
 gb_inline bool ptr_set_exists(PtrSet<T> *s, T ptr) {
-	isize index = ptr_set__find(s, ptr).entry_index;
-	return index != PTR_SET_SENTINEL;
+	map_trace(MapTraceTable_PtrSet, MapTraceOp_Get, s, cast(u64)cast(uintptr)ptr);
+	return ptr_set__find(s, ptr).entry_index >= 0;
 }
 
 // Returns true if it already exists
 template <typename T>
 T ptr_set_add(PtrSet<T> *s, T ptr) {
-	PtrSetIndex index;
-	PtrSetFindResult fr;
-	if (s->hashes.count == 0) {
-		ptr_set_grow(s);
-	}
-	fr = ptr_set__find(s, ptr);
-	if (fr.entry_index == PTR_SET_SENTINEL) {
-		index = ptr_set__add_entry(s, ptr);
-		if (fr.entry_prev != PTR_SET_SENTINEL) {
-			s->entries.data[fr.entry_prev].next = index;
-		} else {
-			s->hashes.data[fr.hash_index] = index;
-		}
-	}
-	if (ptr_set__full(s)) {
-		ptr_set_grow(s);
-	}
+	ptr_set_update(s, ptr);
 	return ptr;
 }
 
 template <typename T>
 bool ptr_set_update(PtrSet<T> *s, T ptr) { // returns true if it previously existsed
-	bool exists = false;
-	PtrSetIndex index;
-	PtrSetFindResult fr;
+	map_trace(MapTraceTable_PtrSet, MapTraceOp_Set, s, cast(u64)cast(uintptr)ptr);
 	if (s->hashes.count == 0) {
 		ptr_set_grow(s);
 	}
-	fr = ptr_set__find(s, ptr);
-	if (fr.entry_index != PTR_SET_SENTINEL) {
-		exists = true;
-	} else {
-		index = ptr_set__add_entry(s, ptr);
-		if (fr.entry_prev != PTR_SET_SENTINEL) {
-			s->entries.data[fr.entry_prev].next = index;
-		} else {
-			s->hashes.data[fr.hash_index] = index;
-		}
+	u32 tag = ptr_set__hash_tag(ptr);
+	PtrSetFindResult fr = ptr_set__find(s, ptr, tag);
+	if (fr.entry_index >= 0) {
+		return true;
 	}
+	ptr_set__add_entry(s, fr, ptr, tag);
 	if (ptr_set__full(s)) {
 		ptr_set_grow(s);
 	}
-	return exists;
+	return false;
 }
 
 
 
 template <typename T>
-void ptr_set__erase(PtrSet<T> *s, PtrSetFindResult fr) {
-	PtrSetFindResult last;
-	if (fr.entry_prev == PTR_SET_SENTINEL) {
-		s->hashes.data[fr.hash_index] = s->entries.data[fr.entry_index].next;
-	} else {
-		s->entries.data[fr.entry_prev].next = s->entries.data[fr.entry_index].next;
-	}
-	if (cast(isize)fr.entry_index == s->entries.count-1) {
-		array_pop(&s->entries);
-		return;
-	}
-	s->entries.data[fr.entry_index] = s->entries.data[s->entries.count-1];
-	last = ptr_set__find(s, s->entries.data[fr.entry_index].ptr);
-	if (last.entry_prev != PTR_SET_SENTINEL) {
-		s->entries.data[last.entry_prev].next = fr.entry_index;
-	} else {
-		s->hashes.data[last.hash_index] = fr.entry_index;
+void ptr_set__erase(PtrSet<T> *s, PtrSetFindResult const &fr) {
+	map_slots_erase(s->hashes.data, s->hashes.count, fr.slot_index);
+
+	isize last = s->entries.count-1;
+	if (fr.entry_index != last) {
+		s->entries.data[fr.entry_index] = s->entries.data[last];
+		u32 tag = ptr_set__hash_tag(s->entries.data[fr.entry_index].ptr);
+		map_slots_reindex(s->hashes.data, s->hashes.count, tag, cast(PtrSetIndex)last, cast(PtrSetIndex)fr.entry_index);
 	}
+	array_pop(&s->entries);
 }
 
 template <typename T>
 void ptr_set_remove(PtrSet<T> *s, T ptr) {
+	map_trace(MapTraceTable_PtrSet, MapTraceOp_Remove, s, cast(u64)cast(uintptr)ptr);
 	PtrSetFindResult fr = ptr_set__find(s, ptr);
-	if (fr.entry_index != PTR_SET_SENTINEL) {
+	if (fr.entry_index >= 0) {
 		ptr_set__erase(s, fr);
 	}
 }
 
 template <typename T>
 gb_inline void ptr_set_clear(PtrSet<T> *s) {
-	array_clear(&s->hashes);
+	map_trace(MapTraceTable_PtrSet, MapTraceOp_Clear, s, 0);
 	array_clear(&s->entries);
+	map_slots_clear(s->hashes.data, s->hashes.count);
 }
@@ -52,7 +52,7 @@ void mpmc_init(MPMCQueue<T> *q, gbAllocator a, isize size_i) {
 	size = next_pow2(size);
 	GB_ASSERT(gb_is_power_of_two(size));
 
-	mutex_init(&q->mutex);
+	mutex_init(&q->mutex, "MPMCQueue.mutex");
 	q->mask = size-1;
 	q->allocator = a;
 	q->nodes   = gb_alloc_array(a, T, size);
@@ -71,6 +71,37 @@ void mpmc_destroy(MPMCQueue<T> *q) {
 }
 
 
+// NOTE: The queued nodes are moved to the slots of their absolute index in the new ring,
+// otherwise a queue which has already wrapped around would never find a free slot again.
+// This assumes no consumer is dequeuing whilst the queue grows
+template <typename T>
+void mpmc_internal_grow(MPMCQueue<T> *q, i32 head_idx) {
+	i32 old_mask = q->mask;
+	i32 new_size = (old_mask+1)*2;
+	i32 new_mask = new_size-1;
+
+	T *                 nodes   = gb_alloc_array(q->allocator, T, new_size);
+	MPMCQueueAtomicIdx *indices = gb_alloc_array(q->allocator, MPMCQueueAtomicIdx, new_size);
+	if (nodes == nullptr || indices == nullptr) {
+		GB_PANIC("Unable to resize enqueue: %d -> %d", old_mask+1, new_size);
+	}
+
+	i32 tail_idx = q->tail_idx.load(std::memory_order_acquire);
+	for (i32 idx = tail_idx; idx != head_idx; idx++) {
+		nodes[idx & new_mask] = q->nodes[idx & old_mask];
+		indices[idx & new_mask].store(idx+1, std::memory_order_relaxed);
+	}
+	for (i32 idx = head_idx; idx != tail_idx+new_size; idx++) {
+		indices[idx & new_mask].store(idx, std::memory_order_relaxed);
+	}
+
+	gb_free(q->allocator, q->nodes);
+	gb_free(q->allocator, q->indices);
+	q->nodes   = nodes;
+	q->indices = indices;
+	q->mask    = new_mask;
+}
+
 template <typename T>
 i32 mpmc_enqueue(MPMCQueue<T> *q, T const &data) {
 	GB_ASSERT(q->mask != 0);
@@ -92,23 +123,12 @@ i32 mpmc_enqueue(MPMCQueue<T> *q, T const &data) {
 			}
 		} else if (diff < 0) {
 			mutex_lock(&q->mutex);
-			i32 old_size = q->mask+1;
-			i32 new_size = old_size*2;
-			resize_array_raw(&q->nodes, q->allocator, old_size, new_size);
-			if (q->nodes == nullptr) {
-				GB_PANIC("Unable to resize enqueue: %td -> %td", old_size, new_size);
-				mutex_unlock(&q->mutex);
-				return -1;
-			}
-			resize_array_raw(&q->indices, q->allocator, old_size, new_size);
-			if (q->indices == nullptr) {
-				GB_PANIC("Unable to resize enqueue: %td -> %td", old_size, new_size);
-				mutex_unlock(&q->mutex);
-				return -1;
+			head_idx = q->head_idx.load(std::memory_order_relaxed);
+			if (head_idx - q->tail_idx.load(std::memory_order_acquire) > q->mask) {
+				mpmc_internal_grow(q, head_idx);
 			}
-			mpmc_internal_init_indices(q->indices, old_size, new_size);
-			q->mask = new_size-1;
 			mutex_unlock(&q->mutex);
+			head_idx = q->head_idx.load(std::memory_order_relaxed);
 		} else {
 			head_idx = q->head_idx.load(std::memory_order_relaxed);
 		}
@@ -0,0 +1,545 @@
+// NOTE: `odin server <socket> [packages...]` parses the runtime and the given packages (along with
+// everything they import) once and keeps them resident. Each request on the Unix socket is handled by
+// a process forked from the server, which starts with those packages already parsed and parses only the
+// rest of the program. Type checking and code generation are still done for every build, as the checker
+// writes into the AST and checks the program as a whole.
+//
+// `-use-server:<socket>` hands a build to a running server along with the working directory and the
+// standard handles of the caller, and exits with the exit code of that build. When no server is
+// listening, the build is done locally as usual.
+
+#if defined(GB_SYSTEM_UNIX)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+struct CompileServerFile {
+	String     fullpath;
+	gbFileTime last_write_time;
+	gbFileTime hashed_time;
+	u64        hash;
+};
+
+struct CompileServer {
+	Array<String> package_paths;
+
+	Parser *                 parser; // nullptr when nothing is resident, e.g. a resident file fails to parse
+	PtrSet<AstPackage *>     packages;
+	Array<CompileServerFile> files;
+	Array<CompileServerFile> dirs;
+
+	// NOTE: Settings which change how files are parsed, builds with other settings parse everything themselves
+	TargetOsKind   os;
+	TargetArchKind arch;
+	bool           insert_semicolon;
+	bool           disallow_do;
+	bool           ignore_lazy;
+	Array<LibraryCollections> collections; // Imports of the resident packages were resolved against these
+
+	bool is_request; // Set within the process forked for a request
+};
+
+gb_global CompileServer compile_server;
+
+
+#if defined(GB_SYSTEM_UNIX)
+
+bool compile_server_hash_file(String const &fullpath, u64 *hash) {
+	gbFileContents fc = gb_file_read_contents(heap_allocator(), false, cast(char const *)fullpath.text);
+	if (fc.data == nullptr) {
+		// NOTE: gb reads no data for an empty file as well as for one which cannot be opened
+		gbFile f = {};
+		if (gb_file_open(&f, cast(char const *)fullpath.text) != gbFileError_None) {
+			return false;
+		}
+		gb_file_close(&f);
+		*hash = fnv64a(nullptr, 0);
+		return true;
+	}
+	*hash = fnv64a(fc.data, fc.size);
+	gb_file_free_contents(&fc);
+	return true;
+}
+
+void compile_server_reset_errors(void) {
+	global_error_collector.count = 0;
+	global_error_collector.warning_count = 0;
+	global_error_collector.prev = {};
+	array_clear(&global_error_collector.errors);
+	array_clear(&global_error_collector.error_buffer);
+}
+
+void compile_server_load(void) {
+	BuildContext *bc = &build_context;
+	compile_server.os               = bc->metrics.os;
+	compile_server.arch             = bc->metrics.arch;
+	compile_server.insert_semicolon = bc->insert_semicolon;
+	compile_server.disallow_do      = bc->disallow_do;
+	compile_server.ignore_lazy      = bc->ignore_lazy;
+	compile_server.collections      = array_clone(heap_allocator(), library_collections);
+	// NOTE: Requests which do not set 'shared' themselves get it added after their own collections
+	if (!find_library_collection_path(str_lit("shared"), nullptr)) {
+		LibraryCollections shared = {str_lit("shared"), get_fullpath_relative(heap_allocator(), odin_root_dir(), str_lit("shared"))};
+		array_add(&compile_server.collections, shared);
+	}
+
+	// NOTE: The previous parser is leaked, this only happens when a resident file changes
+	Parser *p = gb_alloc_item(permanent_allocator(), Parser);
+	init_parser(p);
+	bool ok = parse_resident_packages(p, compile_server.package_paths) == ParseFile_None && !any_errors();
+
+	gbFileTime now = cast(gbFileTime)time(nullptr);
+	ptr_set_init(&compile_server.packages, heap_allocator());
+	array_init(&compile_server.files, heap_allocator());
+	array_init(&compile_server.dirs, heap_allocator());
+	for_array(i, p->packages) {
+		AstPackage *pkg = p->packages[i];
+		ptr_set_add(&compile_server.packages, pkg);
+
+		CompileServerFile dir = {};
+		dir.fullpath = pkg->fullpath;
+		dir.last_write_time = gb_file_last_write_time(cast(char const *)pkg->fullpath.text);
+		array_add(&compile_server.dirs, dir);
+
+		for_array(j, pkg->files) {
+			CompileServerFile f = {};
+			f.fullpath = pkg->files[j]->fullpath;
+			f.last_write_time = gb_file_last_write_time(cast(char const *)f.fullpath.text);
+			f.hashed_time = now;
+			compile_server_hash_file(f.fullpath, &f.hash);
+			array_add(&compile_server.files, f);
+		}
+	}
+
+	if (ok) {
+		compile_server.parser = p;
+		gb_printf_err("%td packages resident (%td files)\n", p->packages.count, compile_server.files.count);
+	} else {
+		// NOTE: Keep the files, so that the packages are parsed again once they have been fixed
+		compile_server.parser = nullptr;
+		compile_server_reset_errors();
+		gb_printf_err("Failed to parse the resident packages, builds will parse everything until they are fixed\n");
+	}
+}
+
+bool compile_server_is_stale(void) {
+	for_array(i, compile_server.dirs) {
+		CompileServerFile *dir = &compile_server.dirs[i];
+		if (gb_file_last_write_time(cast(char const *)dir->fullpath.text) != dir->last_write_time) {
+			return true;
+		}
+	}
+
+	gbFileTime now = cast(gbFileTime)time(nullptr);
+	for_array(i, compile_server.files) {
+		CompileServerFile *f = &compile_server.files[i];
+		gbFileTime last_write_time = gb_file_last_write_time(cast(char const *)f->fullpath.text);
+		// NOTE: The times only have a resolution of a second, a file written within the same second
+		// that it was hashed may have changed without its time changing
+		if (last_write_time == f->last_write_time && last_write_time < f->hashed_time) {
+			continue;
+		}
+		u64 hash = 0;
+		if (!compile_server_hash_file(f->fullpath, &hash) || hash != f->hash) {
+			return true;
+		}
+		f->last_write_time = last_write_time;
+		f->hashed_time = now;
+	}
+	return false;
+}
+
+bool compile_server_write_all(int fd, void const *data, isize size) {
+	u8 const *ptr = cast(u8 const *)data;
+	while (size > 0) {
+		ssize_t n = write(fd, ptr, size);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		ptr += n;
+		size -= n;
+	}
+	return true;
+}
+
+bool compile_server_read_all(int fd, void *data, isize size) {
+	u8 *ptr = cast(u8 *)data;
+	while (size > 0) {
+		ssize_t n = read(fd, ptr, size);
+		if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		if (n <= 0) {
+			return false;
+		}
+		ptr += n;
+		size -= n;
+	}
+	return true;
+}
+
+bool compile_server_make_address(String const &socket_path, struct sockaddr_un *addr) {
+	gb_zero_item(addr);
+	addr->sun_family = AF_UNIX;
+	if (socket_path.len >= gb_size_of(addr->sun_path)) {
+		gb_printf_err("Socket path is too long: %.*s\n", LIT(socket_path));
+		return false;
+	}
+	gb_memmove(addr->sun_path, socket_path.text, socket_path.len);
+	return true;
+}
+
+// NOTE: A request is a u32 length, sent along with the caller's stdin, stdout and stderr, followed by
+// the working directory and the arguments as NUL terminated strings. The reply is the i32 exit code
+bool compile_server_serve(int conn, Array<String> *request_args) {
+	u32 length = 0;
+	int fds[3] = {-1, -1, -1};
+
+	struct iovec iov = {};
+	iov.iov_base = &length;
+	iov.iov_len  = gb_size_of(length);
+	union {
+		char buf[CMSG_SPACE(gb_size_of(fds))];
+		struct cmsghdr align;
+	} control = {};
+	struct msghdr msg = {};
+	msg.msg_iov        = &iov;
+	msg.msg_iovlen     = 1;
+	msg.msg_control    = control.buf;
+	msg.msg_controllen = gb_size_of(control.buf);
+	if (recvmsg(conn, &msg, 0) != gb_size_of(length)) {
+		return false;
+	}
+	struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+	if (cmsg == nullptr || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(gb_size_of(fds))) {
+		return false;
+	}
+	gb_memmove(fds, CMSG_DATA(cmsg), gb_size_of(fds));
+	defer ({
+		for (int i = 0; i < 3; i++) {
+			close(fds[i]);
+		}
+	});
+
+	u8 *payload = gb_alloc_array(permanent_allocator(), u8, length+1);
+	if (length == 0 || !compile_server_read_all(conn, payload, length)) {
+		return false;
+	}
+	payload[length] = 0;
+
+	pid_t pid = fork();
+	if (pid == 0) {
+		for (int i = 0; i < 3; i++) {
+			dup2(fds[i], i);
+		}
+		close(conn);
+		signal(SIGPIPE, SIG_DFL);
+
+		auto args = array_make<String>(permanent_allocator(), 0, 16);
+		for (isize start = 0, i = 0; i < length; i++) {
+			if (payload[i] == 0) {
+				array_add(&args, make_string(payload+start, i-start));
+				start = i+1;
+			}
+		}
+		if (args.count < 3 || chdir(cast(char const *)args[0].text) != 0) {
+			gb_printf_err("Invalid compile server request\n");
+			gb_exit(1);
+		}
+
+		compile_server.is_request = true;
+		timings_destroy(&global_timings);
+		timings_init(&global_timings, str_lit("Total Time"), 2048);
+		timings_start_section(&global_timings, str_lit("initialization"));
+
+		*request_args = array_slice(args, 1, args.count);
+		return true;
+	}
+
+	i32 exit_code = 1;
+	int status = 0;
+	if (pid > 0 && waitpid(pid, &status, 0) == pid) {
+		if (WIFEXITED(status)) {
+			exit_code = WEXITSTATUS(status);
+		} else if (WIFSIGNALED(status)) {
+			exit_code = 128 + WTERMSIG(status);
+		}
+	}
+	compile_server_write_all(conn, &exit_code, gb_size_of(exit_code));
+	return false;
+}
+
+// NOTE: Only returns true within the process forked for each request, which then carries on
+// as if it had been started with `request_args`
+bool compile_server_run(Array<String> const &args, Array<String> *request_args) {
+	String socket_path = args[2];
+	struct sockaddr_un addr = {};
+	if (!compile_server_make_address(socket_path, &addr)) {
+		return false;
+	}
+
+	array_init(&compile_server.package_paths, heap_allocator());
+	for (isize i = 3; i < args.count; i++) {
+		String path = args[i];
+		String fullpath = {};
+		isize colon_pos = -1;
+		for (isize j = 0; j < path.len; j++) {
+			if (path[j] == ':') {
+				colon_pos = j;
+				break;
+			}
+		}
+		if (colon_pos > 0) {
+			String base_dir = {};
+			if (!find_library_collection_path(substring(path, 0, colon_pos), &base_dir)) {
+				gb_printf_err("Unknown library collection: %.*s\n", LIT(path));
+				return false;
+			}
+			fullpath = get_fullpath_relative(heap_allocator(), base_dir, substring(path, colon_pos+1, path.len));
+		} else {
+			fullpath = path_to_full_path(heap_allocator(), path);
+		}
+		if (!path_is_directory(fullpath)) {
+			gb_printf_err("Expected a package directory, got %.*s\n", LIT(path));
+			return false;
+		}
+		array_add(&compile_server.package_paths, fullpath);
+	}
+
+	init_build_context(nullptr);
+	compile_server_load();
+
+	int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+	bool in_use = connect(probe, cast(struct sockaddr *)&addr, gb_size_of(addr)) == 0;
+	close(probe);
+	if (in_use) {
+		gb_printf_err("A compile server is already listening on %.*s\n", LIT(socket_path));
+		return false;
+	}
+	// NOTE: Left behind by a previous server which did not exit cleanly
+	unlink(addr.sun_path);
+
+	int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0 ||
+	    bind(listener, cast(struct sockaddr *)&addr, gb_size_of(addr)) != 0 ||
+	    listen(listener, 16) != 0) {
+		gb_printf_err("Failed to listen on %.*s: %s\n", LIT(socket_path), strerror(errno));
+		return false;
+	}
+	signal(SIGPIPE, SIG_IGN);
+	gb_printf_err("Listening on %.*s\n", LIT(socket_path));
+
+	for (;;) {
+		while (waitpid(-1, nullptr, WNOHANG) > 0) {
+			// Reap the finished requests
+		}
+
+		int conn = accept(listener, nullptr, nullptr);
+		if (conn < 0) {
+			continue;
+		}
+
+		if (compile_server_is_stale()) {
+			gb_printf_err("Resident files changed, parsing them again\n");
+			compile_server_load();
+		}
+
+		// NOTE: Each request gets a process which waits for the build and replies with its exit code,
+		// so that requests run concurrently
+		pid_t pid = fork();
+		if (pid == 0) {
+			close(listener);
+			if (compile_server_serve(conn, request_args)) {
+				return true;
+			}
+			_exit(0);
+		}
+		close(conn);
+	}
+}
+
+bool compile_server_request(String const &socket_path, int arg_count, char const **arg_ptr, i32 *exit_code) {
+	struct sockaddr_un addr = {};
+	if (!compile_server_make_address(socket_path, &addr)) {
+		return false;
+	}
+	int conn = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (conn < 0) {
+		return false;
+	}
+	defer (close(conn));
+	if (connect(conn, cast(struct sockaddr *)&addr, gb_size_of(addr)) != 0) {
+		debugf("No compile server is listening on %.*s, building locally\n", LIT(socket_path));
+		return false;
+	}
+
+	char cwd[PATH_MAX] = {};
+	if (getcwd(cwd, gb_size_of(cwd)) == nullptr) {
+		return false;
+	}
+
+	auto payload = array_make<u8>(heap_allocator(), 0, 4096);
+	defer (array_free(&payload));
+	array_add_elems(&payload, cast(u8 *)cwd, gb_strlen(cwd)+1);
+	bool after_run_args = false;
+	for (int i = 0; i < arg_count; i++) {
+		String arg = make_string_c(arg_ptr[i]);
+		if (arg == "--") {
+			after_run_args = true;
+		}
+		if (!after_run_args && (string_starts_with(arg, str_lit("-use-server:")) ||
+		                        string_starts_with(arg, str_lit("-use-server=")))) {
+			continue;
+		}
+		array_add_elems(&payload, arg.text, arg.len+1);
+	}
+
+	u32 length = cast(u32)payload.count;
+	int fds[3] = {0, 1, 2};
+	struct iovec iov = {};
+	iov.iov_base = &length;
+	iov.iov_len  = gb_size_of(length);
+	union {
+		char buf[CMSG_SPACE(gb_size_of(fds))];
+		struct cmsghdr align;
+	} control = {};
+	struct msghdr msg = {};
+	msg.msg_iov        = &iov;
+	msg.msg_iovlen     = 1;
+	msg.msg_control    = control.buf;
+	msg.msg_controllen = gb_size_of(control.buf);
+	struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type  = SCM_RIGHTS;
+	cmsg->cmsg_len   = CMSG_LEN(gb_size_of(fds));
+	gb_memmove(CMSG_DATA(cmsg), fds, gb_size_of(fds));
+
+	if (sendmsg(conn, &msg, 0) != gb_size_of(length) ||
+	    !compile_server_write_all(conn, payload.data, payload.count)) {
+		return false;
+	}
+
+	if (!compile_server_read_all(conn, exit_code, gb_size_of(*exit_code))) {
+		gb_printf_err("The compile server on %.*s closed the connection\n", LIT(socket_path));
+		*exit_code = 1;
+	}
+	return true;
+}
+
+// NOTE: The resident parser, if this build may continue from it
+Parser *compile_server_parser(String const &init_filename) {
+	if (!compile_server.is_request || compile_server.parser == nullptr) {
+		return nullptr;
+	}
+	BuildContext *bc = &build_context;
+	if (bc->metrics.os       != compile_server.os               ||
+	    bc->metrics.arch     != compile_server.arch             ||
+	    bc->insert_semicolon != compile_server.insert_semicolon ||
+	    bc->disallow_do      != compile_server.disallow_do      ||
+	    bc->ignore_lazy      != compile_server.ignore_lazy) {
+		return nullptr;
+	}
+	// NOTE: A build with other collections may resolve the imports of the resident packages differently
+	if (library_collections.count != compile_server.collections.count) {
+		return nullptr;
+	}
+	for_array(i, library_collections) {
+		if (library_collections[i].name != compile_server.collections[i].name ||
+		    library_collections[i].path != compile_server.collections[i].path) {
+			return nullptr;
+		}
+	}
+	// NOTE: Test files and documented packages are treated differently when parsed
+	if (bc->command_kind & (Command_test|Command_doc)) {
+		return nullptr;
+	}
+	String init_fullpath = path_to_full_path(heap_allocator(), init_filename);
+	if (string_set_exists(&compile_server.parser->imported_files, init_fullpath)) {
+		return nullptr;
+	}
+	return compile_server.parser;
+}
+
+// NOTE: Drops the resident packages which the program does not import,
+// so that it is checked exactly as if it had been parsed on its own
+void compile_server_prune_packages(Parser *p) {
+	if (p != compile_server.parser) {
+		return;
+	}
+
+	StringMap<AstPackage *> package_map = {};
+	string_map_init(&package_map, heap_allocator(), p->packages.count);
+	defer (string_map_destroy(&package_map));
+
+	PtrSet<AstPackage *> used = {};
+	ptr_set_init(&used, heap_allocator(), p->packages.count);
+	defer (ptr_set_destroy(&used));
+
+	auto queue = array_make<AstPackage *>(heap_allocator(), 0, p->packages.count);
+	defer (array_free(&queue));
+
+	for_array(i, p->packages) {
+		AstPackage *pkg = p->packages[i];
+		string_map_set(&package_map, pkg->fullpath, pkg);
+		if (pkg->kind == Package_Runtime || !ptr_set_exists(&compile_server.packages, pkg)) {
+			ptr_set_add(&used, pkg);
+			array_add(&queue, pkg);
+		}
+	}
+
+	while (queue.count > 0) {
+		AstPackage *pkg = array_pop(&queue);
+		for_array(i, pkg->files) {
+			AstFile *f = pkg->files[i];
+			for_array(j, f->imports) {
+				Ast *decl = f->imports[j];
+				if (decl->kind != Ast_ImportDecl) {
+					continue;
+				}
+				AstPackage **found = string_map_get(&package_map, decl->ImportDecl.fullpath);
+				if (found != nullptr && !ptr_set_update(&used, *found)) {
+					array_add(&queue, *found);
+				}
+			}
+		}
+	}
+
+	isize count = 0;
+	for_array(i, p->packages) {
+		AstPackage *pkg = p->packages[i];
+		if (ptr_set_exists(&used, pkg)) {
+			p->packages[count++] = pkg;
+		}
+	}
+	p->packages.count = count;
+}
+
+#else
+
+bool compile_server_run(Array<String> const &args, Array<String> *request_args) {
+	gb_printf_err("The compile server is not yet supported on this platform\n");
+	return false;
+}
+
+bool compile_server_request(String const &socket_path, int arg_count, char const **arg_ptr, i32 *exit_code) {
+	return false;
+}
+
+Parser *compile_server_parser(String const &init_filename) {
+	return nullptr;
+}
+
+void compile_server_prune_packages(Parser *p) {
+}
+
+#endif
@@ -6,7 +6,7 @@ void init_string_buffer_memory(void) {
 	// NOTE(bill): This should be enough memory for file systems
 	gb_arena_init_from_allocator(&string_buffer_arena, heap_allocator(), gb_megabytes(1));
 	string_buffer_allocator = gb_arena_allocator(&string_buffer_arena);
-	mutex_init(&string_buffer_mutex);
+	mutex_init(&string_buffer_mutex, "string_buffer_mutex");
 }
 
 
@@ -177,6 +177,7 @@ GB_COMPARE_PROC(string_cmp_proc) {
 
 gb_inline bool str_eq(String const &a, String const &b) {
 	if (a.len != b.len) return false;
+	if (a.text == b.text) return true; // NOTE: Interned identifiers
 	return memcmp(a.text, b.text, a.len) == 0;
 }
 gb_inline bool str_ne(String const &a, String const &b) { return !str_eq(a, b);                }
@@ -1,7 +1,6 @@
 // NOTE(bill): This util stuff is the same for every `Map`
 struct StringMapFindResult {
-	isize hash_index;
-	isize entry_prev;
+	isize slot_index;  // The slot of the entry, or the empty slot where it would be inserted
 	isize entry_index;
 };
 
@@ -35,13 +34,13 @@ bool operator!=(StringHashKey const &a, StringHashKey const &b) { return !string
 template <typename T>
 struct StringMapEntry {
 	StringHashKey key;
-	isize         next;
 	T             value;
 };
 
+// NOTE: Laid out the same way as `Map`, see `MapSlot`
 template <typename T>
 struct StringMap {
-	Slice<isize>              hashes;
+	Slice<MapSlot>            hashes;
 	Array<StringMapEntry<T> > entries;
 };
 
@@ -68,66 +67,64 @@ template <typename T> void string_map_rehash           (StringMap<T> *h, isize n
 
 template <typename T>
 gb_inline void string_map_init(StringMap<T> *h, gbAllocator a, isize capacity) {
+	map_trace(MapTraceTable_StringMap, MapTraceOp_Init, h, cast(u64)capacity);
 	capacity = next_pow2_isize(capacity);
 	slice_init(&h->hashes,  a, capacity);
 	array_init(&h->entries, a, 0, capacity);
-	for (isize i = 0; i < capacity; i++) {
-		h->hashes.data[i] = -1;
-	}
+	map_slots_clear(h->hashes.data, h->hashes.count);
 }
 
 template <typename T>
 gb_inline void string_map_destroy(StringMap<T> *h) {
+	map_trace(MapTraceTable_StringMap, MapTraceOp_Destroy, h, 0);
 	slice_free(&h->hashes, h->entries.allocator);
 	array_free(&h->entries);
 }
 
+gb_inline u32 string_map__hash_tag(StringHashKey const &key) {
+	return map_hash_tag(key.hash);
+}
+
 template <typename T>
-gb_internal isize string_map__add_entry(StringMap<T> *h, StringHashKey const &key) {
+gb_internal isize string_map__add_entry(StringMap<T> *h, StringMapFindResult const &fr, StringHashKey const &key, u32 tag) {
 	StringMapEntry<T> e = {};
 	e.key = key;
-	e.next = -1;
 	array_add(&h->entries, e);
-	return h->entries.count-1;
+	isize index = h->entries.count-1;
+	h->hashes.data[fr.slot_index].index = cast(MapIndex)index;
+	h->hashes.data[fr.slot_index].tag   = tag;
+	return index;
 }
 
 template <typename T>
-gb_internal StringMapFindResult string_map__find(StringMap<T> *h, StringHashKey const &key) {
-	StringMapFindResult fr = {-1, -1, -1};
+gb_internal StringMapFindResult string_map__find(StringMap<T> *h, StringHashKey const &key, u32 tag) {
+	StringMapFindResult fr = {-1, -1};
 	if (h->hashes.count != 0) {
-		fr.hash_index = key.hash & (h->hashes.count-1);
-		fr.entry_index = h->hashes.data[fr.hash_index];
-		while (fr.entry_index >= 0) {
-			if (string_hash_key_equal(h->entries.data[fr.entry_index].key, key)) {
-				return fr;
+		isize mask = h->hashes.count-1;
+		for (isize i = tag & mask; ; i = (i+1) & mask) {
+			MapSlot slot = h->hashes.data[i];
+			if (slot.index == MAP_SENTINEL) {
+				fr.slot_index = i;
+				break;
+			}
+			if (slot.tag == tag && string_hash_key_equal(h->entries.data[slot.index].key, key)) {
+				fr.slot_index = i;
+				fr.entry_index = slot.index;
+				break;
 			}
-			fr.entry_prev = fr.entry_index;
-			fr.entry_index = h->entries.data[fr.entry_index].next;
 		}
 	}
 	return fr;
 }
 
 template <typename T>
-gb_internal StringMapFindResult string_map__find_from_entry(StringMap<T> *h, StringMapEntry<T> *e) {
-	StringMapFindResult fr = {-1, -1, -1};
-	if (h->hashes.count != 0) {
-		fr.hash_index  = e->key.hash & (h->hashes.count-1);
-		fr.entry_index = h->hashes.data[fr.hash_index];
-		while (fr.entry_index >= 0) {
-			if (&h->entries.data[fr.entry_index] == e) {
-				return fr;
-			}
-			fr.entry_prev = fr.entry_index;
-			fr.entry_index = h->entries.data[fr.entry_index].next;
-		}
-	}
-	return fr;
+gb_internal StringMapFindResult string_map__find(StringMap<T> *h, StringHashKey const &key) {
+	return string_map__find(h, key, string_map__hash_tag(key));
 }
 
 template <typename T>
 gb_internal b32 string_map__full(StringMap<T> *h) {
-	return 0.75f * h->hashes.count <= h->entries.count;
+	return map_slots_full(h->hashes.count, h->entries.count);
 }
 
 template <typename T>
@@ -138,41 +135,16 @@ gb_inline void string_map_grow(StringMap<T> *h) {
 
 template <typename T>
 void string_map_rehash(StringMap<T> *h, isize new_count) {
-	isize i, j;
-	StringMap<T> nh = {};
 	new_count = next_pow2_isize(new_count);
-	nh.hashes = h->hashes;
-	nh.entries.allocator = h->entries.allocator;
-	slice_resize(&nh.hashes, h->entries.allocator, new_count);
-	for (i = 0; i < new_count; i++) {
-		nh.hashes.data[i] = -1;
+	while (map_slots_full(new_count, h->entries.count)) {
+		new_count <<= 1;
 	}
-	array_reserve(&nh.entries, ARRAY_GROW_FORMULA(h->entries.count));
-	for (i = 0; i < h->entries.count; i++) {
-		StringMapEntry<T> *e = &h->entries.data[i];
-		StringMapFindResult fr;
-		if (nh.hashes.count == 0) {
-			string_map_grow(&nh);
-		}
-		fr = string_map__find(&nh, e->key);
-		j = string_map__add_entry(&nh, e->key);
-		if (fr.entry_prev < 0) {
-			nh.hashes.data[fr.hash_index] = j;
-		} else {
-			nh.entries.data[fr.entry_prev].next = j;
-		}
-		nh.entries.data[j].next = fr.entry_index;
-		nh.entries.data[j].value = e->value;
-		if (string_map__full(&nh)) {
-			string_map_grow(&nh);
-		}
-	}
-	array_free(&h->entries);
-	*h = nh;
+	map_slots_rehash(&h->hashes, h->entries.allocator, new_count);
 }
 
 template <typename T>
 T *string_map_get(StringMap<T> *h, StringHashKey const &key) {
+	map_trace(MapTraceTable_StringMap, MapTraceOp_Get, h, key.hash, key.string);
 	isize index = string_map__find(h, key).entry_index;
 	if (index >= 0) {
 		return &h->entries.data[index].value;
@@ -192,6 +164,7 @@ gb_inline T *string_map_get(StringMap<T> *h, char const *key) {
 
 template <typename T>
 T &string_map_must_get(StringMap<T> *h, StringHashKey const &key) {
+	map_trace(MapTraceTable_StringMap, MapTraceOp_Get, h, key.hash, key.string);
 	isize index = string_map__find(h, key).entry_index;
 	GB_ASSERT(index >= 0);
 	return h->entries.data[index].value;
@@ -209,21 +182,18 @@ gb_inline T &string_map_must_get(StringMap<T> *h, char const *key) {
 
 template <typename T>
 void string_map_set(StringMap<T> *h, StringHashKey const &key, T const &value) {
+	map_trace(MapTraceTable_StringMap, MapTraceOp_Set, h, key.hash, key.string);
 	isize index;
 	StringMapFindResult fr;
 	if (h->hashes.count == 0) {
 		string_map_grow(h);
 	}
-	fr = string_map__find(h, key);
+	u32 tag = string_map__hash_tag(key);
+	fr = string_map__find(h, key, tag);
 	if (fr.entry_index >= 0) {
 		index = fr.entry_index;
 	} else {
-		index = string_map__add_entry(h, key);
-		if (fr.entry_prev >= 0) {
-			h->entries.data[fr.entry_prev].next = index;
-		} else {
-			h->hashes.data[fr.hash_index] = index;
-		}
+		index = string_map__add_entry(h, fr, key, tag);
 	}
 	h->entries.data[index].value = value;
 
@@ -245,27 +215,20 @@ gb_inline void string_map_set(StringMap<T> *h, char const *key, T const &value)
 
 template <typename T>
 void string_map__erase(StringMap<T> *h, StringMapFindResult const &fr) {
-	StringMapFindResult last;
-	if (fr.entry_prev < 0) {
-		h->hashes.data[fr.hash_index] = h->entries.data[fr.entry_index].next;
-	} else {
-		h->entries.data[fr.entry_prev].next = h->entries.data[fr.entry_index].next;
-	}
-	if (fr.entry_index == h->entries.count-1) {
-		array_pop(&h->entries);
-		return;
-	}
-	h->entries.data[fr.entry_index] = h->entries.data[h->entries.count-1];
-	last = string_map__find(h, h->entries.data[fr.entry_index].key);
-	if (last.entry_prev >= 0) {
-		h->entries.data[last.entry_prev].next = fr.entry_index;
-	} else {
-		h->hashes.data[last.hash_index] = fr.entry_index;
+	map_slots_erase(h->hashes.data, h->hashes.count, fr.slot_index);
+
+	isize last = h->entries.count-1;
+	if (fr.entry_index != last) {
+		h->entries.data[fr.entry_index] = h->entries.data[last];
+		u32 tag = string_map__hash_tag(h->entries.data[fr.entry_index].key);
+		map_slots_reindex(h->hashes.data, h->hashes.count, tag, cast(MapIndex)last, cast(MapIndex)fr.entry_index);
 	}
+	array_pop(&h->entries);
 }
 
 template <typename T>
 void string_map_remove(StringMap<T> *h, StringHashKey const &key) {
+	map_trace(MapTraceTable_StringMap, MapTraceOp_Remove, h, key.hash, key.string);
 	StringMapFindResult fr = string_map__find(h, key);
 	if (fr.entry_index >= 0) {
 		string_map__erase(h, fr);
@@ -274,9 +237,8 @@ void string_map_remove(StringMap<T> *h, StringHashKey const &key) {
 
 template <typename T>
 gb_inline void string_map_clear(StringMap<T> *h) {
+	map_trace(MapTraceTable_StringMap, MapTraceOp_Clear, h, 0);
 	array_clear(&h->entries);
-	for (isize i = 0; i < h->hashes.count; i++) {
-		h->hashes.data[i] = -1;
-	}
+	map_slots_clear(h->hashes.data, h->hashes.count);
 }
 
@@ -10,15 +10,44 @@ struct WorkerTask {
 };
 
 
+// NOTE: The slots are atomic as a thief may read a slot whilst the owner writes to it,
+// but a thief only uses what it read if it wins the race on `top`
+struct WorkerTaskSlot {
+	std::atomic<WorkerTaskProc *> do_work;
+	std::atomic<void *>           data;
+};
+
+struct WorkerTaskRing {
+	isize           mask; // capacity-1, because capacity must be a power of 2
+	WorkerTaskSlot *slots;
+	WorkerTaskRing *prev; // Retired rings are kept until the deque is destroyed, as a thief may still be reading one
+};
+
+// Work-stealing deque (Chase-Lev)
+// Only the owning thread pushes and pops at the bottom, any thread may steal from the top
+struct WorkerTaskDeque {
+	std::atomic<isize> top;
+
+	char pad0[MPMC_CACHE_LINE_SIZE - sizeof(std::atomic<isize>)];
+	std::atomic<isize>            bottom;
+	std::atomic<WorkerTaskRing *> ring;
+
+	char pad1[MPMC_CACHE_LINE_SIZE - sizeof(std::atomic<isize>) - sizeof(std::atomic<WorkerTaskRing *>)];
+};
+
+
 struct ThreadPool {
-	BlockingMutex     mutex;
-	Semaphore         sem_available;
-	std::atomic<i32>  processing_work_count;
-	std::atomic<bool> is_running;
+	Semaphore          sem_available;
+	std::atomic<isize> tasks_left;
+	std::atomic<bool>  is_running;
+
+	Semaphore         sem_waiter;    // Wakes the thread in thread_pool_wait_to_process
+	std::atomic<bool> waiter_asleep;
 
 	gbAllocator allocator;
 
-	MPMCQueue<WorkerTask> tasks;
+	MPMCQueue<WorkerTask> tasks; // Tasks added from outside of the pool's threads
+	WorkerTaskDeque *     deques; // One per worker thread, and the last one for the thread waiting on the pool
 
 	Thread *threads;
 	isize thread_count;
@@ -27,6 +56,10 @@ struct ThreadPool {
 	i32 worker_prefix_len;
 };
 
+// NOTE: Which pool (and which of its deques) the current thread is working for, if any
+gb_thread_local ThreadPool *thread_pool_current       = nullptr;
+gb_thread_local isize       thread_pool_current_index = -1;
+
 void thread_pool_init(ThreadPool *pool, gbAllocator const &a, isize thread_count, char const *worker_prefix = nullptr);
 void thread_pool_destroy(ThreadPool *pool);
 void thread_pool_start(ThreadPool *pool);
@@ -34,14 +67,123 @@ void thread_pool_join(ThreadPool *pool);
 void thread_pool_add_task(ThreadPool *pool, WorkerTaskProc *proc, void *data);
 THREAD_PROC(worker_thread_internal);
 
+
+WorkerTaskRing *worker_task_ring_make(gbAllocator a, isize capacity) {
+	GB_ASSERT(gb_is_power_of_two(capacity));
+	WorkerTaskRing *ring = gb_alloc_item(a, WorkerTaskRing);
+	ring->mask  = capacity-1;
+	ring->slots = gb_alloc_array(a, WorkerTaskSlot, capacity);
+	ring->prev  = nullptr;
+	return ring;
+}
+
+gb_inline void worker_task_ring_put(WorkerTaskRing *ring, isize index, WorkerTask const &task) {
+	WorkerTaskSlot *slot = &ring->slots[index & ring->mask];
+	slot->do_work.store(task.do_work, std::memory_order_relaxed);
+	slot->data.store(task.data, std::memory_order_relaxed);
+}
+
+gb_inline WorkerTask worker_task_ring_get(WorkerTaskRing *ring, isize index) {
+	WorkerTaskSlot *slot = &ring->slots[index & ring->mask];
+	WorkerTask task = {};
+	task.do_work = slot->do_work.load(std::memory_order_relaxed);
+	task.data    = slot->data.load(std::memory_order_relaxed);
+	return task;
+}
+
+void worker_task_deque_init(WorkerTaskDeque *d, gbAllocator a, isize capacity) {
+	d->top.store(0, std::memory_order_relaxed);
+	d->bottom.store(0, std::memory_order_relaxed);
+	d->ring.store(worker_task_ring_make(a, next_pow2_isize(gb_max(capacity, 8))), std::memory_order_relaxed);
+}
+
+void worker_task_deque_destroy(WorkerTaskDeque *d, gbAllocator a) {
+	WorkerTaskRing *ring = d->ring.load(std::memory_order_relaxed);
+	while (ring != nullptr) {
+		WorkerTaskRing *prev = ring->prev;
+		gb_free(a, ring->slots);
+		gb_free(a, ring);
+		ring = prev;
+	}
+	d->ring.store(nullptr, std::memory_order_relaxed);
+}
+
+// NOTE: Must only be called by the owning thread
+void worker_task_deque_push(WorkerTaskDeque *d, gbAllocator a, WorkerTask const &task) {
+	isize b = d->bottom.load(std::memory_order_relaxed);
+	isize t = d->top.load(std::memory_order_acquire);
+	WorkerTaskRing *ring = d->ring.load(std::memory_order_relaxed);
+
+	if (b - t > ring->mask) {
+		WorkerTaskRing *new_ring = worker_task_ring_make(a, 2*(ring->mask+1));
+		for (isize i = t; i < b; i++) {
+			worker_task_ring_put(new_ring, i, worker_task_ring_get(ring, i));
+		}
+		new_ring->prev = ring;
+		d->ring.store(new_ring, std::memory_order_release);
+		ring = new_ring;
+	}
+
+	worker_task_ring_put(ring, b, task);
+	d->bottom.store(b+1, std::memory_order_release);
+}
+
+// NOTE: Must only be called by the owning thread
+bool worker_task_deque_pop(WorkerTaskDeque *d, WorkerTask *task) {
+	isize b = d->bottom.load(std::memory_order_relaxed) - 1;
+	WorkerTaskRing *ring = d->ring.load(std::memory_order_relaxed);
+	d->bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	isize t = d->top.load(std::memory_order_relaxed);
+
+	if (t > b) {
+		// Empty
+		d->bottom.store(b+1, std::memory_order_relaxed);
+		return false;
+	}
+
+	*task = worker_task_ring_get(ring, b);
+	if (t == b) {
+		// Last task, race against the thieves for it
+		bool got_task = d->top.compare_exchange_strong(t, t+1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		d->bottom.store(b+1, std::memory_order_relaxed);
+		return got_task;
+	}
+	return true;
+}
+
+bool worker_task_deque_steal(WorkerTaskDeque *d, WorkerTask *task) {
+	isize t = d->top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	isize b = d->bottom.load(std::memory_order_acquire);
+	if (t >= b) {
+		return false;
+	}
+
+	WorkerTaskRing *ring = d->ring.load(std::memory_order_acquire);
+	WorkerTask stolen = worker_task_ring_get(ring, t);
+	if (!d->top.compare_exchange_strong(t, t+1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return false;
+	}
+	*task = stolen;
+	return true;
+}
+
+
 void thread_pool_init(ThreadPool *pool, gbAllocator const &a, isize thread_count, char const *worker_prefix) {
 	pool->allocator = a;
 	mpmc_init(&pool->tasks, a, 1024);
 	pool->thread_count = gb_max(thread_count, 0);
 	pool->threads = gb_alloc_array(a, Thread, pool->thread_count);
-	mutex_init(&pool->mutex);
-	semaphore_init(&pool->sem_available);
+	pool->deques = gb_alloc_array(a, WorkerTaskDeque, pool->thread_count+1);
+	for (isize i = 0; i < pool->thread_count+1; i++) {
+		worker_task_deque_init(&pool->deques[i], a, 256);
+	}
+	semaphore_init(&pool->sem_available, "ThreadPool.sem_available");
+	semaphore_init(&pool->sem_waiter, "ThreadPool.sem_waiter");
+	pool->tasks_left = 0;
 	pool->is_running = true;
+	pool->waiter_asleep = false;
 
 	pool->worker_prefix_len = 0;
 	if (worker_prefix) {
@@ -67,6 +209,8 @@ void thread_pool_init(ThreadPool *pool, gbAllocator const &a, isize thread_count
 }
 
 void thread_pool_start(ThreadPool *pool) {
+	// NOTE: thread_pool_wait_to_process joins the workers, so allow the pool to be restarted for another batch of tasks
+	pool->is_running = true;
 	for (isize i = 0; i < pool->thread_count; i++) {
 		Thread *t = &pool->threads[i];
 		thread_start(t, worker_thread_internal, pool);
@@ -91,78 +235,126 @@ void thread_pool_destroy(ThreadPool *pool) {
 	thread_pool_join(pool);
 
 	semaphore_destroy(&pool->sem_available);
-	mutex_destroy(&pool->mutex);
+	semaphore_destroy(&pool->sem_waiter);
 	gb_free(pool->allocator, pool->threads);
+	for (isize i = 0; i < pool->thread_count+1; i++) {
+		worker_task_deque_destroy(&pool->deques[i], pool->allocator);
+	}
+	gb_free(pool->allocator, pool->deques);
 	pool->thread_count = 0;
 	mpmc_destroy(&pool->tasks);
 }
 
 
-void thread_pool_add_task(ThreadPool *pool, WorkerTaskProc *proc, void *data) {
-	mutex_lock(&pool->mutex);
+// NOTE: The fence pairs with the one in thread_pool_wait_to_process, so either the waiting thread
+// sees the new task (or the last one finishing) or this sees that it is going to sleep
+gb_inline void thread_pool_wake_waiter(ThreadPool *pool) {
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (pool->waiter_asleep.load(std::memory_order_relaxed) && pool->waiter_asleep.exchange(false)) {
+		semaphore_post(&pool->sem_waiter, 1);
+	}
+}
 
+void thread_pool_add_task(ThreadPool *pool, WorkerTaskProc *proc, void *data) {
 	WorkerTask task = {};
 	task.do_work = proc;
 	task.data = data;
 
-	mpmc_enqueue(&pool->tasks, task);
+	pool->tasks_left.fetch_add(1);
+	if (thread_pool_current == pool) {
+		// NOTE: Work found by a running task stays with the thread which found it, other threads may steal it
+		worker_task_deque_push(&pool->deques[thread_pool_current_index], pool->allocator, task);
+	} else {
+		mpmc_enqueue(&pool->tasks, task);
+	}
 	semaphore_post(&pool->sem_available, 1);
-	mutex_unlock(&pool->mutex);
+	thread_pool_wake_waiter(pool);
 }
 
-bool thread_pool_try_and_pop_task(ThreadPool *pool, WorkerTask *task) {
-	bool got_task = false;
+bool thread_pool_try_and_pop_task(ThreadPool *pool, isize index, WorkerTask *task) {
+	if (worker_task_deque_pop(&pool->deques[index], task)) {
+		return true;
+	}
 	if (mpmc_dequeue(&pool->tasks, task)) {
-		pool->processing_work_count.fetch_add(1);
-		got_task = true;
+		return true;
+	}
+
+	isize deque_count = pool->thread_count+1;
+	for (isize i = 1; i < deque_count; i++) {
+		isize victim = (index + i) % deque_count;
+		if (worker_task_deque_steal(&pool->deques[victim], task)) {
+			return true;
+		}
 	}
-	return got_task;
+	return false;
 }
 void thread_pool_do_work(ThreadPool *pool, WorkerTask *task) {
 	task->result = task->do_work(task->data);
-	pool->processing_work_count.fetch_sub(1);
+	if (pool->tasks_left.fetch_sub(1, std::memory_order_release) == 1) {
+		thread_pool_wake_waiter(pool);
+	}
 }
 
 void thread_pool_wait_to_process(ThreadPool *pool) {
-	if (pool->thread_count == 0) {
+	// NOTE: The waiting thread helps with the work too, using the last deque as its own
+	ThreadPool *prev_pool  = thread_pool_current;
+	isize       prev_index = thread_pool_current_index;
+	thread_pool_current       = pool;
+	thread_pool_current_index = pool->thread_count;
+
+	for (;;) {
 		WorkerTask task = {};
-		while (thread_pool_try_and_pop_task(pool, &task)) {
+		if (thread_pool_try_and_pop_task(pool, pool->thread_count, &task)) {
 			thread_pool_do_work(pool, &task);
+			continue;
 		}
-		return;
-	}
-	while (pool->tasks.count.load(std::memory_order_relaxed) > 0 || pool->processing_work_count.load() != 0) {
-		WorkerTask task = {};
-		if (thread_pool_try_and_pop_task(pool, &task)) {
-			thread_pool_do_work(pool, &task);
+		if (pool->tasks_left.load(std::memory_order_acquire) == 0) {
+			break;
 		}
 
-		// Safety-kick
-		while (pool->tasks.count.load(std::memory_order_relaxed) > 0 && pool->processing_work_count.load() == 0) {
-			mutex_lock(&pool->mutex);
-			semaphore_post(&pool->sem_available, cast(i32)pool->tasks.count.load(std::memory_order_relaxed));
-			mutex_unlock(&pool->mutex);
+		// NOTE: Everything left is running on a worker, so sleep until a task is added or the last one
+		// finishes. The sleep is announced before looking once more, see thread_pool_wake_waiter
+		pool->waiter_asleep.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		bool found = thread_pool_try_and_pop_task(pool, pool->thread_count, &task);
+		if (found || pool->tasks_left.load(std::memory_order_acquire) == 0) {
+			if (!pool->waiter_asleep.exchange(false)) {
+				// NOTE: A waker took the flag first, so its post must be taken too
+				semaphore_wait(&pool->sem_waiter);
+			}
+			if (found) {
+				thread_pool_do_work(pool, &task);
+			}
+			continue;
 		}
-
-		yield();
+		semaphore_wait(&pool->sem_waiter);
 	}
 
+	thread_pool_current       = prev_pool;
+	thread_pool_current_index = prev_index;
+
 	thread_pool_join(pool);
 }
 
 
 THREAD_PROC(worker_thread_internal) {
 	ThreadPool *pool = cast(ThreadPool *)thread->user_data;
-	while (pool->is_running.load()) {
-		semaphore_wait(&pool->sem_available);
+	isize index = thread->user_index;
+	thread_pool_current       = pool;
+	thread_pool_current_index = index;
 
+	while (pool->is_running.load()) {
 		WorkerTask task = {};
-		if (thread_pool_try_and_pop_task(pool, &task)) {
+		if (thread_pool_try_and_pop_task(pool, index, &task)) {
 			thread_pool_do_work(pool, &task);
+			continue;
 		}
+		semaphore_wait(&pool->sem_available);
 	}
 	// Cascade
 	semaphore_release(&pool->sem_available);
 
+	thread_pool_current       = nullptr;
+	thread_pool_current_index = -1;
 	return 0;
 }
@@ -6,6 +6,8 @@ struct Thread;
 #define THREAD_PROC(name) isize name(struct Thread *thread)
 typedef THREAD_PROC(ThreadProc);
 
+void temporary_allocator_thread_exit(void);
+
 struct Thread {
 #if defined(GB_SYSTEM_WINDOWS)
 	void *        win32_handle;
@@ -24,23 +26,46 @@ struct Thread {
 };
 
 
+// NOTE: Lock statistics are shared by every mutex (or semaphore) initialized with the same name,
+// and are only recorded while `mutex_stats_enabled` is set (-show-timings)
+struct MutexStats {
+	char const *     name;
+	std::atomic<u64> acquired;
+	std::atomic<u64> contended;
+	std::atomic<u64> wait_time; // in time stamp ticks, only measured for contended acquisitions
+	MutexStats *     next;
+};
+
+gb_global std::atomic<MutexStats *> mutex_stats_list;
+gb_global std::atomic<MutexStats *> semaphore_stats_list; // Kept apart, as most semaphore waits are idle threads
+gb_global bool mutex_stats_enabled = false;
+
+MutexStats *mutex_stats_get    (char const *name);
+MutexStats *semaphore_stats_get(char const *name);
+
 void mutex_init    (BlockingMutex *m);
+void mutex_init    (BlockingMutex *m, char const *name);
+void mutex_init    (BlockingMutex *m, MutexStats *stats);
 void mutex_destroy (BlockingMutex *m);
 void mutex_lock    (BlockingMutex *m);
 bool mutex_try_lock(BlockingMutex *m);
 void mutex_unlock  (BlockingMutex *m);
 void mutex_init    (RecursiveMutex *m);
+void mutex_init    (RecursiveMutex *m, char const *name);
 void mutex_destroy (RecursiveMutex *m);
 void mutex_lock    (RecursiveMutex *m);
 bool mutex_try_lock(RecursiveMutex *m);
 void mutex_unlock  (RecursiveMutex *m);
 
 void semaphore_init   (Semaphore *s);
+void semaphore_init   (Semaphore *s, char const *name);
 void semaphore_destroy(Semaphore *s);
 void semaphore_post   (Semaphore *s, i32 count);
 void semaphore_wait   (Semaphore *s);
 void semaphore_release(Semaphore *s) { semaphore_post(s, 1); }
 
+u64 time_stamp_time_now(void);
+
 u32  thread_current_id(void);
 
 void thread_init            (Thread *t);
@@ -58,12 +83,14 @@ void yield_process(void);
 #if defined(GB_SYSTEM_WINDOWS)
 	struct BlockingMutex {
 		SRWLOCK srwlock;
+		MutexStats *stats;
 	};
 	void mutex_init(BlockingMutex *m) {
+		m->stats = nullptr;
 	}
 	void mutex_destroy(BlockingMutex *m) {
 	}
-	void mutex_lock(BlockingMutex *m) {
+	void mutex_lock_internal(BlockingMutex *m) {
 		AcquireSRWLockExclusive(&m->srwlock);
 	}
 	bool mutex_try_lock(BlockingMutex *m) {
@@ -75,14 +102,16 @@ void yield_process(void);
 
 	struct RecursiveMutex {
 		CRITICAL_SECTION win32_critical_section;
+		MutexStats *stats;
 	};
 	void mutex_init(RecursiveMutex *m) {
 		InitializeCriticalSection(&m->win32_critical_section);
+		m->stats = nullptr;
 	}
 	void mutex_destroy(RecursiveMutex *m) {
 		DeleteCriticalSection(&m->win32_critical_section);
 	}
-	void mutex_lock(RecursiveMutex *m) {
+	void mutex_lock_internal(RecursiveMutex *m) {
 		EnterCriticalSection(&m->win32_critical_section);
 	}
 	bool mutex_try_lock(RecursiveMutex *m) {
@@ -94,10 +123,12 @@ void yield_process(void);
 
 	struct Semaphore {
 		void *win32_handle;
+		MutexStats *stats;
 	};
 
 	void semaphore_init(Semaphore *s) {
 		s->win32_handle = CreateSemaphoreA(NULL, 0, I32_MAX, NULL);
+		s->stats = nullptr;
 	}
 	void semaphore_destroy(Semaphore *s) {
 		CloseHandle(s->win32_handle);
@@ -105,21 +136,26 @@ void yield_process(void);
 	void semaphore_post(Semaphore *s, i32 count) {
 		ReleaseSemaphore(s->win32_handle, count, NULL);
 	}
-	void semaphore_wait(Semaphore *s) {
+	void semaphore_wait_internal(Semaphore *s) {
 		WaitForSingleObjectEx(s->win32_handle, INFINITE, FALSE);
 	}
+	bool semaphore_try_wait_internal(Semaphore *s) {
+		return WaitForSingleObjectEx(s->win32_handle, 0, FALSE) == WAIT_OBJECT_0;
+	}
 
 #else
 	struct BlockingMutex {
 		pthread_mutex_t pthread_mutex;
+		MutexStats *stats;
 	};
 	void mutex_init(BlockingMutex *m) {
 		pthread_mutex_init(&m->pthread_mutex, nullptr);
+		m->stats = nullptr;
 	}
 	void mutex_destroy(BlockingMutex *m) {
 		pthread_mutex_destroy(&m->pthread_mutex);
 	}
-	void mutex_lock(BlockingMutex *m) {
+	void mutex_lock_internal(BlockingMutex *m) {
 		pthread_mutex_lock(&m->pthread_mutex);
 	}
 	bool mutex_try_lock(BlockingMutex *m) {
@@ -132,16 +168,18 @@ void yield_process(void);
 	struct RecursiveMutex {
 		pthread_mutex_t pthread_mutex;
 		pthread_mutexattr_t pthread_mutexattr;
+		MutexStats *stats;
 	};
 	void mutex_init(RecursiveMutex *m) {
 		pthread_mutexattr_init(&m->pthread_mutexattr);
 		pthread_mutexattr_settype(&m->pthread_mutexattr, PTHREAD_MUTEX_RECURSIVE);
 		pthread_mutex_init(&m->pthread_mutex, &m->pthread_mutexattr);
+		m->stats = nullptr;
 	}
 	void mutex_destroy(RecursiveMutex *m) {
 		pthread_mutex_destroy(&m->pthread_mutex);
 	}
-	void mutex_lock(RecursiveMutex *m) {
+	void mutex_lock_internal(RecursiveMutex *m) {
 		pthread_mutex_lock(&m->pthread_mutex);
 	}
 	bool mutex_try_lock(RecursiveMutex *m) {
@@ -154,27 +192,122 @@ void yield_process(void);
 	#if defined(GB_SYSTEM_OSX)
 		struct Semaphore {
 			semaphore_t osx_handle;
+			MutexStats *stats;
 		};
 
-		void semaphore_init   (Semaphore *s)            { semaphore_create(mach_task_self(), &s->osx_handle, SYNC_POLICY_FIFO, 0); }
+		void semaphore_init   (Semaphore *s)            { semaphore_create(mach_task_self(), &s->osx_handle, SYNC_POLICY_FIFO, 0); s->stats = nullptr; }
 		void semaphore_destroy(Semaphore *s)            { semaphore_destroy(mach_task_self(), s->osx_handle); }
 		void semaphore_post   (Semaphore *s, i32 count) { while (count --> 0) semaphore_signal(s->osx_handle); }
-		void semaphore_wait   (Semaphore *s)            { semaphore_wait(s->osx_handle); }
+		void semaphore_wait_internal    (Semaphore *s)  { semaphore_wait(s->osx_handle); }
+		bool semaphore_try_wait_internal(Semaphore *s)  { mach_timespec_t t = {}; return semaphore_timedwait(s->osx_handle, t) == KERN_SUCCESS; }
 	#elif defined(GB_SYSTEM_UNIX)
 		struct Semaphore {
 			sem_t unix_handle;
+			MutexStats *stats;
 		};
 
-		void semaphore_init   (Semaphore *s)            { sem_init(&s->unix_handle, 0, 0); }
+		void semaphore_init   (Semaphore *s)            { sem_init(&s->unix_handle, 0, 0); s->stats = nullptr; }
 		void semaphore_destroy(Semaphore *s)            { sem_destroy(&s->unix_handle); }
 		void semaphore_post   (Semaphore *s, i32 count) { while (count --> 0) sem_post(&s->unix_handle); }
-		void semaphore_wait   (Semaphore *s)            { int i; do { i = sem_wait(&s->unix_handle); } while (i == -1 && errno == EINTR); }
+		void semaphore_wait_internal    (Semaphore *s)  { int i; do { i = sem_wait(&s->unix_handle); } while (i == -1 && errno == EINTR); }
+		bool semaphore_try_wait_internal(Semaphore *s)  { return sem_trywait(&s->unix_handle) == 0; }
 	#else
 	#error
 	#endif
 #endif
 
 
+MutexStats *lock_stats_get(std::atomic<MutexStats *> *list, char const *name) {
+	MutexStats *head = list->load(std::memory_order_acquire);
+	for (MutexStats *s = head; s != nullptr; s = s->next) {
+		if (s->name == name || gb_strcmp(s->name, name) == 0) {
+			return s;
+		}
+	}
+
+	MutexStats *stats = gb_alloc_item(heap_allocator(), MutexStats);
+	gb_zero_item(stats);
+	stats->name = name;
+	for (;;) {
+		stats->next = head;
+		if (list->compare_exchange_weak(head, stats, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			return stats;
+		}
+		// NOTE: Another thread may have registered the same name in the meantime
+		for (MutexStats *s = head; s != stats->next; s = s->next) {
+			if (gb_strcmp(s->name, name) == 0) {
+				gb_free(heap_allocator(), stats);
+				return s;
+			}
+		}
+	}
+}
+
+MutexStats *mutex_stats_get(char const *name) {
+	return lock_stats_get(&mutex_stats_list, name);
+}
+MutexStats *semaphore_stats_get(char const *name) {
+	return lock_stats_get(&semaphore_stats_list, name);
+}
+
+template <typename M>
+void mutex_lock_with_stats(M *m, MutexStats *stats) {
+	if (!mutex_try_lock(m)) {
+		u64 start = time_stamp_time_now();
+		mutex_lock_internal(m);
+		stats->contended.fetch_add(1, std::memory_order_relaxed);
+		stats->wait_time.fetch_add(time_stamp_time_now() - start, std::memory_order_relaxed);
+	}
+	stats->acquired.fetch_add(1, std::memory_order_relaxed);
+}
+
+void mutex_init(BlockingMutex *m, MutexStats *stats) {
+	mutex_init(m);
+	m->stats = stats;
+}
+void mutex_init(BlockingMutex *m, char const *name) {
+	mutex_init(m, mutex_stats_get(name));
+}
+void mutex_lock(BlockingMutex *m) {
+	if (mutex_stats_enabled && m->stats != nullptr) {
+		mutex_lock_with_stats(m, m->stats);
+	} else {
+		mutex_lock_internal(m);
+	}
+}
+
+void mutex_init(RecursiveMutex *m, char const *name) {
+	mutex_init(m);
+	m->stats = mutex_stats_get(name);
+}
+void mutex_lock(RecursiveMutex *m) {
+	if (mutex_stats_enabled && m->stats != nullptr) {
+		mutex_lock_with_stats(m, m->stats);
+	} else {
+		mutex_lock_internal(m);
+	}
+}
+
+void semaphore_init(Semaphore *s, char const *name) {
+	semaphore_init(s);
+	s->stats = semaphore_stats_get(name);
+}
+void semaphore_wait(Semaphore *s) {
+	MutexStats *stats = s->stats;
+	if (!mutex_stats_enabled || stats == nullptr) {
+		semaphore_wait_internal(s);
+		return;
+	}
+	if (!semaphore_try_wait_internal(s)) {
+		u64 start = time_stamp_time_now();
+		semaphore_wait_internal(s);
+		stats->contended.fetch_add(1, std::memory_order_relaxed);
+		stats->wait_time.fetch_add(time_stamp_time_now() - start, std::memory_order_relaxed);
+	}
+	stats->acquired.fetch_add(1, std::memory_order_relaxed);
+}
+
+
 
 
 u32 thread_current_id(void) {
@@ -248,6 +381,7 @@ void thread_destroy(Thread *t) {
 void gb__thread_run(Thread *t) {
 	semaphore_release(t->semaphore);
 	t->return_value = t->proc(t);
+	temporary_allocator_thread_exit();
 }
 
 #if defined(GB_SYSTEM_WINDOWS)
@@ -203,3 +203,150 @@ void timings_print_all(Timings *t, TimingUnit unit = TimingUnit_Millisecond) {
 		          100.0*section_time/total_time);
 	}
 }
+
+
+// NOTE: Spans for -export-timings. Every thread records its own nested spans without any locking,
+// and they are written out together as Chrome trace JSON (chrome://tracing, ui.perfetto.dev),
+// where the nesting is recovered from the spans on the same thread containing one another
+struct TraceSpan {
+	u64    start;
+	u64    finish;
+	String name;
+	String detail;
+};
+
+struct TraceThread {
+	Array<TraceSpan> spans;
+	u32              id; // NOTE: Not the OS thread id, as those get reused by the checker's short lived threads
+	TraceThread *    next;
+};
+
+gb_global bool trace_spans_enabled = false;
+gb_global std::atomic<TraceThread *> trace_thread_list;
+gb_global std::atomic<u32> trace_thread_count;
+gb_thread_local TraceThread *trace_current_thread = nullptr;
+
+TraceThread *trace_thread_get(void) {
+	TraceThread *t = trace_current_thread;
+	if (t == nullptr) {
+		t = gb_alloc_item(heap_allocator(), TraceThread);
+		array_init(&t->spans, heap_allocator(), 0, 1024);
+		t->id = trace_thread_count.fetch_add(1, std::memory_order_relaxed)+1;
+		t->next = trace_thread_list.load(std::memory_order_relaxed);
+		while (!trace_thread_list.compare_exchange_weak(t->next, t, std::memory_order_release, std::memory_order_relaxed)) {
+		}
+		trace_current_thread = t;
+	}
+	return t;
+}
+
+isize trace_span_begin(String const &name, String const &detail) {
+	if (!trace_spans_enabled) {
+		return -1;
+	}
+	TraceThread *t = trace_thread_get();
+	TraceSpan span = {};
+	span.start  = time_stamp_time_now();
+	span.name   = name;
+	span.detail = detail;
+	array_add(&t->spans, span);
+	return t->spans.count-1;
+}
+
+void trace_span_end(isize index) {
+	if (index >= 0) {
+		trace_current_thread->spans[index].finish = time_stamp_time_now();
+	}
+}
+
+struct TraceSpanScope {
+	isize index;
+	TraceSpanScope(String const &name, String const &detail = {}) {
+		index = trace_span_begin(name, detail);
+	}
+	~TraceSpanScope() {
+		trace_span_end(index);
+	}
+};
+
+// NOTE: The strings must outlive the export, so they are normally literals, file paths or entity names
+#define TRACE_SPAN(...) TraceSpanScope GB_DEFER_3(_trace_span_)(__VA_ARGS__)
+
+
+void trace_write_json_string(gbFile *f, String const &s) {
+	gb_file_write(f, "\"", 1);
+	isize last = 0;
+	for (isize i = 0; i < s.len; i++) {
+		u8 c = s[i];
+		if (c != '"' && c != '\\' && c >= 0x20) {
+			continue;
+		}
+		gb_file_write(f, s.text+last, i-last);
+		switch (c) {
+		case '"':  gb_file_write(f, "\\\"", 2); break;
+		case '\\': gb_file_write(f, "\\\\", 2); break;
+		default:   gb_fprintf(f, "\\u%04x", c); break;
+		}
+		last = i+1;
+	}
+	gb_file_write(f, s.text+last, s.len-last);
+	gb_file_write(f, "\"", 1);
+}
+
+void trace_write_event(gbFile *f, Timings *t, u32 tid, TraceSpan const &span, bool *first) {
+	u64 finish = span.finish ? span.finish : span.start;
+	gb_fprintf(f, "%s\n{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+	           *first ? "" : ",", tid,
+	           1000000.0*cast(f64)(span.start - t->total.start)/cast(f64)t->freq,
+	           1000000.0*cast(f64)(finish - span.start)/cast(f64)t->freq);
+	trace_write_json_string(f, span.name);
+	if (span.detail.len != 0) {
+		gb_fprintf(f, ",\"args\":{\"detail\":");
+		trace_write_json_string(f, span.detail);
+		gb_fprintf(f, "}");
+	}
+	gb_fprintf(f, "}");
+	*first = false;
+}
+
+// NOTE: Must be called from the main thread once every worker has finished, as the main thread's
+// sections are shown alongside its spans
+bool timings_export_trace(Timings *t, String const &path) {
+	timings__stop_current_section(t);
+	u64 total_finish = time_stamp_time_now();
+
+	char *c_path = alloc_cstring(heap_allocator(), path);
+	defer (gb_free(heap_allocator(), c_path));
+
+	gbFile f = {};
+	if (gb_file_create(&f, c_path) != gbFileError_None) {
+		return false;
+	}
+	defer (gb_file_close(&f));
+
+	TraceThread *main_thread = trace_thread_get();
+
+	bool first = true;
+	gb_fprintf(&f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	for (TraceThread *thread = trace_thread_list.load(std::memory_order_acquire); thread != nullptr; thread = thread->next) {
+		gb_fprintf(&f, "%s\n{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"%s %u\"}}",
+		           first ? "" : ",", thread->id, thread == main_thread ? "Main" : "Worker", thread->id);
+		first = false;
+	}
+
+	TraceSpan total = {t->total.start, total_finish, t->total.label};
+	trace_write_event(&f, t, main_thread->id, total, &first);
+	for_array(i, t->sections) {
+		TimeStamp const &ts = t->sections[i];
+		TraceSpan section = {ts.start, ts.finish, ts.label};
+		trace_write_event(&f, t, main_thread->id, section, &first);
+	}
+
+	for (TraceThread *thread = trace_thread_list.load(std::memory_order_acquire); thread != nullptr; thread = thread->next) {
+		for_array(i, thread->spans) {
+			trace_write_event(&f, t, thread->id, thread->spans[i], &first);
+		}
+	}
+	gb_fprintf(&f, "\n]}\n");
+	return true;
+}
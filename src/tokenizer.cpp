@@ -276,6 +276,10 @@ struct ErrorCollector {
 
 gb_global ErrorCollector global_error_collector;
 
+// NOTE: Set while the parser runs to the end of a file which has already failed, so that
+// only the error which failed it is reported
+gb_thread_local bool syntax_errors_muted = false;
+
 #define MAX_ERROR_COLLECTOR_COUNT (36)
 
 
@@ -284,10 +288,10 @@ bool any_errors(void) {
 }
 
 void init_global_error_collector(void) {
-	mutex_init(&global_error_collector.mutex);
-	mutex_init(&global_error_collector.block_mutex);
-	mutex_init(&global_error_collector.error_out_mutex);
-	mutex_init(&global_error_collector.string_mutex);
+	mutex_init(&global_error_collector.mutex,           "ErrorCollector.mutex");
+	mutex_init(&global_error_collector.block_mutex,     "ErrorCollector.block_mutex");
+	mutex_init(&global_error_collector.error_out_mutex, "ErrorCollector.error_out_mutex");
+	mutex_init(&global_error_collector.string_mutex,    "ErrorCollector.string_mutex");
 	array_init(&global_error_collector.errors, heap_allocator());
 	array_init(&global_error_collector.error_buffer, heap_allocator());
 	array_init(&global_file_path_strings, heap_allocator(), 4096);
@@ -301,7 +305,7 @@ bool set_file_path_string(i32 index, String const &path) {
 	mutex_lock(&global_error_collector.string_mutex);
 
 	if (index >= global_file_path_strings.count) {
-		array_resize(&global_file_path_strings, index);
+		array_resize(&global_file_path_strings, index+1);
 	}
 	String prev = global_file_path_strings[index];
 	if (prev.len == 0) {
@@ -319,7 +323,7 @@ bool set_ast_file_from_id(i32 index, AstFile *file) {
 	mutex_lock(&global_error_collector.string_mutex);
 
 	if (index >= global_files.count) {
-		array_resize(&global_files, index);
+		array_resize(&global_files, index+1);
 	}
 	AstFile *prev = global_files[index];
 	if (prev == nullptr) {
@@ -560,6 +564,9 @@ void error_no_newline_va(TokenPos const &pos, char const *fmt, va_list va) {
 
 
 void syntax_error_va(TokenPos const &pos, TokenPos end, char const *fmt, va_list va) {
+	if (syntax_errors_muted) {
+		return;
+	}
 	mutex_lock(&global_error_collector.mutex);
 	global_error_collector.count++;
 	// NOTE(bill): Duplicate error, skip it
@@ -580,6 +587,9 @@ void syntax_error_va(TokenPos const &pos, TokenPos end, char const *fmt, va_list
 }
 
 void syntax_warning_va(TokenPos const &pos, TokenPos end, char const *fmt, va_list va) {
+	if (syntax_errors_muted) {
+		return;
+	}
 	if (global_warnings_as_errors()) {
 		syntax_error_va(pos, end, fmt, va);
 		return;
@@ -723,6 +733,7 @@ struct Tokenizer {
 
 	TokenizerFlags flags;
 	bool insert_semicolon;
+	bool is_mapped; // `start` is a read-only view of the file rather than a heap copy
 };
 
 
@@ -804,13 +815,96 @@ void init_tokenizer_with_data(Tokenizer *t, String const &fullpath, void *data,
 	}
 }
 
+// NOTE: Smaller files are cheaper to read than to map
+#define TOKENIZER_MAP_FILE_MIN_SIZE (16*1024)
+
+// NOTE: Map the file rather than copy its contents. The tokenizer itself never reads past `end`,
+// but other code walking the source (e.g. `token_end_of_line`) expects a NUL after the contents.
+// That is only guaranteed when the file does not end on a page boundary, as the rest of the last page
+// is then zero filled, so any other file is read instead
+bool tokenizer_map_file(char const *c_str, u8 **data_, isize *size_) {
+	isize page_size = gb_virtual_memory_page_size(nullptr);
+
+#if defined(GB_SYSTEM_WINDOWS)
+	wchar_t *w_str = gb__alloc_utf8_to_ucs2(heap_allocator(), c_str, nullptr);
+	defer (gb_free(heap_allocator(), w_str));
+
+	HANDLE file = CreateFileW(w_str, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	defer (CloseHandle(file));
+
+	LARGE_INTEGER file_size = {};
+	if (!GetFileSizeEx(file, &file_size)) {
+		return false;
+	}
+	isize size = cast(isize)file_size.QuadPart;
+	if (size < TOKENIZER_MAP_FILE_MIN_SIZE || size > I32_MAX || size % page_size == 0) {
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		return false;
+	}
+	defer (CloseHandle(mapping));
+
+	void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr) {
+		return false;
+	}
+#else
+	int fd = open(c_str, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	defer (close(fd));
+
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		return false;
+	}
+	isize size = cast(isize)st.st_size;
+	if (size < TOKENIZER_MAP_FILE_MIN_SIZE || size > I32_MAX || size % page_size == 0) {
+		return false;
+	}
+
+	void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (data == MAP_FAILED) {
+		return false;
+	}
+	// NOTE: The whole file is tokenized straight away
+	madvise(data, size, MADV_WILLNEED);
+#endif
+
+	*data_ = cast(u8 *)data;
+	*size_ = size;
+	return true;
+}
+
+void tokenizer_unmap_file(u8 *data, isize size) {
+#if defined(GB_SYSTEM_WINDOWS)
+	UnmapViewOfFile(data);
+#else
+	munmap(data, size);
+#endif
+}
+
 TokenizerInitError init_tokenizer_from_fullpath(Tokenizer *t, String const &fullpath, TokenizerFlags flags = TokenizerFlag_None) {
 	TokenizerInitError err = TokenizerInit_None;
 
 	char *c_str = alloc_cstring(heap_allocator(), fullpath);
 	defer (gb_free(heap_allocator(), c_str));
 
-	// TODO(bill): Memory map rather than copy contents
+	u8 *mapped_data = nullptr;
+	isize mapped_size = 0;
+	if (tokenizer_map_file(c_str, &mapped_data, &mapped_size)) {
+		init_tokenizer_with_data(t, fullpath, mapped_data, mapped_size, flags);
+		t->is_mapped = true;
+		return err;
+	}
+
 	gbFileContents fc = gb_file_read_contents(heap_allocator(), true, c_str);
 
 	if (fc.size > I32_MAX) {
@@ -844,7 +938,12 @@ TokenizerInitError init_tokenizer_from_fullpath(Tokenizer *t, String const &full
 }
 
 gb_inline void destroy_tokenizer(Tokenizer *t) {
-	if (t->start != nullptr) {
+	if (t->start == nullptr) {
+		return;
+	}
+	if (t->is_mapped) {
+		tokenizer_unmap_file(t->start, t->end - t->start);
+	} else {
 		gb_free(heap_allocator(), t->start);
 	}
 }
@@ -1135,6 +1234,10 @@ void tokenizer_get_token(Tokenizer *t, Token *token, int repeat=0) {
 				}
 			}
 		}
+		if (token->kind == Token_Ident) {
+			// NOTE: Interned so that equal identifiers share the same text everywhere
+			token->string = string_intern_string(token->string);
+		}
 
 		goto semicolon_check;
 	} else {
@@ -681,7 +681,7 @@ bool is_type_slice(Type *t);
 bool is_type_integer(Type *t);
 
 void init_type_mutex(void) {
-	mutex_init(&g_type_mutex);
+	mutex_init(&g_type_mutex, "g_type_mutex");
 }
 
 bool type_ptr_set_exists(PtrSet<Type *> *s, Type *t) {
@@ -777,30 +777,114 @@ Type *alloc_type_generic(Scope *scope, i64 id, String name, Type *specialized) {
 	return t;
 }
 
-Type *alloc_type_pointer(Type *elem) {
-	Type *t = alloc_type(Type_Pointer);
-	t->Pointer.elem = elem;
+// NOTE: Structurally identical anonymous types (pointers, slices, arrays, etc) are hash-consed,
+// so that they share one canonical pointer and `are_types_identical` is mostly a pointer compare.
+// The elements are compared by pointer, so this never has to walk a type
+#define TYPE_INTERN_STRIPE_COUNT 32
+
+struct TypeInternStripe {
+	BlockingMutex mutex;
+	Map<Type *>   map; // Key: hash of (kind, elements, count), multiple values on collision
+};
+
+gb_global TypeInternStripe g_type_intern_stripes[TYPE_INTERN_STRIPE_COUNT];
+
+void init_type_intern_table(void) {
+	MutexStats *stats = mutex_stats_get("g_type_intern_stripes");
+	for (isize i = 0; i < TYPE_INTERN_STRIPE_COUNT; i++) {
+		mutex_init(&g_type_intern_stripes[i].mutex, stats);
+		map_init(&g_type_intern_stripes[i].map, heap_allocator());
+	}
+}
+
+bool type_intern_matches(Type *t, TypeKind kind, Type *a, Type *b, i64 count) {
+	if (t->kind != kind) {
+		return false;
+	}
+	switch (kind) {
+	case Type_Pointer:         return t->Pointer.elem == a;
+	case Type_MultiPointer:    return t->MultiPointer.elem == a;
+	case Type_Slice:           return t->Slice.elem == a;
+	case Type_DynamicArray:    return t->DynamicArray.elem == a;
+	case Type_Array:           return t->Array.elem == a && t->Array.count == count;
+	case Type_SimdVector:      return t->SimdVector.elem == a && t->SimdVector.count == count;
+	case Type_Map:             return t->Map.key == a && t->Map.value == b;
+	case Type_RelativePointer: return t->RelativePointer.pointer_type == a && t->RelativePointer.base_integer == b;
+	case Type_RelativeSlice:   return t->RelativeSlice.slice_type == a && t->RelativeSlice.base_integer == b;
+	}
+	GB_PANIC("Unhandled interned type kind %.*s", LIT(type_strings[kind]));
+	return false;
+}
+
+GB_STATIC_ASSERT(TYPE_INTERN_STRIPE_COUNT == 1<<(64-59));
+
+Type *alloc_type_interned(TypeKind kind, Type *a, Type *b, i64 count) {
+	u64 data[4] = {cast(u64)kind, cast(u64)cast(uintptr)a, cast(u64)cast(uintptr)b, cast(u64)count};
+	u64 hash = fnv64a(data, gb_size_of(data));
+	HashKey key = hash_integer(hash);
+	// NOTE: Use the top bits for the stripe, as the map itself indexes with the bottom bits
+	TypeInternStripe *stripe = &g_type_intern_stripes[hash >> 59];
+
+	mutex_lock(&stripe->mutex);
+	defer (mutex_unlock(&stripe->mutex));
+
+	for (auto *entry = multi_map_find_first(&stripe->map, key); entry != nullptr; entry = multi_map_find_next(&stripe->map, entry)) {
+		if (type_intern_matches(entry->value, kind, a, b, count)) {
+			return entry->value;
+		}
+	}
+
+	Type *t = alloc_type(kind);
+	switch (kind) {
+	case Type_Pointer:      t->Pointer.elem      = a; break;
+	case Type_MultiPointer: t->MultiPointer.elem = a; break;
+	case Type_Slice:        t->Slice.elem        = a; break;
+	case Type_DynamicArray: t->DynamicArray.elem = a; break;
+	case Type_Array:
+		t->Array.elem  = a;
+		t->Array.count = count;
+		break;
+	case Type_SimdVector:
+		t->SimdVector.elem  = a;
+		t->SimdVector.count = count;
+		break;
+	case Type_Map:
+		t->Map.key   = a;
+		t->Map.value = b;
+		break;
+	case Type_RelativePointer:
+		t->RelativePointer.pointer_type = a;
+		t->RelativePointer.base_integer = b;
+		break;
+	case Type_RelativeSlice:
+		t->RelativeSlice.slice_type   = a;
+		t->RelativeSlice.base_integer = b;
+		break;
+	default:
+		GB_PANIC("Unhandled interned type kind %.*s", LIT(type_strings[kind]));
+	}
+	multi_map_insert(&stripe->map, key, t);
 	return t;
 }
 
+Type *alloc_type_pointer(Type *elem) {
+	return alloc_type_interned(Type_Pointer, elem, nullptr, 0);
+}
+
 Type *alloc_type_multi_pointer(Type *elem) {
-	Type *t = alloc_type(Type_MultiPointer);
-	t->MultiPointer.elem = elem;
-	return t;
+	return alloc_type_interned(Type_MultiPointer, elem, nullptr, 0);
 }
 
 Type *alloc_type_array(Type *elem, i64 count, Type *generic_count = nullptr) {
-	if (generic_count != nullptr) {
+	if (generic_count != nullptr || count < 0) {
+		// NOTE: These are modified in place once the count is known, so they cannot be shared
 		Type *t = alloc_type(Type_Array);
 		t->Array.elem = elem;
 		t->Array.count = count;
 		t->Array.generic_count = generic_count;
 		return t;
 	}
-	Type *t = alloc_type(Type_Array);
-	t->Array.elem = elem;
-	t->Array.count = count;
-	return t;
+	return alloc_type_interned(Type_Array, elem, nullptr, count);
 }
 
 Type *alloc_type_enumerated_array(Type *elem, Type *index, ExactValue min_value, ExactValue max_value, TokenKind op) {
@@ -817,15 +901,11 @@ Type *alloc_type_enumerated_array(Type *elem, Type *index, ExactValue min_value,
 
 
 Type *alloc_type_slice(Type *elem) {
-	Type *t = alloc_type(Type_Slice);
-	t->Array.elem = elem;
-	return t;
+	return alloc_type_interned(Type_Slice, elem, nullptr, 0);
 }
 
 Type *alloc_type_dynamic_array(Type *elem) {
-	Type *t = alloc_type(Type_DynamicArray);
-	t->DynamicArray.elem = elem;
-	return t;
+	return alloc_type_interned(Type_DynamicArray, elem, nullptr, 0);
 }
 
 
@@ -847,19 +927,13 @@ Type *alloc_type_enum() {
 Type *alloc_type_relative_pointer(Type *pointer_type, Type *base_integer) {
 	GB_ASSERT(is_type_pointer(pointer_type));
 	GB_ASSERT(is_type_integer(base_integer));
-	Type *t = alloc_type(Type_RelativePointer);
-	t->RelativePointer.pointer_type = pointer_type;
-	t->RelativePointer.base_integer = base_integer;
-	return t;
+	return alloc_type_interned(Type_RelativePointer, pointer_type, base_integer, 0);
 }
 
 Type *alloc_type_relative_slice(Type *slice_type, Type *base_integer) {
 	GB_ASSERT(is_type_slice(slice_type));
 	GB_ASSERT(is_type_integer(base_integer));
-	Type *t = alloc_type(Type_RelativeSlice);
-	t->RelativeSlice.slice_type   = slice_type;
-	t->RelativeSlice.base_integer = base_integer;
-	return t;
+	return alloc_type_interned(Type_RelativeSlice, slice_type, base_integer, 0);
 }
 
 Type *alloc_type_named(String name, Type *base, Entity *type_name) {
@@ -926,11 +1000,9 @@ bool is_type_valid_for_keys(Type *t);
 Type *alloc_type_map(i64 count, Type *key, Type *value) {
 	if (key != nullptr) {
 		GB_ASSERT(value != nullptr);
+		return alloc_type_interned(Type_Map, key, value, 0);
 	}
-	Type *t = alloc_type(Type_Map);
-	t->Map.key   = key;
-	t->Map.value = value;
-	return t;
+	return alloc_type(Type_Map);
 }
 
 Type *alloc_type_bit_set() {
@@ -941,10 +1013,7 @@ Type *alloc_type_bit_set() {
 
 
 Type *alloc_type_simd_vector(i64 count, Type *elem) {
-	Type *t = alloc_type(Type_SimdVector);
-	t->SimdVector.count = count;
-	t->SimdVector.elem = elem;
-	return t;
+	return alloc_type_interned(Type_SimdVector, elem, nullptr, count);
 }
 
 
@@ -2250,6 +2319,73 @@ bool are_types_identical(Type *x, Type *y) {
 	return false;
 }
 
+// NOTE: Types which `are_types_identical` treats as the same always have the same hash.
+// Records only hash their kind as their fields may still be being checked
+u64 type_hash_identity(Type *t, isize depth=0) {
+	if (t == nullptr) {
+		return 0;
+	}
+	t = strip_type_aliasing(t);
+	u64 h = hash_combine_u64(0, cast(u64)t->kind);
+	if (depth > 8) {
+		return h;
+	}
+
+	switch (t->kind) {
+	case Type_Generic:
+		return hash_combine_u64(h, type_hash_identity(t->Generic.specialized, depth+1));
+	case Type_Basic:
+		return hash_combine_u64(h, cast(u64)t->Basic.kind);
+	case Type_Named:
+		return hash_combine_u64(h, cast(u64)cast(uintptr)t->Named.type_name);
+
+	case Type_Pointer:      return hash_combine_u64(h, type_hash_identity(t->Pointer.elem,      depth+1));
+	case Type_MultiPointer: return hash_combine_u64(h, type_hash_identity(t->MultiPointer.elem, depth+1));
+	case Type_Slice:        return hash_combine_u64(h, type_hash_identity(t->Slice.elem,        depth+1));
+	case Type_DynamicArray: return hash_combine_u64(h, type_hash_identity(t->DynamicArray.elem, depth+1));
+	case Type_Array:
+		h = hash_combine_u64(h, cast(u64)t->Array.count);
+		return hash_combine_u64(h, type_hash_identity(t->Array.elem, depth+1));
+	case Type_SimdVector:
+		h = hash_combine_u64(h, cast(u64)t->SimdVector.count);
+		return hash_combine_u64(h, type_hash_identity(t->SimdVector.elem, depth+1));
+	case Type_EnumeratedArray:
+		h = hash_combine_u64(h, type_hash_identity(t->EnumeratedArray.index, depth+1));
+		return hash_combine_u64(h, type_hash_identity(t->EnumeratedArray.elem, depth+1));
+	case Type_Map:
+		h = hash_combine_u64(h, type_hash_identity(t->Map.key, depth+1));
+		return hash_combine_u64(h, type_hash_identity(t->Map.value, depth+1));
+	case Type_BitSet:
+		h = hash_combine_u64(h, type_hash_identity(t->BitSet.elem, depth+1));
+		h = hash_combine_u64(h, cast(u64)t->BitSet.lower);
+		return hash_combine_u64(h, cast(u64)t->BitSet.upper);
+
+	case Type_Struct:
+	case Type_Union:
+		return h;
+
+	case Type_Tuple:
+		for_array(i, t->Tuple.variables) {
+			Entity *e = t->Tuple.variables[i];
+			h = hash_combine_u64(h, cast(u64)e->kind);
+			h = hash_combine_u64(h, type_hash_identity(e->type, depth+1));
+			if (e->kind == Entity_Constant) {
+				h = hash_combine_u64(h, hash_exact_value_identity(e->Constant.value));
+			}
+		}
+		return h;
+
+	case Type_Proc:
+		h = hash_combine_u64(h, cast(u64)t->Proc.calling_convention);
+		h = hash_combine_u64(h, cast(u64)t->Proc.variadic);
+		h = hash_combine_u64(h, type_hash_identity(t->Proc.params,  depth+1));
+		return hash_combine_u64(h, type_hash_identity(t->Proc.results, depth+1));
+	}
+
+	// NOTE: Everything else is only identical to itself
+	return hash_combine_u64(h, cast(u64)cast(uintptr)t);
+}
+
 Type *default_type(Type *type) {
 	if (type == nullptr) {
 		return t_invalid;